@@ -3,6 +3,10 @@
 
 #include "GameController.h"
 #include "GameView.h"
+#include "Random.h"
+#include <memory>
+#include <string>
+#include <vector>
 
 namespace SevenWondersDuel {
 
@@ -31,6 +35,13 @@ namespace SevenWondersDuel {
          * 用于 View 层判断是否需要渲染 UI 交互提示，或处理 Controller 中的错误反馈逻辑。
          */
 		virtual bool isHuman() const;
+
+		/**
+         * @brief 注入决策随机流
+         * 批量对局时由驱动器按 SeedHierarchy 派生后注入，使代理决策可复现。
+         * 不使用随机性的代理 (如人类玩家) 忽略即可。
+         */
+		virtual void setRandomStream(const Xoshiro256& rng);
 	};
 
 	/**
@@ -50,7 +61,18 @@ namespace SevenWondersDuel {
      */
 	class RandomAIAgent : public IPlayerAgent {
 	public:
+		/**
+         * @param showThinking 是否打印决策过程并模拟思考停顿 (观战模式)。
+         *                     批量自对弈时传 false，保证无输出、无等待。
+         */
+		explicit RandomAIAgent(bool showThinking = true);
 		Action decideAction(GameController& controller, GameView& view, InputManager& input) override;
+		void setRandomStream(const Xoshiro256& rng) override { m_rng = rng; }
+
+	private:
+		bool m_showThinking;
+		Xoshiro256 m_rng;
+		std::vector<LegalAction> m_legalActions; // 复用的合法动作缓冲
 	};
 
 	/**
@@ -63,7 +85,25 @@ namespace SevenWondersDuel {
      */
 	class GreedyAIAgent : public IPlayerAgent {
 	public:
+		explicit GreedyAIAgent(bool showThinking = true);
 		Action decideAction(GameController& controller, GameView& view, InputManager& input) override;
+		void setRandomStream(const Xoshiro256& rng) override { m_rng = rng; }
+
+	private:
+		bool m_showThinking;
+		Xoshiro256 m_rng;
+		std::vector<LegalAction> m_legalActions; // 复用的合法动作缓冲
+	};
+
+	/**
+     * @brief AI 代理工厂
+     * 按名称创建 AI 代理 ("random" / "greedy" / "mcts" / "ismcts" / "alphabeta")，供命令行工具使用。
+     * 名称加后缀 "+exact" (如 "mcts+exact") 时用 EndgameAgent 包装：第三时代残局改为精确求解。
+     * @return 名称未知时返回 nullptr
+     */
+	class AgentFactory {
+	public:
+		static std::unique_ptr<IPlayerAgent> createAI(const std::string& name, bool showThinking);
 	};
 
 }
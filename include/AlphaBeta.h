@@ -0,0 +1,154 @@
+#ifndef SEVEN_WONDERS_DUEL_ALPHABETA_H
+#define SEVEN_WONDERS_DUEL_ALPHABETA_H
+
+#include "Agent.h"
+#include "Random.h"
+#include "Determinization.h"
+#include "TranspositionTable.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace SevenWondersDuel {
+
+    /**
+     * @brief Alpha-Beta 搜索配置
+     * timeLimitMs > 0 时迭代加深直到墙钟截止 (以最后一轮完整搜索的结果为准)，否则搜索到 maxDepth 为止。
+     * threads > 1 时为 Lazy SMP：辅助线程以错开的深度与根着法顺序搜索同一局面，只通过共享置换表协作；
+     * 结果由主线程给出 (多线程时结果不保证逐次可复现)。
+     */
+    struct AlphaBetaConfig {
+        double timeLimitMs = 0.0;     // 每次决策的时间预算 (毫秒)
+        int maxDepth = 4;             // 迭代加深的最大深度 (动作数，机会节点不计深度)
+        size_t ttSizeMB = 16;         // 置换表大小 (MB，每条目 16 字节)，构造时一次分配
+        int threads = 1;              // 搜索线程数
+        int chanceSamples = 4;        // 每个翻牌机会节点抽样的结果数
+    };
+
+    /**
+     * @brief 最近一次决策的搜索统计
+     */
+    struct AlphaBetaStats {
+        long long nodes = 0;          // 访问的局面数 (含叶子与机会节点的样本)
+        long long ttProbes = 0;
+        long long ttHits = 0;         // 键匹配的探测次数
+        long long ttCutoffs = 0;      // 直接由置换表条目给出结果的次数
+        long long ttContention = 0;   // 与其他线程的读写重叠次数 (见 TTCounters)
+        int ttHashfull = 0;           // 置换表当前世代占用率 (千分比)
+        int threads = 1;
+        int depth = 0;                // 最后一轮完整搜索的深度
+        int score = 0;                // 该轮给出的评估值 (从行动方视角，单位 1/4 分)
+        bool complete = false;        // 没有叶子因深度耗尽而截断 (继续加深不会改变结果)
+        double seconds = 0.0;
+
+        double nodesPerSecond() const { return seconds > 0.0 ? nodes / seconds : 0.0; }
+        double ttHitRate() const { return ttProbes > 0 ? static_cast<double>(ttHits) / ttProbes : 0.0; }
+    };
+
+    /**
+     * @brief 迭代加深 Alpha-Beta / Expectimax 搜索代理
+     * 适合信息大多已公开的局面 (第三时代后段、摧毁与陵墓等强制中断)。
+     *
+     * - 极大极小：值始终以玩家 0 视角计，玩家 0 行动的节点取极大、玩家 1 取极小
+     *   (再次行动、科技标记选择等连续行动自然成立)
+     * - 机会节点：动作会翻开背面朝上的卡牌时，用 Determinizer 按公开信息重新抽样 chanceSamples 次，
+     *   取子树的平均值；因此搜索从不利用真实的隐藏牌面
+     * - 视界：新时代发牌、第二轮奇迹轮抽发牌之后的局面直接按启发式评估
+     * - 置换表：SharedTranspositionTable，按 GameController::getStateHash 索引 (背面朝上卡槽只计"有牌"，不计牌面)，
+     *   每次决策推进世代号；条目保存最佳动作用于下一轮排序。可在多个代理之间共享
+     * - 着法排序：置换表动作优先，其余按廉价启发式 (建造奇迹 > 建造高分卡 > 其他 > 弃牌)
+     */
+    class AlphaBetaAgent : public IPlayerAgent {
+    public:
+        explicit AlphaBetaAgent(AlphaBetaConfig config = AlphaBetaConfig(), bool showThinking = true);
+
+        /**
+         * @brief 使用外部 (可与其他代理共享) 的置换表，忽略 config.ttSizeMB
+         */
+        AlphaBetaAgent(AlphaBetaConfig config, std::shared_ptr<SharedTranspositionTable> table, bool showThinking = true);
+        ~AlphaBetaAgent() override;
+
+        Action decideAction(GameController& controller, GameView& view, InputManager& input) override;
+        void setRandomStream(const Xoshiro256& rng) override { m_rng = rng; }
+
+        const AlphaBetaConfig& getConfig() const { return m_config; }
+        const AlphaBetaStats& getLastStats() const { return m_lastStats; }
+        const std::shared_ptr<SharedTranspositionTable>& getTable() const { return m_table; }
+
+        /**
+         * @brief 对给定局面执行一次搜索并返回最佳动作 (不打印任何信息)
+         */
+        Action search(const GameController& root);
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        // 置换表条目的 bound 字段 (0 由 SharedTranspositionTable 保留为空条目)
+        enum class Bound : std::uint8_t { NONE, EXACT, LOWER, UPPER };
+
+        /**
+         * @brief 每个搜索线程的私有状态 (worker 0 为主线程)
+         */
+        struct Worker {
+            int id = 0;
+            std::vector<std::unique_ptr<GameController>> stack;  // 每层一个复用的控制器 (stack[ply] 为该层局面)
+            std::vector<std::vector<LegalAction>> moves;         // 每层复用的合法动作缓冲
+            std::vector<std::vector<int>> order;                 // 每层的搜索顺序 (动作下标)
+            Determinizer determinizer;
+
+            long long nodes = 0;
+            long long ttCutoffs = 0;
+            TTCounters tt;
+            bool aborted = false;
+            bool hitDepthLimit = false;   // 本轮是否有非终局叶子因深度耗尽而被评估
+            int rootBest = -1;            // 本轮根节点最佳动作下标
+        };
+
+        AlphaBetaConfig m_config;
+        bool m_showThinking;
+        Xoshiro256 m_rng;
+        AlphaBetaStats m_lastStats;
+
+        std::shared_ptr<SharedTranspositionTable> m_table;
+        std::vector<std::unique_ptr<Worker>> m_workers;
+
+        std::uint64_t m_sampleSeed = 0;  // 本次决策的机会节点抽样种子
+        bool m_timed = false;
+        Clock::time_point m_deadline;
+        std::atomic<bool> m_stop{false}; // 主线程结束后通知辅助线程停止
+
+        /**
+         * @brief 辅助线程：错开深度迭代加深，直到主线程结束
+         */
+        void helperMain(Worker& w, int maxDepth);
+
+        /**
+         * @brief 搜索 w.stack[ply] 所在局面
+         * @return 玩家 0 视角的评估值 (fail-soft)
+         */
+        int alphaBeta(Worker& w, int ply, int depth, int alpha, int beta);
+
+        /**
+         * @brief 在 w.stack[ply] 上执行第 moveIndex 个动作并返回子局面的值 (处理视界与机会节点)
+         */
+        int searchChild(Worker& w, int ply, int moveIndex, int depth, int alpha, int beta, std::uint64_t key);
+
+        void orderMoves(Worker& w, int ply, int ttMove);
+        bool timeUp(Worker& w);
+
+        /**
+         * @brief 置换表键：完整局面哈希，但背面朝上卡槽的牌面不参与 (只记录该槽仍有一张背面牌)
+         */
+        static std::uint64_t searchKey(const GameController& state);
+
+        /**
+         * @brief 静态评估 (玩家 0 视角，单位 1/4 分)
+         */
+        static int evaluate(const GameController& state, int ply);
+    };
+
+}
+
+#endif // SEVEN_WONDERS_DUEL_ALPHABETA_H
@@ -5,6 +5,8 @@
 #include "Card.h"
 #include <vector>
 #include <string>
+#include <array>
+#include <cstdint>
 #include <iterator>
 
 namespace SevenWondersDuel {
@@ -24,17 +26,27 @@ namespace SevenWondersDuel {
         // true表示标记还在，false表示已被移除(触发过掠夺)
         bool m_lootTokens[4] = {true, true, true, true}; 
 
+        std::uint64_t m_hash = 0; // 位置与剩余掠夺标记的 Zobrist 哈希
+
     public:
+        MilitaryTrack();
+
         int getPosition() const { return m_position; }
         const bool* getLootTokens() const { return m_lootTokens; }
+        std::uint64_t getHash() const { return m_hash; }
         
         /**
          * @brief 移动冲突指示物
          * @param shields 获得的盾牌数量
          * @param currentPlayerId 当前获得盾牌的玩家 ID (0 或 1)
-         * @return 触发的掠夺事件列表 (负数表示 P0 损失金币，正数表示 P1 损失金币)
+         * @return 触发的掠夺事件 (负数表示 P0 损失金币，正数表示 P1 损失金币)
+         */
+        MilitaryLoot move(int shields, int currentPlayerId);
+
+        /**
+         * @brief 直接设置位置与掠夺标记 (从紧凑编码恢复局面)
          */
-        std::vector<int> move(int shields, int currentPlayerId);
+        void restore(int position, const bool lootTokens[4]);
 
         /**
          * @brief 获取当前位置对应的胜利点数
@@ -46,31 +58,86 @@ namespace SevenWondersDuel {
     /**
      * @brief 卡牌金字塔结构
      * 管理每个时代桌面上卡牌的排列方式 (正三角、倒三角、蛇形)。
-     * 处理卡牌的遮挡依赖关系。
+     * 三种布局固定不变，遮挡关系以 constexpr 表给出 (每个卡槽一个 20 位的 "被谁压住" 掩码)；
+     * 移除/翻面/可拿取状态均为 uint32_t 位掩码，第 i 位对应第 i 个卡槽。
      */
     class CardPyramid {
+    public:
+        using SlotMask = std::uint32_t;
+
     private:
-        std::vector<CardSlot> m_slots; // 所有的卡槽节点
+        std::array<CardSlot, Config::PYRAMID_SLOTS> m_slots; // 卡槽布局 (卡牌 + 行列位置)
+        int m_slotCount = 0;
+        const SlotMask* m_coveredBy = nullptr; // 当前时代的遮挡表 (指向静态数据)
+        const SlotMask* m_covers = nullptr;    // 遮挡表的逆：第 i 槽压住了哪些槽
+
+        SlotMask m_slotMask = 0; // 实际存在的卡槽
+        SlotMask m_removed = 0;  // 已被拿走
+        SlotMask m_faceUp = 0;   // 正面朝上
+        SlotMask m_exposed = 0;  // 未被遮挡且未被拿走 (当前可选)
+
+        std::uint64_t m_hash = 0; // 未被拿走的卡槽 (卡牌 + 朝向) 的 Zobrist 哈希
 
     public:
-        const std::vector<CardSlot>& getSlots() const { return m_slots; }
+        int getSlotCount() const { return m_slotCount; }
+        const CardSlot& getSlot(int slot) const { return m_slots[slot]; }
+
+        bool isRemoved(int slot) const { return (m_removed >> slot) & 1u; }
+        bool isFaceUp(int slot) const { return (m_faceUp >> slot) & 1u; }
+        bool isExposed(int slot) const { return (m_exposed >> slot) & 1u; }
+
+        /**
+         * @brief 卡槽中可被玩家看到的卡牌
+         * 背面朝上或已被拿走的卡槽返回 nullptr。AI 读取金字塔时应使用此接口：
+         * getSlot(i).getCardPtr() 会返回背面朝上的真实卡牌，属于隐藏信息。
+         */
+        const Card* getVisibleCard(int slot) const { return isFaceUp(slot) && !isRemoved(slot) ? m_slots[slot].getCardPtr() : nullptr; }
+
+        SlotMask getRemovedMask() const { return m_removed; }
+        SlotMask getFaceUpMask() const { return m_faceUp; }
+        SlotMask getExposedMask() const { return m_exposed; }
+        std::uint64_t getHash() const { return m_hash; }
+
+        /**
+         * @brief 金字塔中剩余 (未被拿走) 的卡牌数
+         */
+        int getRemainingCount() const { return Bits::popcount(m_slotMask & ~m_removed); }
         
         /**
          * @brief 初始化指定时代的金字塔结构
          * @param age 时代 (1, 2, 3)
          * @param deck 该时代的卡牌堆
          */
-        void init(int age, const std::vector<Card*>& deck);
+        void init(int age, const std::vector<const Card*>& deck);
+
+        /**
+         * @brief 直接恢复金字塔的完整状态 (从紧凑编码恢复局面)
+         * 按 age 的布局放入 slots 中的前 slotCount 张卡牌 (已拿走的卡槽可为 nullptr)，再套用拿走 / 翻面掩码；
+         * 可拿取状态由遮挡关系重新推出。撤销开始新时代时也用它恢复旧金字塔。
+         */
+        void restore(int age, const std::array<const Card*, Config::PYRAMID_SLOTS>& slots, int slotCount, SlotMask removed, SlotMask faceUp);
+
+        /**
+         * @brief 在同一时代的布局上恢复拿走 / 翻面 / 可拿取掩码 (撤销拿牌)
+         * 只重算状态有变化的卡槽的哈希。
+         */
+        void restoreMasks(SlotMask removed, SlotMask faceUp, SlotMask exposed);
 
         /**
          * @brief 从金字塔中移除一张卡牌
          * 会自动更新剩余卡牌的遮挡/翻面状态。
-         * @param cardId 卡牌 ID
+         * @param card 卡牌索引
          * @return 被移除的 Card 指针，如果未找到或已移除则返回 nullptr
          */
-        Card* removeCard(const std::string& cardId);
+        const Card* removeCard(CardIndex card);
+
+        /**
+         * @brief 替换背面朝上卡槽中的卡牌 (用于信息集搜索的局面抽样)
+         * @return 卡槽正面朝上或已被拿走时不做修改并返回 false
+         */
+        bool replaceHiddenCard(int slot, const Card* card);
 
-        // --- 迭代器实现 (用于遍历所有当前可见/可选的卡牌) ---
+        // --- 迭代器实现 (按位遍历 m_exposed，即所有当前可选的卡牌) ---
         class Iterator {
         public:
             using iterator_category = std::forward_iterator_tag;
@@ -79,17 +146,17 @@ namespace SevenWondersDuel {
             using pointer           = const CardSlot*;
             using reference         = const CardSlot&;
 
-            Iterator(const std::vector<CardSlot>* slots, int index) 
-                : m_ptrSlots(slots), m_currentIndex(index) {
-                advanceToNextAvailable();
-            }
+            Iterator(const CardSlot* slots, SlotMask remaining)
+                : m_slots(slots), m_remaining(remaining) {}
+
+            reference operator*() const { return m_slots[Bits::lowestBit(m_remaining)]; }
+            pointer operator->() const { return &m_slots[Bits::lowestBit(m_remaining)]; }
 
-            reference operator*() const { return (*m_ptrSlots)[m_currentIndex]; }
-            pointer operator->() const { return &(*m_ptrSlots)[m_currentIndex]; }
+            /** @brief 当前卡槽在金字塔中的绝对索引 */
+            int slotIndex() const { return Bits::lowestBit(m_remaining); }
 
             Iterator& operator++() {
-                m_currentIndex++;
-                advanceToNextAvailable();
+                m_remaining &= m_remaining - 1;
                 return *this;
             }
 
@@ -100,7 +167,7 @@ namespace SevenWondersDuel {
             }
 
             friend bool operator==(const Iterator& a, const Iterator& b) {
-                return a.m_currentIndex == b.m_currentIndex && a.m_ptrSlots == b.m_ptrSlots;
+                return a.m_remaining == b.m_remaining && a.m_slots == b.m_slots;
             }
 
             friend bool operator!=(const Iterator& a, const Iterator& b) {
@@ -108,34 +175,28 @@ namespace SevenWondersDuel {
             }
 
         private:
-            const std::vector<CardSlot>* m_ptrSlots;
-            int m_currentIndex;
-
-            // 跳过那些已被拿走或被遮挡的卡槽
-            void advanceToNextAvailable() {
-                while (m_currentIndex < (int)m_ptrSlots->size()) {
-                    const CardSlot& slot = (*m_ptrSlots)[m_currentIndex];
-                    if (!slot.isRemoved() && slot.getCoveredBy().empty()) {
-                        break;
-                    }
-                    m_currentIndex++;
-                }
-            }
+            const CardSlot* m_slots;
+            SlotMask m_remaining; // 尚未遍历的可选卡槽
         };
 
-        Iterator begin() const { return Iterator(&m_slots, 0); }
-        Iterator end() const { return Iterator(&m_slots, (int)m_slots.size()); }
+        Iterator begin() const { return Iterator(m_slots.data(), m_exposed); }
+        Iterator end() const { return Iterator(m_slots.data(), 0); }
 
     private:
-        // 内部构建辅助函数
-        void addSlot(int row, int count, bool faceUp, const std::vector<Card*>& deck, int& deckIdx);
-        int getAbsIndex(CardSlot* ptr);
-        std::vector<CardSlot*> getSlotsByRow(int r);
-
-        // 各时代的具体依赖连接逻辑
-        void setupDependenciesAge1();
-        void setupDependenciesAge2();
-        void setupDependenciesAge3();
+        /**
+         * @brief 按 age 的布局依次放入 cards 中的前 count 张卡牌 (init 与 restore 共用)
+         */
+        void layout(int age, const Card* const* cards, int count);
+
+        /**
+         * @brief 移除指定卡槽，并翻开因此不再被遮挡的卡槽
+         */
+        void removeSlot(int slot);
+
+        /**
+         * @brief 卡槽当前状态对应的哈希键 (已拿走或为空时为 0)
+         */
+        std::uint64_t slotKey(int slot) const;
     };
 
     /**
@@ -146,42 +207,62 @@ namespace SevenWondersDuel {
     private:
         MilitaryTrack m_militaryTrack;
         CardPyramid m_cardStructure;
-        std::vector<Card*> m_discardPile; // 弃牌堆
+        std::vector<const Card*> m_discardPile; // 弃牌堆
 
         // 科技标记 (绿色圆片)
         std::vector<ProgressToken> m_availableProgressTokens; // 棋盘上可选的 5 枚
         std::vector<ProgressToken> m_boxProgressTokens;       // 留在盒子里的 (某些奇迹可查看)
 
+        std::uint64_t m_hash = 0; // 弃牌堆与科技标记的 Zobrist 哈希 (军事轨道与金字塔各自维护)
+
     public:
         Board() = default;
 
         const MilitaryTrack& getMilitaryTrack() const { return m_militaryTrack; }
         const CardPyramid& getCardStructure() const { return m_cardStructure; }
-        const std::vector<Card*>& getDiscardPile() const { return m_discardPile; }
+        const std::vector<const Card*>& getDiscardPile() const { return m_discardPile; }
         const std::vector<ProgressToken>& getAvailableProgressTokens() const { return m_availableProgressTokens; }
         const std::vector<ProgressToken>& getBoxProgressTokens() const { return m_boxProgressTokens; }
 
+        /**
+         * @brief 棋盘部分的 Zobrist 哈希 (军事轨道、金字塔、弃牌堆、科技标记)
+         */
+        std::uint64_t getHash() const { return m_hash ^ m_militaryTrack.getHash() ^ m_cardStructure.getHash(); }
+
         // --- 代理方法 ---
-        std::vector<int> moveMilitary(int shields, int currentPlayerId);
-        void initPyramid(int age, const std::vector<Card*>& deck);
-        Card* removeCardFromPyramid(const std::string& cardId);
+        MilitaryLoot moveMilitary(int shields, int currentPlayerId);
+        void initPyramid(int age, const std::vector<const Card*>& deck);
+        void restoreMilitaryTrack(int position, const bool lootTokens[4]) { m_militaryTrack.restore(position, lootTokens); }
+        void restorePyramid(int age, const std::array<const Card*, Config::PYRAMID_SLOTS>& slots, int slotCount,
+                            CardPyramid::SlotMask removed, CardPyramid::SlotMask faceUp) {
+            m_cardStructure.restore(age, slots, slotCount, removed, faceUp);
+        }
+        void restorePyramidMasks(CardPyramid::SlotMask removed, CardPyramid::SlotMask faceUp, CardPyramid::SlotMask exposed) {
+            m_cardStructure.restoreMasks(removed, faceUp, exposed);
+        }
+        const Card* removeCardFromPyramid(CardIndex card);
+        bool replaceHiddenPyramidCard(int slot, const Card* card) { return m_cardStructure.replaceHiddenCard(slot, card); }
         
         // --- 弃牌堆管理 ---
-        void addToDiscardPile(Card* c);
-        Card* removeCardFromDiscardPile(const std::string& cardId);
+        void addToDiscardPile(const Card* c) { insertIntoDiscardPile(static_cast<int>(m_discardPile.size()), c); }
+        void insertIntoDiscardPile(int position, const Card* c);
+        const Card* removeCardFromDiscardPile(CardIndex card);
 
         // --- 科技标记管理 ---
         void setAvailableProgressTokens(const std::vector<ProgressToken>& tokens);
         void setBoxProgressTokens(const std::vector<ProgressToken>& tokens);
         void addAvailableProgressToken(ProgressToken t);
         void addBoxProgressToken(ProgressToken t);
+        // 放回指定位置 (撤销选择标记时恢复原有顺序)
+        void insertAvailableProgressToken(int position, ProgressToken t);
+        void insertBoxProgressToken(int position, ProgressToken t);
         bool removeAvailableProgressToken(ProgressToken t);
         bool removeBoxProgressToken(ProgressToken t);
 
         /**
-         * @brief 摧毁玩家的卡牌 (实际上是将其移入弃牌堆)
+         * @brief 摧毁玩家指定的已建卡牌：移入弃牌堆并撤销其产量等持续效果
          */
-        void destroyCard(Player* target, CardType color);
+        void destroyCard(Player* target, CardIndex card);
     };
 }
 
@@ -44,49 +44,25 @@ namespace SevenWondersDuel {
 
     /**
      * @brief 金字塔卡槽节点
-     * 用于构建游戏桌面上的卡牌金字塔结构。每个 Slot 包含一张卡，并记录其位置状态和依赖关系。
+     * 用于构建游戏桌面上的卡牌金字塔结构。每个 Slot 只记录卡牌及其位置；
+     * 翻面/移除/遮挡状态由 CardPyramid 以位掩码统一维护。
      */
     class CardSlot {
     private:
-        std::string m_id;             // 对应 Card 的 ID (缓存，方便查找)
-        Card* m_cardPtr = nullptr;    // 指向实际 Card 数据的指针
-        bool m_isFaceUp = false;      // 是否正面朝上 (可见)
-        bool m_isRemoved = false;     // 是否已被玩家拿走
-
+        const Card* m_cardPtr = nullptr;    // 指向实际 Card 数据的指针
         int m_row = 0;                // 在金字塔中的行号 (从上往下)
         int m_index = 0;              // 行内索引 (从左往右)
 
-        std::vector<int> m_coveredBy; // 压着当前牌的 Slot 索引列表 (依赖关系)
-
     public:
         CardSlot() = default;
 
-        const std::string& getId() const { return m_id; }
-        Card* getCardPtr() const { return m_cardPtr; }
-        bool isFaceUp() const { return m_isFaceUp; }
-        bool isRemoved() const { return m_isRemoved; }
+        const Card* getCardPtr() const { return m_cardPtr; }
         int getRow() const { return m_row; }
         int getIndex() const { return m_index; }
-        const std::vector<int>& getCoveredBy() const { return m_coveredBy; }
 
-        void setId(const std::string& id) { m_id = id; }
-        void setCardPtr(Card* ptr) { m_cardPtr = ptr; }
-        void setFaceUp(bool val) { m_isFaceUp = val; }
-        void setRemoved(bool val) { m_isRemoved = val; }
+        void setCardPtr(const Card* ptr) { m_cardPtr = ptr; }
         void setRow(int r) { m_row = r; }
         void setIndex(int i) { m_index = i; }
-        
-        /**
-         * @brief 添加一个压在上面的卡槽索引
-         */
-        void addCoveredBy(int index) { m_coveredBy.push_back(index); }
-
-        /**
-         * @brief 通知有一个压在上面的卡被移除了
-         * 当所有压在上面的卡都被移除后，此卡会自动翻面 (FaceUp = true)。
-         * @return 如果此操作导致卡牌翻面，返回 true
-         */
-        bool notifyCoveringRemoved(int index);
     };
 
     /**
@@ -95,6 +71,7 @@ namespace SevenWondersDuel {
      */
     class Card {
     private:
+        CardIndex m_index = NO_CARD;     // 数据库中的稠密索引
         std::string m_id;
         std::string m_name;
         int m_age = 0;             // 所属时代 (1, 2, 3)
@@ -104,12 +81,16 @@ namespace SevenWondersDuel {
 
         std::string m_chainTag;          // 此卡提供的连锁标记 (如 "MOON")
         std::string m_requiresChainTag;  // 此卡需要的连锁标记 (如有此标记则免费)
+        std::uint32_t m_chainBit = 0;          // 连锁标记在数据库中的位 (加载时分配，0 表示无)
+        std::uint32_t m_requiresChainBit = 0;
 
         std::vector<std::shared_ptr<IEffect>> m_effects; // 获取此卡后的即时或被动效果
+        int m_staticVictoryPoints = 0;   // 与对局状态无关的分数之和 (加载时计算)
 
     public:
         Card() = default;
 
+        CardIndex getIndex() const { return m_index; }
         const std::string& getId() const { return m_id; }
         const std::string& getName() const { return m_name; }
         int getAge() const { return m_age; }
@@ -117,8 +98,16 @@ namespace SevenWondersDuel {
         const ResourceCost& getCost() const { return m_cost; }
         const std::string& getChainTag() const { return m_chainTag; }
         const std::string& getRequiresChainTag() const { return m_requiresChainTag; }
+        std::uint32_t getChainBit() const { return m_chainBit; }
+        std::uint32_t getRequiresChainBit() const { return m_requiresChainBit; }
         const std::vector<std::shared_ptr<IEffect>>& getEffects() const { return m_effects; }
 
+        /**
+         * @brief 与对局状态无关的分数 (不含公会等动态计分部分)
+         */
+        int getStaticVictoryPoints() const { return m_staticVictoryPoints; }
+
+        void setIndex(CardIndex index) { m_index = index; }
         void setId(const std::string& id) { m_id = id; }
         void setName(const std::string& name) { m_name = name; }
         void setAge(int age) { m_age = age; }
@@ -126,7 +115,8 @@ namespace SevenWondersDuel {
         void setCost(const ResourceCost& cost) { m_cost = cost; }
         void setChainTag(const std::string& tag) { m_chainTag = tag; }
         void setRequiresChainTag(const std::string& tag) { m_requiresChainTag = tag; }
-        void setEffects(std::vector<std::shared_ptr<IEffect>> effects) { m_effects = std::move(effects); }
+        void setChainBits(std::uint32_t provides, std::uint32_t requires) { m_chainBit = provides; m_requiresChainBit = requires; }
+        void setEffects(std::vector<std::shared_ptr<IEffect>> effects);
 
         /**
          * @brief 计算此卡提供的胜利点数
@@ -138,46 +128,41 @@ namespace SevenWondersDuel {
     /**
      * @brief 奇迹实体类
      * 奇迹是一种特殊的“卡牌”，在游戏开始时轮抽获得，建造后提供强力效果。
+     * 与 Card 一样只保存静态数据，属于 CardDatabase。
      */
     class Wonder {
     private:
+        WonderIndex m_index = NO_WONDER; // 数据库中的稠密索引
         std::string m_id;
         std::string m_name;
         ResourceCost m_cost;
 
         std::vector<std::shared_ptr<IEffect>> m_effects;
-
-        bool m_isBuilt = false;                  // 是否已建造
-        const Card* m_builtOverlayCard = nullptr; // 用于建造该奇迹所垫在下面的卡牌 (仅作记录)
+        int m_staticVictoryPoints = 0;
 
     public:
         Wonder() = default;
 
+        WonderIndex getIndex() const { return m_index; }
         const std::string& getId() const { return m_id; }
         const std::string& getName() const { return m_name; }
         const ResourceCost& getCost() const { return m_cost; }
         const std::vector<std::shared_ptr<IEffect>>& getEffects() const { return m_effects; }
-        bool isBuilt() const { return m_isBuilt; }
-        const Card* getBuiltOverlayCard() const { return m_builtOverlayCard; }
 
+        /**
+         * @brief 建成后提供的分数 (奇迹效果均与对局状态无关)
+         */
+        int getStaticVictoryPoints() const { return m_staticVictoryPoints; }
+
+        void setIndex(WonderIndex index) { m_index = index; }
         void setId(const std::string& id) { m_id = id; }
         void setName(const std::string& name) { m_name = name; }
         void setCost(const ResourceCost& cost) { m_cost = cost; }
-        void setEffects(std::vector<std::shared_ptr<IEffect>> effects) { m_effects = std::move(effects); }
-
-        /**
-         * @brief 标记奇迹为已建造
-         * @param overlay 垫在奇迹下面的那张牌 (通常来自于金字塔)
-         */
-        void build(const Card* overlay);
-        
-        /**
-         * @brief 重置奇迹状态 (用于新游戏初始化)
-         */
-        void reset();
+        void setEffects(std::vector<std::shared_ptr<IEffect>> effects);
 
         /**
          * @brief 计算奇迹提供的胜利点数
+         * 奇迹对象只读且在多局间共享，建造状态由 Player 记录；未被 self 建成时返回 0。
          */
         int getVictoryPoints(const Player* self, const Player* opponent) const;
     };
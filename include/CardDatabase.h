@@ -0,0 +1,86 @@
+#ifndef SEVEN_WONDERS_DUEL_CARDDATABASE_H
+#define SEVEN_WONDERS_DUEL_CARDDATABASE_H
+
+#include "Global.h"
+#include "Card.h"
+#include <memory>
+#include <vector>
+#include <string>
+#include <unordered_map>
+
+namespace SevenWondersDuel {
+
+    class IGameFactory;
+
+    /**
+     * @brief 只读卡牌数据库
+     * 持有从 gamedata.json 加载的全部卡牌、奇迹及其效果对象。
+     * 构建完成后不再修改，可由任意多个 GameModel (包括不同线程中的对局) 共享。
+     * 每局的可变状态 (金币、已建造列表、金字塔、弃牌堆等) 全部保存在 GameModel / Player / Board 中，
+     * 它们只持有指向本数据库的 const 指针。
+     * 构造时为每张卡牌与奇迹分配稠密索引 (CardIndex / WonderIndex)，并把连锁标记字符串映射为位 (至多 32 种)。
+     */
+    class CardDatabase {
+    public:
+        CardDatabase(std::vector<Card> cards, std::vector<Wonder> wonders, std::vector<ProgressToken> tokens);
+
+        // 禁止拷贝：对局中的 const Card* / const Wonder* 都指向这里的存储
+        CardDatabase(const CardDatabase&) = delete;
+        CardDatabase& operator=(const CardDatabase&) = delete;
+
+        /**
+         * @brief 通过 BaseGameFactory 从 JSON 加载
+         * 加载失败时与工厂一致，直接终止进程。
+         */
+        static std::shared_ptr<const CardDatabase> loadFromJson(const std::string& jsonPath);
+
+        /**
+         * @brief 从预编译镜像加载 (内存映射，不解析 JSON；镜像由 SevenWondersDuelCardCompiler 生成)
+         * @return 文件缺失、截断或格式不符时返回 nullptr
+         */
+        static std::shared_ptr<const CardDatabase> loadFromImage(const std::string& imagePath);
+
+        /**
+         * @brief 优先从 jsonPath 对应的镜像加载 (见 CardImageFormat::imagePathFor)
+         * 镜像记录的源 JSON 校验和与当前 JSON 不符 (JSON 修改后未重新编译) 或镜像无效时回退到 JSON；
+         * JSON 文件不存在时直接使用镜像。
+         */
+        static std::shared_ptr<const CardDatabase> load(const std::string& jsonPath);
+
+        /**
+         * @brief 用任意工厂的产出构建数据库
+         */
+        static std::shared_ptr<const CardDatabase> fromFactory(IGameFactory& factory);
+
+        const std::vector<Card>& getCards() const { return m_cards; }
+        const std::vector<Wonder>& getWonders() const { return m_wonders; }
+
+        /**
+         * @brief 全部科技标记 (固定顺序，每局由 GameController 洗牌)
+         */
+        const std::vector<ProgressToken>& getProgressTokens() const { return m_tokens; }
+
+        /**
+         * @brief 按稠密索引取卡牌 / 奇迹 (O(1))，越界返回 nullptr
+         */
+        const Card* getCard(CardIndex index) const { return index < m_cards.size() ? &m_cards[index] : nullptr; }
+        const Wonder* getWonder(WonderIndex index) const { return index < m_wonders.size() ? &m_wonders[index] : nullptr; }
+
+        /**
+         * @brief 按字符串 ID 查找 (仅用于 I/O 边界)
+         */
+        const Card* findCard(const std::string& id) const;
+        const Wonder* findWonder(const std::string& id) const;
+
+    private:
+        std::vector<Card> m_cards;
+        std::vector<Wonder> m_wonders;
+        std::vector<ProgressToken> m_tokens;
+
+        std::unordered_map<std::string, const Card*> m_cardIndex;
+        std::unordered_map<std::string, const Wonder*> m_wonderIndex;
+    };
+
+}
+
+#endif // SEVEN_WONDERS_DUEL_CARDDATABASE_H
@@ -0,0 +1,57 @@
+#ifndef SEVEN_WONDERS_DUEL_CARDIMAGE_H
+#define SEVEN_WONDERS_DUEL_CARDIMAGE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace SevenWondersDuel {
+
+    /**
+     * @brief 预编译卡牌数据库镜像的文件格式 (小端，全部为定长记录)
+     *
+     * - 文件头 64 字节：魔数 "7WDB"、u16 版本、u16 保留、u64 源 JSON 校验和、
+     *   u32 卡牌数 / 奇迹数 / 效果数 / 连锁标记数 / 科技标记数 / 字符串区字节数、u64 镜像体校验和、保留
+     * - 卡牌 (32 字节)：id、名称 (各为 u32 偏移 + u32 长度的字符串引用)、u8 时代、u8 类型、
+     *   费用 (u8 金币 + 每种资源 u8)、u8 提供 / 需要的连锁标记序号 (0xFF 表示无)、u16 首个效果、u8 效果数
+     * - 奇迹 (32 字节)：id、名称、费用、u16 首个效果、u8 效果数
+     * - 效果 (12 字节)：EffectSpec 的 kind / flags / arg、每种资源 u8、i32 数值
+     * - 连锁标记：每个一个字符串引用，按在卡牌中首次出现的顺序
+     * - 科技标记：每个 u8 (ProgressToken)
+     * - 字符串区：UTF-8 字节，不以 0 结尾
+     *
+     * 各段按上述顺序紧接文件头，长度由计数决定。源 JSON 校验和用于发现 JSON 修改后未重新编译的镜像，
+     * 镜像体校验和 (文件头之后的全部字节) 用于发现截断或损坏。
+     * 由 BaseGameFactory::compileImage 生成，BinaryGameFactory 读取。
+     */
+    class CardImageFormat {
+    public:
+        static constexpr char MAGIC[4] = {'7', 'W', 'D', 'B'};
+        static constexpr std::uint16_t VERSION = 1;
+        static constexpr size_t HEADER_BYTES = 64;
+        static constexpr size_t CARD_BYTES = 32;
+        static constexpr size_t WONDER_BYTES = 32;
+        static constexpr size_t EFFECT_BYTES = 12;
+        static constexpr size_t STRING_REF_BYTES = 8;
+        static constexpr std::uint8_t NO_TAG = 0xFF;
+
+        /**
+         * @brief 64 位校验和 (每次吸收 8 字节的乘法散列；只用于发现修改与损坏，不抗碰撞攻击)
+         */
+        static std::uint64_t checksum(const std::uint8_t* data, size_t size);
+
+        /**
+         * @brief 整个文件内容的校验和
+         * @return 文件无法读取 (或为空) 时返回 false
+         */
+        static bool checksumFile(const std::string& path, std::uint64_t& out);
+
+        /**
+         * @brief JSON 对应的镜像路径 (扩展名换为 .bin，例如 gamedata.json -> gamedata.bin)
+         */
+        static std::string imagePathFor(const std::string& jsonPath);
+    };
+
+}
+
+#endif // SEVEN_WONDERS_DUEL_CARDIMAGE_H
@@ -0,0 +1,68 @@
+#ifndef SEVEN_WONDERS_DUEL_DETERMINIZATION_H
+#define SEVEN_WONDERS_DUEL_DETERMINIZATION_H
+
+#include "Global.h"
+#include "Random.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace SevenWondersDuel {
+
+    class GameController;
+    class GameModel;
+    class Card;
+    class Wonder;
+
+    /**
+     * @brief 隐藏信息抽样器 (Determinization)
+     * 七大奇迹对决中双方看到的信息完全相同，隐藏的只有：
+     * - 金字塔中背面朝上的卡牌；
+     * - 每个时代发牌时移出的 3 张卡 (第三时代另有 4 张未入选的公会)；
+     * - 之后时代的发牌与第二轮奇迹轮抽 (由发牌随机流决定)。
+     *
+     * sample() 只依据公开信息计算"尚未出现的卡牌池"，为背面朝上的卡槽重新抽一组
+     * 与之一致的卡牌 (第三时代保持公会数量为 3)，并重置发牌随机流、打乱剩余奇迹。
+     * 因此在抽样后的局面上搜索不会读到真实的隐藏牌面。
+     *
+     * 对象内缓冲区可复用，在搜索循环中反复调用不分配内存。
+     */
+    class Determinizer {
+    public:
+        /**
+         * @brief 在 state 上原地重新抽样全部隐藏信息
+         */
+        void sample(GameController& state, Xoshiro256& rng);
+
+        /**
+         * @brief 按公开信息收集当前时代尚未出现的卡牌
+         * @param ageCards 本时代的非公会卡
+         * @param guilds 公会卡 (仅第三时代非空)
+         */
+        static void collectUnseenCards(const GameModel& model, std::vector<const Card*>& ageCards, std::vector<const Card*>& guilds);
+
+        /**
+         * @brief 背面朝上的卡槽中应有几张公会 (第三时代金字塔恰有 GUILDS_PER_GAME 张，其余时代为 0)
+         * @param unseenGuilds collectUnseenCards 得到的公会卡数
+         * @param hiddenSlots 背面朝上的卡槽数
+         */
+        static size_t hiddenGuildCount(const GameModel& model, size_t unseenGuilds, size_t hiddenSlots);
+
+        /**
+         * @brief 把 card 放入背面朝上的卡槽 slot
+         * 若 card 原本在另一个背面朝上的卡槽中，两槽互换，保证同一张卡不会出现两次。
+         * @return slot 不是背面朝上的卡槽时返回 false
+         */
+        static bool placeHiddenCard(GameController& state, int slot, const Card* card);
+
+    private:
+        std::vector<const Card*> m_unseenAge;
+        std::vector<const Card*> m_unseenGuilds;
+        std::vector<const Card*> m_hand;
+        std::vector<int> m_hiddenSlots;
+        std::vector<const Wonder*> m_wonders;
+    };
+
+}
+
+#endif // SEVEN_WONDERS_DUEL_DETERMINIZATION_H
@@ -2,6 +2,8 @@
 #define SEVEN_WONDERS_DUEL_EFFECTSYSTEM_H
 
 #include "Global.h"
+#include <array>
+#include <cstdint>
 #include <vector>
 #include <map>
 #include <string>
@@ -17,11 +19,13 @@ namespace SevenWondersDuel {
     /**
      * @brief 日志接口 (Interface Segregation)
      * 让 EffectSystem 能够记录日志，而不需要依赖完整的 Controller。
+     * 调用方应先检查 isLogEnabled 再拼接消息，关闭日志时不构造字符串。
      */
     class ILogger {
     public:
         virtual ~ILogger() = default;
         virtual void addLog(const std::string& msg) = 0;
+        virtual bool isLogEnabled() const { return true; }
     };
 
     /**
@@ -36,13 +40,14 @@ namespace SevenWondersDuel {
         virtual void grantExtraTurn() = 0;
 
         // 抽象化的棋盘操作
-        virtual std::vector<int> moveMilitary(int shields, int playerId) = 0;
+        virtual MilitaryLoot moveMilitary(int shields, int playerId) = 0;
         virtual bool isDiscardPileEmpty() const = 0;
     };
 
     /**
      * @brief 效果基类 (Command Pattern)
      * 代表卡牌或奇迹被建造后产生的具体影响。
+     * 效果对象属于只读的 CardDatabase，可被多个并发对局共享，因此所有接口均为 const。
      */
     class IEffect {
     public:
@@ -56,7 +61,19 @@ namespace SevenWondersDuel {
          * @param logger 日志记录器
          * @param actions 游戏动作回调接口
          */
-        virtual void apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) = 0;
+        virtual void apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) const = 0;
+
+        /**
+         * @brief 只建立效果的持续状态 (产量、科技符号、交易优惠)
+         * 不产生金币、军事、状态切换等一次性结果；用于从紧凑编码 (PackedState) 重建玩家。
+         * apply 对持续状态的修改必须与之一致。
+         */
+        virtual void applyPassive(Player* self) const {}
+
+        /**
+         * @brief 撤销 applyPassive 建立的持续状态 (卡牌被摧毁或撤销建造时调用)
+         */
+        virtual void revertPassive(Player* self) const {}
 
         /**
          * @brief 计算该效果提供的胜利点数
@@ -64,6 +81,12 @@ namespace SevenWondersDuel {
          */
         virtual int calculateScore(const Player* self, const Player* opponent) const { return 0; }
 
+        /**
+         * @brief 分数是否与对局状态无关
+         * 静态分数在加载数据时预先求和 (见 Card::getStaticVictoryPoints)，计分时无需再调用 calculateScore。
+         */
+        virtual bool isScoreStatic() const { return true; }
+
         /**
          * @brief 获取效果描述文本
          * 用于 UI 显示。
@@ -79,12 +102,17 @@ namespace SevenWondersDuel {
         std::map<ResourceType, int> producedResources;
         bool isChoice;   // true=多选一 (黄卡/奇迹), false=固定产出 (棕/灰)
         bool isTradable; // true=对手可见产量 (棕/灰), false=私有产量 (黄/奇迹)
+        std::uint8_t choiceMask = 0; // 多选一的资源位掩码 (第 r 位对应 ResourceType r)
 
     public:
         ProductionEffect(std::map<ResourceType, int> res, bool choice = false, bool tradable = false)
-            : producedResources(res), isChoice(choice), isTradable(tradable) {}
+            : producedResources(res), isChoice(choice), isTradable(tradable) {
+            for (auto const& [type, count] : producedResources) choiceMask |= static_cast<std::uint8_t>(1u << static_cast<int>(type));
+        }
 
-        void apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) override;
+        void apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) const override;
+        void applyPassive(Player* self) const override;
+        void revertPassive(Player* self) const override;
         std::string getDescription() const override;
     };
 
@@ -100,7 +128,7 @@ namespace SevenWondersDuel {
         explicit MilitaryEffect(int count, bool fromCard = false)
             : shields(count), isFromCard(fromCard) {}
 
-        void apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) override;
+        void apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) const override;
         std::string getDescription() const override;
     };
 
@@ -113,7 +141,9 @@ namespace SevenWondersDuel {
 
     public:
         explicit ScienceEffect(ScienceSymbol s) : symbol(s) {}
-        void apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) override;
+        void apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) const override;
+        void applyPassive(Player* self) const override;
+        void revertPassive(Player* self) const override;
         std::string getDescription() const override;
     };
 
@@ -126,7 +156,7 @@ namespace SevenWondersDuel {
 
     public:
         explicit VictoryPointEffect(int p) : points(p) {}
-        void apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) override; // 此时不做任何事
+        void apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) const override; // 此时不做任何事
         int calculateScore(const Player* self, const Player* opponent) const override;
         std::string getDescription() const override;
     };
@@ -140,7 +170,7 @@ namespace SevenWondersDuel {
 
     public:
         explicit CoinEffect(int a) : amount(a) {}
-        void apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) override;
+        void apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) const override;
         std::string getDescription() const override;
     };
 
@@ -158,7 +188,7 @@ namespace SevenWondersDuel {
         CoinsPerTypeEffect(CardType type, int amount, bool wonder = false)
             : targetType(type), coinsPerCard(amount), countWonder(wonder) {}
 
-        void apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) override;
+        void apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) const override;
         std::string getDescription() const override;
     };
 
@@ -172,7 +202,9 @@ namespace SevenWondersDuel {
 
     public:
         explicit TradeDiscountEffect(ResourceType r) : resource(r) {}
-        void apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) override;
+        void apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) const override;
+        void applyPassive(Player* self) const override;
+        void revertPassive(Player* self) const override;
         std::string getDescription() const override;
     };
 
@@ -185,7 +217,7 @@ namespace SevenWondersDuel {
 
     public:
         explicit DestroyCardEffect(CardType color) : targetColor(color) {}
-        void apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) override;
+        void apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) const override;
         std::string getDescription() const override;
     };
 
@@ -194,7 +226,7 @@ namespace SevenWondersDuel {
      */
     class ExtraTurnEffect : public IEffect {
     public:
-        void apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) override;
+        void apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) const override;
         std::string getDescription() const override { return "Take another turn immediately."; }
     };
 
@@ -203,7 +235,7 @@ namespace SevenWondersDuel {
      */
     class BuildFromDiscardEffect : public IEffect {
     public:
-        void apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) override;
+        void apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) const override;
         std::string getDescription() const override { return "Build a card from discard pile for free."; }
     };
 
@@ -212,7 +244,7 @@ namespace SevenWondersDuel {
      */
     class ProgressTokenSelectEffect : public IEffect {
     public:
-        void apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) override;
+        void apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) const override;
         std::string getDescription() const override { return "Choose a progress token from the box."; }
     };
 
@@ -224,7 +256,7 @@ namespace SevenWondersDuel {
         int amount;
     public:
         explicit OpponentLoseCoinsEffect(int a) : amount(a) {}
-        void apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) override;
+        void apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) const override;
         std::string getDescription() const override;
     };
 
@@ -257,11 +289,42 @@ namespace SevenWondersDuel {
     public:
         explicit GuildEffect(GuildCriteria c);
 
-        void apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) override;
+        void apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) const override;
         int calculateScore(const Player* self, const Player* opponent) const override;
+        bool isScoreStatic() const override { return false; }
         std::string getDescription() const override;
     };
 
+    /**
+     * @brief 效果种类 (与 gamedata.json 中的 "type" 一一对应，两种 PRODUCTION 合并为一种)
+     */
+    enum class EffectKind : std::uint8_t {
+        PRODUCTION, MILITARY, VICTORY_POINTS, SCIENCE, COINS, TRADE_DISCOUNT, COINS_PER_TYPE,
+        DESTROY_CARD, EXTRA_TURN, BUILD_FROM_DISCARD, PROGRESS_TOKEN_SELECT, OPPONENT_LOSE_COINS, GUILD,
+        COUNT
+    };
+
+    /**
+     * @brief 效果的纯数据描述 (定长、平凡可复制)
+     * JSON 先解析为 EffectSpec 再构造 IEffect；预编译的卡牌镜像 (CardImage.h) 直接存储这些记录，
+     * 加载时跳过 JSON，两条路径共用同一个构造函数 EffectFactory::createEffect。
+     */
+    struct EffectSpec {
+        static constexpr int RESOURCE_KINDS = 5;
+
+        // flags 位
+        static constexpr std::uint8_t CHOICE = 1;        // PRODUCTION：多选一
+        static constexpr std::uint8_t TRADABLE = 2;      // PRODUCTION：对手可见产量
+        static constexpr std::uint8_t FROM_CARD = 4;     // MILITARY：来自红卡 (受 Strategy 影响)
+        static constexpr std::uint8_t COUNT_WONDER = 8;  // COINS_PER_TYPE：统计奇迹
+
+        EffectKind kind = EffectKind::COUNT;
+        std::uint8_t flags = 0;
+        std::uint8_t arg = 0;      // ResourceType / ScienceSymbol / CardType / GuildCriteria，视种类而定
+        std::int32_t amount = 0;   // 盾牌数、分数或金币数
+        std::array<std::uint8_t, RESOURCE_KINDS> resources{};   // PRODUCTION：按 ResourceType 的数量
+    };
+
     /**
      * @brief 效果工厂
      * 负责从 JSON 数据解析并创建对应的 IEffect 对象。
@@ -269,6 +332,17 @@ namespace SevenWondersDuel {
     class EffectFactory {
     public:
         static std::vector<std::shared_ptr<IEffect>> createEffects(const nlohmann::json& vList, CardType sourceType, bool isFromCard);
+
+        /**
+         * @brief 只解析不构造 (未知的效果类型被忽略)
+         */
+        static std::vector<EffectSpec> parseEffects(const nlohmann::json& vList, CardType sourceType, bool isFromCard);
+
+        /**
+         * @brief 按描述构造效果对象
+         * @return 种类或参数无效时返回 nullptr
+         */
+        static std::shared_ptr<IEffect> createEffect(const EffectSpec& spec);
     };
 
 }
@@ -0,0 +1,148 @@
+#ifndef SEVEN_WONDERS_DUEL_ENDGAMESOLVER_H
+#define SEVEN_WONDERS_DUEL_ENDGAMESOLVER_H
+
+#include "Agent.h"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace SevenWondersDuel {
+
+    /**
+     * @brief 残局求解结果
+     */
+    struct EndgameResult {
+        bool solved = false;          // 局面不适用或超出时间预算时为 false
+        Action bestMove;
+        double margin = 0.0;          // 最佳着法下的最终分差期望 (行动方视角，见 EndgameSolver)
+        long long nodes = 0;          // 访问的决策节点数
+        long long memoHits = 0;       // 记忆表直接给出结果的次数
+        size_t memoEntries = 0;
+        double seconds = 0.0;
+    };
+
+    /**
+     * @brief 第三时代残局精确求解器
+     * 金字塔只剩最后若干张卡时，剩余博弈树足够小，可以搜索到终局：
+     *
+     * - 终局按平民计分 (ScoringManager 的分项，由 Player 增量维护) 计算分差；
+     *   同分按蓝卡分决出的胜负记为 ±0.5，军事 / 科技即时胜利 (RulesEngine::checkInstantVictory) 记为 ±INSTANT_WIN_MARGIN
+     * - 决策节点为带上下界的 Alpha-Beta，以去掉背面牌面的局面哈希为键记忆化 (结果精确，可跨次求解复用)
+     * - 翻开背面朝上卡牌的动作为机会节点：按公开信息枚举被翻开卡牌的每种可能 (公会数量约束下的精确概率)，
+     *   取期望；因此结果是"期望分差"意义下的最优，且求解从不读取真实的隐藏牌面
+     *
+     * 只剩正面朝上的卡牌时结果即为确定的最优着法与最终分差。
+     */
+    class EndgameSolver {
+    public:
+        static constexpr double INSTANT_WIN_MARGIN = 1000.0;
+
+        /**
+         * @param timeLimitMs 单次求解的时间预算 (毫秒)，<= 0 表示不限时
+         */
+        explicit EndgameSolver(double timeLimitMs = 0.0);
+        ~EndgameSolver();
+
+        /**
+         * @brief 局面是否处于第三时代且金字塔剩余卡牌不超过 maxCards
+         */
+        static bool isApplicable(const GameController& state, int maxCards);
+
+        /**
+         * @brief 求解给定局面 (只要求处于第三时代且未结束)
+         */
+        EndgameResult solve(const GameController& root);
+
+        void setTimeLimitMs(double ms) { m_timeLimitMs = ms; }
+
+        /**
+         * @brief 清空记忆表 (记忆表跨次求解保留，超过 maxMemoEntries 时自动清空)
+         */
+        void clearMemo() { m_memo.clear(); }
+        void setMaxMemoEntries(size_t n) { m_maxMemoEntries = n; }
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        enum class Bound : std::uint8_t { EXACT, LOWER, UPPER };
+
+        struct MemoEntry {
+            double value;
+            Bound bound;
+            std::uint8_t move;        // 最佳动作在生成顺序中的下标
+        };
+
+        double m_timeLimitMs;
+        size_t m_maxMemoEntries = 1 << 22;
+        std::unordered_map<std::uint64_t, MemoEntry> m_memo;
+
+        std::vector<std::unique_ptr<GameController>> m_stack;   // 每层一个复用的控制器
+        std::vector<std::vector<LegalAction>> m_moves;
+        std::vector<std::vector<int>> m_order;                   // 每层的搜索顺序 (动作下标)
+        std::vector<std::vector<const Card*>> m_unseenAge;      // 每层机会节点的候选卡池
+        std::vector<std::vector<const Card*>> m_unseenGuilds;
+        std::vector<std::vector<int>> m_revealSlots;             // 每层动作将翻开的卡槽
+        std::vector<std::vector<const Card*>> m_revealCards;     // 已为前几个卡槽选定的牌面
+
+        EndgameResult m_result;
+        bool m_timed = false;
+        bool m_aborted = false;
+        Clock::time_point m_deadline;
+        int m_rootBest = -1;
+
+        void ensureDepth(size_t plies, const GameController& root);
+
+        /**
+         * @brief 搜索 m_stack[ply]，返回玩家 0 视角的分差 (fail-soft)
+         */
+        double search(int ply, double alpha, double beta);
+
+        /**
+         * @brief 在 m_stack[ply] 上执行第 moveIndex 个动作后的值 (翻牌时对被翻开的卡牌求期望)
+         */
+        double searchAction(int ply, int moveIndex, double alpha, double beta);
+
+        /**
+         * @brief 为 m_revealSlots[ply] 中第 next 个卡槽枚举牌面并取期望，全部确定后执行动作并搜索
+         * @param hidden 第 next 个卡槽之前仍背面朝上的卡槽数
+         * @param hiddenGuilds 其中的公会数
+         */
+        double expectReveal(int ply, const Action& action, size_t next, int hidden, int hiddenGuilds);
+
+        void orderMoves(int ply, int memoMove);
+
+        static double terminalValue(const GameController& state);
+    };
+
+    /**
+     * @brief "残局切换为精确求解"的代理包装
+     * 第三时代金字塔剩余卡牌不超过 exactBelowCards 时用 EndgameSolver 走子，
+     * 求解超时或局面不适用时交给被包装的代理。
+     */
+    class EndgameAgent : public IPlayerAgent {
+    public:
+        // 默认切换点与预算 (tools/bench_endgame.cpp 实测：剩 6 张时约 98% 的局面在 100 ms 内求解完毕)
+        static constexpr int DEFAULT_EXACT_BELOW_CARDS = 6;
+        static constexpr double DEFAULT_TIME_LIMIT_MS = 100.0;
+
+        EndgameAgent(std::unique_ptr<IPlayerAgent> inner, int exactBelowCards, double timeLimitMs, bool showThinking = true);
+
+        Action decideAction(GameController& controller, GameView& view, InputManager& input) override;
+        bool isHuman() const override { return m_inner->isHuman(); }
+        void setRandomStream(const Xoshiro256& rng) override { m_inner->setRandomStream(rng); }
+
+        const EndgameResult& getLastResult() const { return m_lastResult; }
+
+    private:
+        std::unique_ptr<IPlayerAgent> m_inner;
+        int m_exactBelowCards;
+        bool m_showThinking;
+        EndgameSolver m_solver;
+        EndgameResult m_lastResult;
+    };
+
+}
+
+#endif // SEVEN_WONDERS_DUEL_ENDGAMESOLVER_H
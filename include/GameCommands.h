@@ -7,11 +7,14 @@
 namespace SevenWondersDuel {
 
     class GameController;
+    struct UndoRecord;
 
     /**
      * @brief 游戏命令接口 (Command Pattern)
      * 将“玩家的意图”封装为对象，解耦请求者(Agent)和执行者(Controller)。
      * 每个命令负责修改 Model 的状态，并产生副作用 (如写日志)。
+     * 开启撤销历史时，GameController 在 execute 之前压入一条 UndoRecord 并保存执行前的标量状态，
+     * 命令在 execute 中把自己改动的结构 (位置等) 写入记录，undo 据此逆向执行 (见 GameController.h)。
      */
     class IGameCommand {
     public:
@@ -22,6 +25,14 @@ namespace SevenWondersDuel {
          * 修改游戏状态的核心逻辑。
          */
         virtual void execute(GameController& controller) = 0;
+
+        /**
+         * @brief 撤销本命令的结构变化 (由 GameController::undo 调用)
+         * 只需逆向执行卡牌、奇迹、科技标记在各容器间的移动并撤销其持续效果；
+         * 金币、军事、金字塔掩码、状态机等标量以及命令触发的发牌 / 新时代由控制器统一恢复。
+         * @param record execute 时填写的撤销记录
+         */
+        virtual void undo(GameController& controller, const UndoRecord& record) = 0;
     };
 
     /**
@@ -31,6 +42,17 @@ namespace SevenWondersDuel {
     class CommandFactory {
     public:
         static std::unique_ptr<IGameCommand> createCommand(const Action& action);
+
+        /**
+         * @brief 按 Action 在栈上构造命令并执行 (processAction 的执行路径，不做堆分配)
+         * @return 动作类型没有对应的命令时返回 false
+         */
+        static bool executeCommand(GameController& controller, const Action& action);
+
+        /**
+         * @brief 按记录中的 Action 在栈上重建命令并调用其 undo
+         */
+        static void undoCommand(GameController& controller, const UndoRecord& record);
     };
 
     // --- Concrete Commands (具体命令) ---
@@ -40,10 +62,11 @@ namespace SevenWondersDuel {
      * 玩家在游戏开始阶段选择奇迹。
      */
     class DraftWonderCommand : public IGameCommand {
-        std::string wonderId;
+        WonderIndex wonder;
     public:
-        explicit DraftWonderCommand(std::string id);
+        explicit DraftWonderCommand(WonderIndex w);
         void execute(GameController& controller) override;
+        void undo(GameController& controller, const UndoRecord& record) override;
     };
 
     /**
@@ -51,10 +74,11 @@ namespace SevenWondersDuel {
      * 支付费用，将卡牌从金字塔移入玩家区域，触发效果。
      */
     class BuildCardCommand : public IGameCommand {
-        std::string cardId;
+        CardIndex card;
     public:
-        explicit BuildCardCommand(std::string id);
+        explicit BuildCardCommand(CardIndex c);
         void execute(GameController& controller) override;
+        void undo(GameController& controller, const UndoRecord& record) override;
     };
 
     /**
@@ -62,10 +86,11 @@ namespace SevenWondersDuel {
      * 将卡牌移入弃牌堆，玩家获得金币 (2 + 黄卡数)。
      */
     class DiscardCardCommand : public IGameCommand {
-        std::string cardId;
+        CardIndex card;
     public:
-        explicit DiscardCardCommand(std::string id);
+        explicit DiscardCardCommand(CardIndex c);
         void execute(GameController& controller) override;
+        void undo(GameController& controller, const UndoRecord& record) override;
     };
 
     /**
@@ -73,11 +98,12 @@ namespace SevenWondersDuel {
      * 使用一张金字塔卡牌作为垫材，建造手中的奇迹。
      */
     class BuildWonderCommand : public IGameCommand {
-        std::string cardId;    // 垫材 (金字塔中的卡)
-        std::string wonderId;  // 目标奇迹
+        CardIndex card;        // 垫材 (金字塔中的卡)
+        WonderIndex wonder;    // 目标奇迹
     public:
-        BuildWonderCommand(std::string cid, std::string wid);
+        BuildWonderCommand(CardIndex c, WonderIndex w);
         void execute(GameController& controller) override;
+        void undo(GameController& controller, const UndoRecord& record) override;
     };
 
     /**
@@ -89,6 +115,7 @@ namespace SevenWondersDuel {
     public:
         explicit SelectProgressTokenCommand(ProgressToken t);
         void execute(GameController& controller) override;
+        void undo(GameController& controller, const UndoRecord& record) override;
     };
 
     /**
@@ -96,10 +123,11 @@ namespace SevenWondersDuel {
      * 指定对手的一张已建卡牌进行移除。
      */
     class DestructionCommand : public IGameCommand {
-        std::string targetId;
+        CardIndex target; // NO_CARD 表示放弃摧毁
     public:
-        explicit DestructionCommand(std::string tid);
+        explicit DestructionCommand(CardIndex t);
         void execute(GameController& controller) override;
+        void undo(GameController& controller, const UndoRecord& record) override;
     };
 
     /**
@@ -107,10 +135,11 @@ namespace SevenWondersDuel {
      * 从弃牌堆选择一张卡牌免费建造。
      */
     class SelectFromDiscardCommand : public IGameCommand {
-        std::string cardId;
+        CardIndex card;
     public:
-        explicit SelectFromDiscardCommand(std::string id);
+        explicit SelectFromDiscardCommand(CardIndex c);
         void execute(GameController& controller) override;
+        void undo(GameController& controller, const UndoRecord& record) override;
     };
 
     /**
@@ -118,10 +147,11 @@ namespace SevenWondersDuel {
      * 在时代过渡时，决定下一时代的先手玩家。
      */
     class ChooseStartingPlayerCommand : public IGameCommand {
-        std::string targetId; // "ME" or "OPPONENT"
+        bool chooseSelf; // true: 自己先手; false: 对手先手
     public:
-        explicit ChooseStartingPlayerCommand(std::string tid);
+        explicit ChooseStartingPlayerCommand(bool self);
         void execute(GameController& controller) override;
+        void undo(GameController& controller, const UndoRecord& record) override;
     };
 
 }
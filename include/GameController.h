@@ -5,10 +5,14 @@
 #include "Player.h"
 #include "Board.h"
 #include "Card.h"
+#include "CardDatabase.h"
+#include "Random.h"
+#include "Zobrist.h"
+#include <array>
 #include <memory>
 #include <vector>
 #include <string>
-#include <random>
+#include <cstdint>
 
 namespace SevenWondersDuel {
 
@@ -17,6 +21,7 @@ namespace SevenWondersDuel {
     /**
      * @brief 游戏数据模型 (Model Layer Root)
      * 作为一个聚合根，持有游戏所有的动态数据，但不包含业务规则逻辑。
+     * 卡牌/奇迹等静态数据由共享的只读 CardDatabase 提供，本类只保存指向它的 const 指针。
      * 作用：
      * 1. 提供只读接口供 View 层渲染。
      * 2. 提供可变接口供 Controller 层修改。
@@ -32,18 +37,30 @@ namespace SevenWondersDuel {
         VictoryType m_victoryType = VictoryType::NONE;
 
         // 奇迹轮抽相关
-        std::vector<Wonder*> m_draftPool;        // 当前轮抽区可见的4张奇迹
-        std::vector<Wonder*> m_remainingWonders; // 剩下的奇迹（未被选入当前轮抽池）
+        std::vector<const Wonder*> m_draftPool;        // 当前轮抽区可见的4张奇迹
+        std::vector<const Wonder*> m_remainingWonders; // 剩下的奇迹（未被选入当前轮抽池）
 
-        // 数据仓库 (所有实体对象的实际存储地)
-        std::vector<Card> m_allCards;
-        std::vector<Wonder> m_allWonders;
+        // 只读数据仓库 (所有实体对象的实际存储地，可被多局共享)
+        std::shared_ptr<const CardDatabase> m_database;
 
         std::vector<std::string> m_gameLog; // 游戏日志
+        bool m_logEnabled = true;           // 搜索用副本关闭日志以省去字符串分配
+
+        // 当前玩家、时代与轮抽池的 Zobrist 哈希 (玩家与棋盘部分各自维护)
+        std::uint64_t m_hash = 0;
+
+        static std::uint64_t initialHash() { return Zobrist::currentPlayer(0) ^ Zobrist::age(0); }
 
     public:
         GameModel();
 
+        /**
+         * @brief 将 other 的全部对局状态复制到本对象
+         * 卡牌/奇迹指针都指向共享的只读数据库，因此直接按值复制即可，副本之间不会互相影响。
+         * 已有的 Player / Board 对象及其容器容量会被复用。游戏日志不复制，也不修改本对象的日志。
+         */
+        void copyFrom(const GameModel& other);
+
         // --- Getters (Read-Only) ---
 
         const Player* getCurrentPlayer() const { return m_players[m_currentPlayerIndex].get(); }
@@ -57,10 +74,17 @@ namespace SevenWondersDuel {
         int getWinnerIndex() const { return m_winnerIndex; }
         VictoryType getVictoryType() const { return m_victoryType; }
 
-        const std::vector<Wonder*>& getDraftPool() const { return m_draftPool; }
-        const std::vector<Wonder*>& getRemainingWonders() const { return m_remainingWonders; }
-        const std::vector<Card>& getAllCards() const { return m_allCards; }
-        const std::vector<Wonder>& getAllWonders() const { return m_allWonders; }
+        /**
+         * @brief 模型的 64 位 Zobrist 哈希
+         * 汇总各组成部分增量维护的哈希，O(1)。不含 GameState 等控制器状态，见 GameController::getStateHash。
+         */
+        std::uint64_t getHash() const;
+
+        const std::vector<const Wonder*>& getDraftPool() const { return m_draftPool; }
+        const std::vector<const Wonder*>& getRemainingWonders() const { return m_remainingWonders; }
+        const CardDatabase* getDatabase() const { return m_database.get(); }
+        const std::vector<Card>& getAllCards() const { return m_database->getCards(); }
+        const std::vector<Wonder>& getAllWonders() const { return m_database->getWonders(); }
         const std::vector<std::string>& getGameLog() const { return m_gameLog; }
 
         // --- Mutators (Controlled Access) ---
@@ -72,39 +96,105 @@ namespace SevenWondersDuel {
         void clearPlayers() { m_players.clear(); }
         void addPlayer(std::unique_ptr<Player> p) { m_players.push_back(std::move(p)); }
         
-        void setCurrentAge(int age) { m_currentAge = age; }
-        void setCurrentPlayerIndex(int index) { m_currentPlayerIndex = index; }
+        void setCurrentAge(int age) {
+            m_hash ^= Zobrist::age(m_currentAge) ^ Zobrist::age(age);
+            m_currentAge = age;
+        }
+        void setCurrentPlayerIndex(int index) {
+            m_hash ^= Zobrist::currentPlayer(m_currentPlayerIndex) ^ Zobrist::currentPlayer(index);
+            m_currentPlayerIndex = index;
+        }
         void setWinnerIndex(int index) { m_winnerIndex = index; }
         void setVictoryType(VictoryType type) { m_victoryType = type; }
 
         // 奇迹轮抽池管理
-        void clearDraftPool() { m_draftPool.clear(); }
-        void addToDraftPool(Wonder* w) { m_draftPool.push_back(w); }
-        void removeFromDraftPool(const std::string& wonderId);
+        void clearDraftPool();
+        void addToDraftPool(const Wonder* w) {
+            m_draftPool.push_back(w);
+            m_hash ^= Zobrist::draftPool(w->getIndex());
+        }
+        void removeFromDraftPool(WonderIndex wonder);
+        void insertIntoDraftPool(int position, const Wonder* w);
+
+        /**
+         * @brief 把轮抽池中的奇迹按发牌前的顺序放回剩余奇迹末尾 (撤销 dealWondersToDraft)
+         */
+        void returnDraftPoolToRemaining();
 
         void clearRemainingWonders() { m_remainingWonders.clear(); }
-        void addToRemainingWonders(Wonder* w) { m_remainingWonders.push_back(w); }
+        void addToRemainingWonders(const Wonder* w) { m_remainingWonders.push_back(w); }
         void popRemainingWonder();
-        Wonder* backRemainingWonder();
+        const Wonder* backRemainingWonder();
 
-        // 数据填充
-        void populateData(std::vector<Card> cards, std::vector<Wonder> wonders);
+        /**
+         * @brief 重置为一局新游戏的空白状态
+         * 绑定数据库，并清空棋盘、玩家、轮抽池、日志等全部对局数据。
+         */
+        void reset(std::shared_ptr<const CardDatabase> database);
 
-        // 查找辅助
-        Card* findCardById(const std::string& id);
+        // 查找辅助 (索引查找为 O(1)；字符串查找仅供 I/O 边界使用)
+        const Card* getCard(CardIndex index) const { return m_database ? m_database->getCard(index) : nullptr; }
+        const Wonder* getWonder(WonderIndex index) const { return m_database ? m_database->getWonder(index) : nullptr; }
         const Card* findCardById(const std::string& id) const;
-        Wonder* findWonderById(const std::string& id);
         const Wonder* findWonderById(const std::string& id) const;
 
-        std::vector<Wonder*> getPointersToAllWonders();
+        std::vector<const Wonder*> getPointersToAllWonders() const;
 
         // 日志管理
         void addLog(const std::string& msg);
         void clearLog();
+        void truncateLog(size_t size) { if (m_gameLog.size() > size) m_gameLog.resize(size); }
+        void setLogEnabled(bool enabled) { m_logEnabled = enabled; }
+        bool isLogEnabled() const { return m_logEnabled; }
 
         int getRemainingCardCount() const;
     };
 
+    /**
+     * @brief 单步撤销记录 (make/unmake)
+     * 只保存一步动作改动的部分，分三类：
+     * 1. 执行前的定长标量 (每步都保存)：状态机与标志、时代 / 当前玩家 / 胜负、双方金币与已配对科技符号、
+     *    军事位置与掠夺标记、金字塔的拿走 / 翻面 / 可拿取掩码；
+     * 2. 命令在 execute 中填写的结构变化：被拿走的奇迹 / 科技标记 / 弃牌在原容器中的位置，
+     *    被摧毁卡牌在对手建造顺序中的位置，第七座奇迹建成时被移出游戏的奇迹；
+     * 3. 控制器流程的变化：发出第二轮奇迹、开始新时代 (旧金字塔的卡牌与发牌随机流)。
+     * 卡牌、奇迹的建造与摧毁由命令的 undo 逆向执行，产量、科技符号、交易优惠等派生状态
+     * 通过 IEffect::revertPassive 撤销。记录为定长结构，在撤销栈中复用：撤销栈达到某一深度后，
+     * 关闭日志时在该深度的执行与撤销都不做堆分配 (由 SevenWondersDuelUndoBench 统计验证)。
+     */
+    struct UndoRecord {
+        Action action;                      // 撤销时据此重建命令
+
+        // --- 执行前的标量状态 ---
+        GameState state = GameState::WONDER_DRAFT_PHASE_1;
+        bool extraTurnPending = false;
+        int draftTurnCount = 0;
+        CardType pendingDestructionType = CardType::CIVILIAN;
+        int age = 0;
+        int currentPlayer = 0;
+        int winner = -1;
+        VictoryType victoryType = VictoryType::NONE;
+        std::array<int, 2> coins{};
+        std::array<std::uint8_t, 2> claimedSciencePairs{};
+        int militaryPosition = 0;
+        bool lootTokens[4] = {true, true, true, true};
+        CardPyramid::SlotMask pyramidRemoved = 0;
+        CardPyramid::SlotMask pyramidFaceUp = 0;
+        CardPyramid::SlotMask pyramidExposed = 0;
+        size_t logSize = 0;                 // 撤销时截断日志到该长度
+
+        // --- 命令填写 ---
+        int position = -1;                  // 被拿走对象在原容器中的位置 (-1 表示命令未改动容器)
+        std::array<std::uint8_t, 2> clearedWonderCount{};
+        std::array<std::array<const Wonder*, Config::MAX_WONDERS_PER_PLAYER>, 2> clearedWonders{};
+
+        // --- 控制器流程 ---
+        bool wondersDealt = false;          // 本步发出了第二轮奇迹
+        bool ageStarted = false;            // 本步开始了新时代 (金字塔被重新发牌)
+        std::uint8_t pyramidSlotCount = 0;  // 以下两项只在 ageStarted 时有效
+        std::array<const Card*, Config::PYRAMID_SLOTS> pyramidCards{};
+        Xoshiro256 deckRng;
+    };
     /**
      * @brief 游戏核心控制器 (Controller Layer)
      * 实现了 ILogger 和 IGameActions 接口，供 EffectSystem 回调使用。
@@ -126,16 +216,63 @@ namespace SevenWondersDuel {
         friend class DestructionCommand;
         friend class SelectFromDiscardCommand;
         friend class ChooseStartingPlayerCommand;
+        // 信息集搜索需要重新抽样隐藏的牌面与发牌随机流
+        friend class Determinizer;
+        friend class StatePacker;
 
     public:
         GameController();
         ~GameController();
 
+        /**
+         * @brief 复制出一个独立、可继续对局的控制器 (供搜索型 AI 使用)
+         * 副本共享只读 CardDatabase，复制全部对局状态与随机流，不复制游戏日志且关闭日志记录。
+         */
+        std::unique_ptr<GameController> clone() const;
+
+        /**
+         * @brief 将 other 的对局状态复制到本控制器
+         * 复用本对象已分配的内存；在模拟循环中反复调用比 clone() 更便宜。
+         * 不复制撤销历史。
+         */
+        void copyFrom(const GameController& other);
+
+        /**
+         * @brief 开启/关闭撤销历史
+         * 开启后 processAction 为每个命令压入一条 UndoRecord (见其说明)；默认关闭，批量对弈无额外开销。
+         */
+        void setUndoEnabled(bool enabled);
+        bool isUndoEnabled() const { return m_undoEnabled; }
+
+        /**
+         * @brief 撤销最近一次成功执行的动作，精确恢复到执行前的状态
+         * @return 历史为空时返回 false
+         */
+        bool undo();
+        int getUndoDepth() const { return static_cast<int>(m_undoDepth); }
+        void clearUndoHistory() { m_undoDepth = 0; }
+
+        /**
+         * @brief 开启/关闭游戏日志 (批量重放时关闭以省去字符串分配)
+         */
+        void setLogEnabled(bool enabled) { m_model->setLogEnabled(enabled); }
+
+        /**
+         * @brief 把游戏日志截断到前 size 条 (重放中跳转局面后对齐日志)
+         */
+        void truncateLog(size_t size) { m_model->truncateLog(size); }
+
         /**
          * @brief 初始化游戏
          * 加载数据，创建玩家，准备初始状态。
          */
         void initializeGame(const std::string& jsonPath, const std::string& p1Name, const std::string& p2Name);
+
+        /**
+         * @brief 使用已加载的共享数据库初始化游戏
+         * 不再读取 JSON；同一个控制器可反复调用以开始新的一局。
+         */
+        void initializeGame(std::shared_ptr<const CardDatabase> database, const std::string& p1Name, const std::string& p2Name);
         
         /**
          * @brief 开始游戏
@@ -143,19 +280,41 @@ namespace SevenWondersDuel {
          */
         void startGame();
 
+        /**
+         * @brief 设置对局种子
+         * 发牌与科技标记布置分别使用由该种子派生的独立随机流 (见 SeedHierarchy)。
+         * 需在 initializeGame 之前调用；默认以时钟为种子。
+         */
+        void setSeed(std::uint64_t gameSeed);
+        std::uint64_t getSeed() const { return m_gameSeed; }
+
         GameState getState() const;
         const GameModel& getModel() const;
 
+        /**
+         * @brief 完整局面的 64 位 Zobrist 哈希
+         * 在 GameModel::getHash 之上并入 GameState、"再次行动"标记与待摧毁的卡牌颜色。
+         * 可用作置换表键、对局语料去重或廉价的局面相等性检查 (不同局面碰撞的概率约为 2^-64)。
+         */
+        std::uint64_t getStateHash() const;
+
         /**
          * @brief 验证动作是否合法
          * 委托给当前的 m_stateLogic 进行验证。
          */
         ActionResult validateAction(const Action& action);
 
+        /**
+         * @brief 生成当前状态下的全部合法动作 (附带金币花费)
+         * 委托给当前的 m_stateLogic；一次遍历可选卡槽完成，替代逐个构造 Action 再 validateAction 的试探方式。
+         * @param out 输出缓冲，调用前会被清空
+         */
+        void generateLegalActions(std::vector<LegalAction>& out) const;
+
         /**
          * @brief 执行动作
          * 1. 验证动作
-         * 2. 创建对应 Command
+         * 2. 在栈上创建对应 Command
          * 3. 执行 Command
          * 4. 触发 EffectSystem
          * 5. 检查胜利条件
@@ -169,29 +328,59 @@ namespace SevenWondersDuel {
         CardType getPendingDestructionType() const { return m_pendingDestructionType; }
 
         void setState(GameState newState) override;
-        std::vector<int> moveMilitary(int shields, int playerId) override;
+        MilitaryLoot moveMilitary(int shields, int playerId) override;
         bool isDiscardPileEmpty() const override;
         void grantExtraTurn() override { m_extraTurnPending = true; }
         void addLog(const std::string& msg) override { m_model->addLog(msg); }
+        bool isLogEnabled() const override { return m_model->isLogEnabled(); }
 
     private:
         std::unique_ptr<GameModel> m_model;
-        std::unique_ptr<IGameStateLogic> m_stateLogic; // 当前状态逻辑处理对象
+        IGameStateLogic* m_stateLogic = nullptr;       // 当前状态逻辑处理对象 (无状态，进程内共享)
         GameState m_currentState = GameState::WONDER_DRAFT_PHASE_1;
 
         bool m_extraTurnPending = false; // 是否触发了再次行动 (如奇迹效果)
         int m_draftTurnCount = 0;        // 轮抽阶段计数
 
-        std::mt19937 m_rng; // 随机数生成器
+        std::uint64_t m_gameSeed = 0; // 对局种子
+        Xoshiro256 m_deckRng;         // 发牌随机流 (奇迹轮抽 + 时代卡牌)
+        Xoshiro256 m_tokenRng;        // 科技标记布置随机流
 
         CardType m_pendingDestructionType = CardType::CIVILIAN; // 等待摧毁的卡牌类型
 
+        // 发牌缓冲区 (不属于局面状态，不参与复制)：在控制器内复用，开始新时代时不再分配
+        std::vector<const Card*> m_deckBuffer;
+        std::vector<const Card*> m_guildBuffer;
+
+        // 撤销栈：[0, m_undoDepth) 为有效记录，其余为可复用的空闲记录
+        bool m_undoEnabled = false;
+        std::vector<UndoRecord> m_undoStack;
+        size_t m_undoDepth = 0;
+        UndoRecord* m_recording = nullptr; // 正在执行的命令的撤销记录 (未开启撤销时为 nullptr)
+
+        /**
+         * @brief 压入一条撤销记录并保存执行前的标量状态
+         */
+        UndoRecord& beginUndoRecord(const Action& action);
+
+#ifndef NDEBUG
+        /**
+         * @brief 调试构建：比对 Player 增量计分与 ScoringManager 参考实现
+         */
+        void checkScoreConsistency() const;
+
+        /**
+         * @brief 调试构建：比对增量维护的 Zobrist 哈希与从头计算的结果
+         */
+        void checkHashConsistency() const;
+#endif
+
         void updateStateLogic(GameState newState);
 
         // --- 内部流程 ---
         void setupAge(int age);
         void prepareNextAge();
-        std::vector<Card*> prepareDeckForAge(int age);
+        const std::vector<const Card*>& prepareDeckForAge(int age);
         void initWondersDeck();
         void dealWondersToDraft();
         
@@ -200,10 +389,10 @@ namespace SevenWondersDuel {
         void checkVictoryConditions();
         
         // --- 辅助逻辑 ---
-        void resolveMilitaryLoot(const std::vector<int>& lootEvents);
+        void resolveMilitaryLoot(const MilitaryLoot& lootEvents);
         bool checkForNewSciencePairs(Player* p);
-        Card* findCardInPyramid(const std::string& id);
-        Wonder* findWonderInHand(const Player* p, const std::string& id);
+        const Card* findCardInPyramid(CardIndex card);
+        const Wonder* findWonderInHand(const Player* p, WonderIndex wonder);
     };
 }
 
@@ -4,6 +4,7 @@
 #include "Card.h"
 #include "Global.h"
 #include <nlohmann/json.hpp>
+#include <cstdint>
 #include <vector>
 #include <string>
 
@@ -12,14 +13,18 @@ namespace SevenWondersDuel {
     /**
      * @brief 游戏工厂接口 (Abstract Factory)
      * 负责创建游戏中所有的初始化数据对象：卡牌、奇迹、科技标记。
+     * 工厂只产出静态数据 (通常用于构建一次 CardDatabase)，每局的洗牌与布置由 GameController 完成。
      */
     class IGameFactory {
     public:
         virtual ~IGameFactory() = default;
         virtual std::vector<Card> createCards() = 0;
         virtual std::vector<Wonder> createWonders() = 0;
-        virtual std::vector<ProgressToken> createAvailableTokens() = 0;
-        virtual std::vector<ProgressToken> createBoxTokens() = 0;
+
+        /**
+         * @brief 全部科技标记 (固定顺序，未洗牌)
+         */
+        virtual std::vector<ProgressToken> createProgressTokens() = 0;
     };
 
     /**
@@ -29,8 +34,7 @@ namespace SevenWondersDuel {
     class BaseGameFactory : public IGameFactory {
     private:
         nlohmann::json m_jsonData;
-        std::vector<ProgressToken> m_shuffledTokens; // 预先洗牌的 tokens，分发给 Available 和 Box
-        
+
         // 辅助：解析 JSON 中的费用结构
         ResourceCost parseCost(const nlohmann::json& v);
 
@@ -38,13 +42,67 @@ namespace SevenWondersDuel {
         /**
          * @param jsonPath gamedata.json 文件的路径
          */
-        BaseGameFactory(const std::string& jsonPath);
+        explicit BaseGameFactory(const std::string& jsonPath);
         ~BaseGameFactory() override;
         
         std::vector<Card> createCards() override;
         std::vector<Wonder> createWonders() override;
-        std::vector<ProgressToken> createAvailableTokens() override;
-        std::vector<ProgressToken> createBoxTokens() override;
+        std::vector<ProgressToken> createProgressTokens() override;
+
+        /**
+         * @brief 把已加载的 JSON 数据编译为卡牌镜像 (格式见 CardImageFormat)
+         * @param sourceChecksum 写入文件头的源 JSON 校验和
+         * @return 数据超出镜像字段的容量时返回 false
+         */
+        bool compileImage(std::uint64_t sourceChecksum, std::vector<std::uint8_t>& out);
+    };
+
+    /**
+     * @brief 预编译镜像工厂
+     * 直接读取 CardImageFormat 编码的字节 (通常是内存映射的文件)，不解析 JSON；
+     * 产出的卡牌、奇迹与效果对象和 BaseGameFactory 从同一份 JSON 构建的完全相同。
+     * 构造时校验整个镜像，create* 只在 isValid() 时返回数据。底层字节须在 create* 调用期间保持有效。
+     */
+    class BinaryGameFactory : public IGameFactory {
+    private:
+        const std::uint8_t* m_data = nullptr;
+        size_t m_size = 0;
+        bool m_valid = false;
+
+        std::uint32_t m_cardCount = 0;
+        std::uint32_t m_wonderCount = 0;
+        std::uint32_t m_effectCount = 0;
+        std::uint32_t m_tagCount = 0;
+        std::uint32_t m_tokenCount = 0;
+        std::uint32_t m_stringBytes = 0;
+        std::uint64_t m_sourceChecksum = 0;
+
+        std::vector<std::shared_ptr<IEffect>> m_effects;   // 校验时构造，按镜像中的顺序
+
+        // 各段相对 m_data 的偏移
+        size_t m_cardsAt = 0, m_wondersAt = 0, m_effectsAt = 0, m_tagsAt = 0, m_tokensAt = 0, m_stringsAt = 0;
+
+        bool validate();
+        std::string stringAt(size_t refAt) const;
+        ResourceCost costAt(size_t at) const;
+        std::vector<std::shared_ptr<IEffect>> effectsAt(size_t firstAt) const;
+
+    public:
+        BinaryGameFactory(const std::uint8_t* data, size_t size);
+
+        /**
+         * @brief 镜像是否完整且格式正确
+         */
+        bool isValid() const { return m_valid; }
+
+        /**
+         * @brief 编译时源 JSON 的校验和 (与当前 JSON 比较以发现过期的镜像)
+         */
+        std::uint64_t getSourceChecksum() const { return m_sourceChecksum; }
+
+        std::vector<Card> createCards() override;
+        std::vector<Wonder> createWonders() override;
+        std::vector<ProgressToken> createProgressTokens() override;
     };
 
 }
@@ -2,6 +2,7 @@
 #define SEVEN_WONDERS_DUEL_GAMESTATELOGIC_H
 
 #include "Global.h"
+#include <vector>
 
 namespace SevenWondersDuel {
 
@@ -28,6 +29,14 @@ namespace SevenWondersDuel {
          * @return 验证结果 (包含是否通过及错误信息)
          */
         virtual ActionResult validate(const Action& action, GameController& controller) = 0;
+
+        /**
+         * @brief 生成当前状态下的全部合法动作 (追加到 out)
+         * 产出的集合与 validate 判定为合法的动作集合一致，并附带花费。
+         * @param controller 游戏控制器上下文
+         * @param out 输出缓冲 (调用方负责清空，可跨调用复用容量)
+         */
+        virtual void generateActions(const GameController& controller, std::vector<LegalAction>& out) const = 0;
     };
 
     /**
@@ -37,7 +46,7 @@ namespace SevenWondersDuel {
     class WonderDraftState : public IGameStateLogic {
     public:
         ActionResult validate(const Action& action, GameController& controller) override;
-
+        void generateActions(const GameController& controller, std::vector<LegalAction>& out) const override;
     };
 
     /**
@@ -47,6 +56,7 @@ namespace SevenWondersDuel {
     class AgePlayState : public IGameStateLogic {
     public:
         ActionResult validate(const Action& action, GameController& controller) override;
+        void generateActions(const GameController& controller, std::vector<LegalAction>& out) const override;
     };
 
     /**
@@ -56,6 +66,7 @@ namespace SevenWondersDuel {
     class TokenSelectionState : public IGameStateLogic {
     public:
         ActionResult validate(const Action& action, GameController& controller) override;
+        void generateActions(const GameController& controller, std::vector<LegalAction>& out) const override;
     };
 
     /**
@@ -65,6 +76,7 @@ namespace SevenWondersDuel {
     class DestructionState : public IGameStateLogic {
     public:
         ActionResult validate(const Action& action, GameController& controller) override;
+        void generateActions(const GameController& controller, std::vector<LegalAction>& out) const override;
     };
 
     /**
@@ -74,6 +86,7 @@ namespace SevenWondersDuel {
     class DiscardBuildState : public IGameStateLogic {
     public:
         ActionResult validate(const Action& action, GameController& controller) override;
+        void generateActions(const GameController& controller, std::vector<LegalAction>& out) const override;
     };
 
     /**
@@ -83,6 +96,7 @@ namespace SevenWondersDuel {
     class StartPlayerSelectionState : public IGameStateLogic {
     public:
         ActionResult validate(const Action& action, GameController& controller) override;
+        void generateActions(const GameController& controller, std::vector<LegalAction>& out) const override;
     };
     
     /**
@@ -92,6 +106,7 @@ namespace SevenWondersDuel {
     class GameOverState : public IGameStateLogic {
     public:
         ActionResult validate(const Action& action, GameController& controller) override;
+        void generateActions(const GameController& controller, std::vector<LegalAction>& out) const override;
     };
 
 
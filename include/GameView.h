@@ -58,13 +58,22 @@ namespace SevenWondersDuel {
          */
         void renderGameForAI(const GameModel& model, GameState state);
 
+        /**
+         * @brief 重放查看模式渲染
+         * 与 renderGame 相同的局面画面，底部的命令提示换成重放进度与跳转命令。
+         * @param title 标题 (例如对局序号与双方代理)
+         * @param position 已执行的动作数
+         * @param total 对局总动作数
+         */
+        void renderReplay(const GameModel& model, GameState state, const std::string& title, size_t position, size_t total, const std::string& lastError);
+
         // --- 详情页渲染 (Public, 供 InputManager 处理 'info' 命令调用) ---
 		void renderPlayerDashboard(const Player& p, bool isCurrent, const Player& opp, int& wonderCounter, const Board& board, RenderContext& ctx, bool targetMode = false);
         void renderPlayerDetailFull(const Player& p, const Player& opp, const Board& board);
 		void renderCardDetail(const Card& c);
 		void renderWonderDetail(const Wonder& w);
 		void renderTokenDetail(ProgressToken t);
-        void renderDiscardPile(const std::vector<Card*>& pile);
+        void renderDiscardPile(const std::vector<const Card*>& pile);
         void renderFullLog(const std::vector<std::string>& log);
 
 	private:
@@ -104,6 +113,8 @@ namespace SevenWondersDuel {
         void renderActionLog(const std::vector<std::string>& log);
         void renderCommandHelp(GameState state);
         void renderErrorMessage(const std::string& lastError);
+
+        std::string m_replayStatus; // 非空时处于重放查看模式，命令提示显示该进度行
 	};
 
 }
@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <string>
+#include <cstdint>
 #include <map>
 
 namespace SevenWondersDuel {
@@ -104,15 +105,26 @@ namespace SevenWondersDuel {
         PHILOSOPHY    // 哲学：7分
     };
 
+    /**
+     * @brief 卡牌 / 奇迹的稠密索引
+     * 由 CardDatabase 在加载时按数据顺序分配 (0..N-1)。引擎内部一律用索引标识卡牌与奇迹，
+     * 字符串 ID 只出现在 JSON、界面与日志等 I/O 边界。
+     */
+    using CardIndex = std::uint8_t;
+    using WonderIndex = std::uint8_t;
+    constexpr CardIndex NO_CARD = 0xFF;
+    constexpr WonderIndex NO_WONDER = 0xFF;
+
     /**
      * @brief 动作描述结构体
      * 封装一次玩家决策的所有必要信息，传递给 Controller 执行。
      */
     struct Action {
         ActionType type;
-        std::string targetCardId;         // 目标卡牌ID (用于 Build/Discard/Wonder)
-        std::string targetWonderId;       // 目标奇迹ID (用于 BuildWonder/Draft)
+        CardIndex targetCard = NO_CARD;       // 目标卡牌 (Build/Discard/Wonder/摧毁/陵墓；摧毁时 NO_CARD 表示放弃)
+        WonderIndex targetWonder = NO_WONDER; // 目标奇迹 (BuildWonder/Draft)
         ProgressToken selectedToken = ProgressToken::NONE; // 选择的科技标记
+        bool chooseSelf = true;               // 选择先手：true 为自己先手，false 为对手先手
         ResourceType chosenResource = ResourceType::WOOD;  // (备用) 某些特殊效果选择资源
     };
 
@@ -126,6 +138,52 @@ namespace SevenWondersDuel {
         std::string message; // 错误信息或成功提示
     };
 
+    /**
+     * @brief 合法动作 (由动作生成器产出)
+     * 附带预先计算好的金币花费，调用方无需再次 validateAction。
+     */
+    struct LegalAction {
+        Action action;
+        int cost = 0;        // 执行该动作需要支付的总金币 (含交易费；连锁建造为 0)
+    };
+
+    /**
+     * @brief 一次军事移动触发的掠夺事件 (至多 4 个掠夺标记，定长以免堆分配)
+     * 负数表示 P0 损失金币，正数表示 P1 损失金币。
+     */
+    struct MilitaryLoot {
+        int amounts[4] = {};
+        int count = 0;
+
+        void push(int amount) { amounts[count++] = amount; }
+        const int* begin() const { return amounts; }
+        const int* end() const { return amounts + count; }
+    };
+
+    /**
+     * @brief 分项得分 (平民胜利计分的各组成部分)
+     * civilian 含蓝卡及其他非绿/黄/紫卡牌的直接分数，guild 含紫卡的全部分数。
+     */
+    struct ScoreBreakdown {
+        int civilian = 0;
+        int science = 0;     // 绿卡上的直接分数
+        int commercial = 0;  // 黄卡上的直接分数
+        int guild = 0;
+        int wonder = 0;
+        int military = 0;
+        int coins = 0;       // 每 3 金币 1 分
+        int tokens = 0;      // 科技标记 (农业/哲学/数学)
+
+        int total() const { return civilian + science + commercial + guild + wonder + military + coins + tokens; }
+
+        friend bool operator==(const ScoreBreakdown& a, const ScoreBreakdown& b) {
+            return a.civilian == b.civilian && a.science == b.science && a.commercial == b.commercial &&
+                   a.guild == b.guild && a.wonder == b.wonder && a.military == b.military &&
+                   a.coins == b.coins && a.tokens == b.tokens;
+        }
+        friend bool operator!=(const ScoreBreakdown& a, const ScoreBreakdown& b) { return !(a == b); }
+    };
+
     /**
      * @brief 胜利类型
      */
@@ -165,6 +223,49 @@ namespace SevenWondersDuel {
 
         static constexpr int TRADING_BASE_COST = 2;         // 基础交易费
         static constexpr int MAX_TOTAL_WONDERS = 7;         // 也就是一旦建成第7个，第8个立即废弃
+        static constexpr int MAX_WONDERS_PER_PLAYER = 4;    // 轮抽后每位玩家持有的奇迹数
+        static constexpr int PYRAMID_SLOTS = 20;            // 每个时代金字塔的卡槽数
+        static constexpr int CARDS_REMOVED_PER_AGE = 3;     // 每个时代发牌前暗中移出的卡牌数
+        static constexpr int GUILDS_PER_GAME = 3;           // 混入第三时代的公会卡数
+        static constexpr int MAX_BUILT_CARDS = 3 * PYRAMID_SLOTS; // 单个玩家最多可建成的卡牌数
+        static constexpr int MAX_CHOICE_PRODUCERS = 8;      // 单个玩家"多选一"产出上限 (实际不超过 4)
+        static constexpr int MAX_PLAYER_NAME = 32;          // 玩家名称缓冲区字节数 (含结尾 0)
+    }
+
+    /**
+     * @brief 位运算辅助 (用于各类位掩码状态)
+     */
+    namespace Bits {
+        inline int popcount(std::uint32_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_popcount(x);
+#else
+            int n = 0;
+            for (; x; x &= x - 1) ++n;
+            return n;
+#endif
+        }
+
+        inline int popcount64(std::uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_popcountll(x);
+#else
+            int n = 0;
+            for (; x; x &= x - 1) ++n;
+            return n;
+#endif
+        }
+
+        /** @brief 最低位 1 的位置 (x 不能为 0) */
+        inline int lowestBit(std::uint32_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_ctz(x);
+#else
+            int n = 0;
+            while (!(x & 1u)) { x >>= 1; ++n; }
+            return n;
+#endif
+        }
     }
 
     // 字符串转换辅助函数
@@ -35,6 +35,20 @@ namespace SevenWondersDuel {
          */
         Action promptHumanAction(GameView& view, const GameModel& model, GameState state);
 
+        /**
+         * @brief 重放查看的交互 (阻塞式)
+         * 渲染当前局面并读取一条跳转命令：next/prev [N] 前进/后退 N 个动作 (默认 1)，
+         * jump <N> 跳到第 N 个动作之后，start / end 跳到开局 / 终局；log、detail 原地查看。
+         *
+         * @param title 显示在进度行的标题
+         * @param position 当前已执行的动作数
+         * @param total 对局总动作数
+         * @param target [Out] 要跳转到的动作数 (已限制在 [0, total])
+         * @return 输入 quit 或输入结束时返回 false
+         */
+        bool promptReplaySeek(GameView& view, const GameModel& model, GameState state, const std::string& title,
+                              size_t position, size_t total, size_t& target);
+
         void setLastError(const std::string& msg) { m_lastError = msg; }
         void clearLastError() { m_lastError = ""; }
         const std::string& getLastError() const { return m_lastError; }
@@ -0,0 +1,183 @@
+#ifndef SEVEN_WONDERS_DUEL_MCTS_H
+#define SEVEN_WONDERS_DUEL_MCTS_H
+
+#include "Agent.h"
+#include "Random.h"
+#include "Determinization.h"
+#include <memory>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+
+namespace SevenWondersDuel {
+
+    /**
+     * @brief 多线程搜索方式
+     */
+    enum class MCTSParallelMode {
+        ROOT,   // 根并行：每个线程在各自的局面副本上建一棵独立的树，结束后按根动作合并访问次数
+        TREE    // 树并行：所有线程共享一棵树，节点统计为原子量，下降时施加虚拟损失 (virtual loss)
+    };
+
+    /**
+     * @brief 蒙特卡洛树搜索配置
+     * timeLimitMs > 0 时按墙钟截止时间搜索 (iterations 被忽略)，否则执行固定次数的迭代。
+     * 多线程时 iterations 为所有线程的迭代总数。
+     */
+    struct MCTSConfig {
+        int iterations = 2000;            // 每次决策的迭代次数
+        double timeLimitMs = 0.0;         // 每次决策的时间预算 (毫秒)
+        double exploration = 1.41;        // UCT 探索常数 c
+        bool heuristicRollout = true;     // true: 有可建造动作时不弃牌；false: 纯随机
+        int maxRolloutActions = 400;      // 单次模拟的动作上限，达到后按当前比分判定
+
+        int threads = 1;                                   // 每次决策使用的线程数
+        MCTSParallelMode parallelMode = MCTSParallelMode::TREE;
+        int virtualLoss = 1;                               // 树并行：每个正在下降的线程给路径节点记的虚拟失败次数
+        int treeNodeCapacity = 1 << 20;                    // 树并行：共享节点池容量，满后不再展开
+    };
+
+    /**
+     * @brief 最近一次决策的搜索统计
+     */
+    struct MCTSStats {
+        long long iterations = 0;
+        long long nodes = 0;              // 树中节点数 (含根；根并行时为各树之和)
+        int rootVisits = 0;               // 被选中动作的访问次数
+        int threads = 1;
+        double seconds = 0.0;
+
+        double iterationsPerSecond() const { return seconds > 0.0 ? iterations / seconds : 0.0; }
+    };
+
+    /**
+     * @brief UCT 蒙特卡洛树搜索代理
+     * 每次决策从当前 GameController 的副本出发搜索，覆盖所有需要决策的状态
+     * (奇迹轮抽、时代出牌、科技标记、摧毁、陵墓复活、选择先手)。
+     *
+     * - 选择：UCB1，奖励为获胜 1 / 平局 0.5 / 失败 0，按"走该步的玩家"视角累计
+     * - 扩展：首次到达的节点一次性展开全部合法动作 (顺序随机打乱)
+     * - 模拟：在复用的控制器副本上快速走子，不记录日志、不渲染
+     * - 决策：返回访问次数最多的根动作
+     *
+     * threads > 1 时按 parallelMode 使用根并行或树并行，工作线程在每次决策内创建并汇合；
+     * 搜索期间只读访问传入的根局面，调用方不得同时修改它。
+     *
+     * 副本继承了发牌随机流，因此该代理看得到未翻开的卡牌与后续时代的发牌 (完全信息搜索)；
+     * 公平对弈请使用 ISMCTSAgent。
+     * 节点池在多次决策间复用，稳态下搜索不分配内存。
+     */
+    class MCTSAgent : public IPlayerAgent {
+    public:
+        explicit MCTSAgent(MCTSConfig config = MCTSConfig(), bool showThinking = true);
+        ~MCTSAgent() override;
+
+        Action decideAction(GameController& controller, GameView& view, InputManager& input) override;
+        void setRandomStream(const Xoshiro256& rng) override { m_rng = rng; }
+
+        const MCTSConfig& getConfig() const { return m_config; }
+        const MCTSStats& getLastStats() const { return m_lastStats; }
+
+        /**
+         * @brief 对给定局面执行一次搜索并返回最佳动作 (不打印任何信息)
+         */
+        Action search(const GameController& root);
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct Node {
+            Action action;                // 从父节点到达此节点的动作
+            int firstChild = -1;          // 子节点在节点池中连续存放
+            int childCount = 0;
+            int visits = 0;
+            double value = 0.0;           // 从 mover 视角累计的奖励
+            int mover = 0;                // 执行 action 的玩家 (根节点无意义)
+            bool expanded = false;
+        };
+
+        struct SharedTree;                // 树并行的共享节点池 (定义见 MCTS.cpp)
+
+        MCTSConfig m_config;
+        bool m_showThinking;
+        Xoshiro256 m_rng;
+        MCTSStats m_lastStats;
+
+        std::vector<Node> m_nodes;                 // 节点池 (每次搜索清空，容量保留)
+        std::vector<int> m_path;                   // 本次迭代经过的节点
+        std::vector<LegalAction> m_legalActions;   // 复用的合法动作缓冲
+        std::unique_ptr<GameController> m_sim;     // 复用的模拟控制器
+
+        std::vector<std::unique_ptr<MCTSAgent>> m_rootWorkers; // 根并行：其余线程各自的单线程搜索器
+        std::unique_ptr<SharedTree> m_sharedTree;
+
+        /**
+         * @brief 单线程搜索，结果留在 m_nodes 中
+         * @return 实际执行的迭代数
+         */
+        long long searchSerial(const GameController& root, long long iterations, bool timed, Clock::time_point deadline);
+        Action searchRootParallel(const GameController& root, int threads, bool timed, Clock::time_point deadline);
+        Action searchTreeParallel(const GameController& root, int threads, bool timed, Clock::time_point deadline);
+
+        void runIteration(const GameController& root);
+        int selectChild(const Node& parent) const;
+        void expand(int nodeIndex, const GameController& state);
+    };
+
+    /**
+     * @brief 信息集蒙特卡洛树搜索代理 (Single-Observer ISMCTS)
+     * 每次迭代先用 Determinizer 为背面朝上的卡牌、移出的卡牌与后续发牌抽一组与公开信息一致的取值，
+     * 再在该抽样局面上沿共享的树下降。树按动作序列组织，所有抽样共用同一组统计：
+     *
+     * - 选择：只在当前抽样中合法的子节点间比较，UCB 中的 N 使用该子节点"可选次数"(availability)
+     * - 扩展：当前抽样中存在尚无子节点的合法动作时，随机添加其中一个
+     * - 模拟 / 回传：与 MCTSAgent 相同
+     *
+     * 双方看到的信息相同，因此单一观察者的树即可同时代表两名玩家。
+     * 搜索从不读取真实的隐藏牌面，在相同迭代预算下与人类对手公平对弈。
+     * 使用 MCTSConfig 的预算、探索常数与模拟策略 (单线程，忽略并行相关字段)。
+     */
+    class ISMCTSAgent : public IPlayerAgent {
+    public:
+        explicit ISMCTSAgent(MCTSConfig config = MCTSConfig(), bool showThinking = true);
+        ~ISMCTSAgent() override;
+
+        Action decideAction(GameController& controller, GameView& view, InputManager& input) override;
+        void setRandomStream(const Xoshiro256& rng) override { m_rng = rng; }
+
+        const MCTSStats& getLastStats() const { return m_lastStats; }
+
+        /**
+         * @brief 对给定局面执行一次搜索并返回最佳动作 (不打印任何信息)
+         */
+        Action search(const GameController& root);
+
+    private:
+        struct Node {
+            Action action;
+            int firstChild = -1;          // 子节点以单链表连接 (不同抽样下逐个添加)
+            int nextSibling = -1;
+            int visits = 0;
+            int availability = 0;         // 该节点作为合法候选出现的次数
+            double value = 0.0;
+            int mover = 0;
+        };
+
+        MCTSConfig m_config;
+        bool m_showThinking;
+        Xoshiro256 m_rng;
+        MCTSStats m_lastStats;
+
+        std::vector<Node> m_nodes;
+        std::vector<int> m_path;
+        std::vector<LegalAction> m_legalActions;
+        std::vector<int> m_matched;                // 每个合法动作对应的子节点 (-1 表示尚未扩展)
+        std::unique_ptr<GameController> m_sim;
+        Determinizer m_determinizer;
+
+        void runIteration(const GameController& root);
+    };
+
+}
+
+#endif // SEVEN_WONDERS_DUEL_MCTS_H
@@ -0,0 +1,44 @@
+#ifndef SEVEN_WONDERS_DUEL_MAPPEDFILE_H
+#define SEVEN_WONDERS_DUEL_MAPPEDFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace SevenWondersDuel {
+
+    /**
+     * @brief 只读内存映射文件 (POSIX mmap / Windows 文件映射)
+     * 文件内容按需由操作系统分页载入，不占用进程堆内存；映射在析构或 close() 时解除。
+     */
+    class MappedFile {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /**
+         * @brief 映射整个文件 (已打开的映射会先被关闭)
+         * @return 文件不存在、为空或映射失败时返回 false
+         */
+        bool open(const std::string& path);
+        void close();
+
+        bool isOpen() const { return m_data != nullptr; }
+        const std::uint8_t* data() const { return m_data; }
+        size_t size() const { return m_size; }
+
+    private:
+        const std::uint8_t* m_data = nullptr;
+        size_t m_size = 0;
+#ifdef _WIN32
+        void* m_file = nullptr;
+        void* m_mapping = nullptr;
+#endif
+    };
+
+}
+
+#endif // SEVEN_WONDERS_DUEL_MAPPEDFILE_H
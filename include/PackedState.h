@@ -0,0 +1,118 @@
+#ifndef SEVEN_WONDERS_DUEL_PACKEDSTATE_H
+#define SEVEN_WONDERS_DUEL_PACKEDSTATE_H
+
+#include "Global.h"
+#include "Random.h"
+#include <array>
+#include <cstdint>
+
+namespace SevenWondersDuel {
+
+    class GameController;
+
+    /**
+     * @brief 完整局面的定长位压缩编码 (128 字节)
+     * 平凡可复制，可直接按字节存入内存数组或写入文件；未使用的位恒为 0，
+     * 因此两个局面相等当且仅当编码逐字节相等。字段布局见 StatePacker。
+     */
+    struct PackedState {
+        static constexpr int WORDS = 16;
+        std::array<std::uint64_t, WORDS> words{};
+
+        friend bool operator==(const PackedState& a, const PackedState& b) { return a.words == b.words; }
+        friend bool operator!=(const PackedState& a, const PackedState& b) { return !(a == b); }
+
+        /**
+         * @brief 两个编码之间不同的位数 (廉价的局面差异度量，0 表示局面相同)
+         */
+        int distance(const PackedState& other) const {
+            int bits = 0;
+            for (int i = 0; i < WORDS; ++i) bits += Bits::popcount64(words[i] ^ other.words[i]);
+            return bits;
+        }
+
+        /**
+         * @brief 编码内容的 64 位哈希 (用于以编码为键的哈希表；与 Zobrist 哈希无关)
+         */
+        std::uint64_t hash() const;
+    };
+
+    static_assert(sizeof(PackedState) == 128, "PackedState must stay 128 bytes");
+
+    struct DealState;
+
+    /**
+     * @brief GameController <-> PackedState 的无损转换
+     *
+     * 编码的字段 (从低位起)：
+     * - 控制器：GameState、时代、当前玩家、胜者、胜利类型、再次行动标记、待摧毁的颜色、轮抽计数
+     * - 金字塔：卡槽数、拿走 / 正面朝上掩码、每个未拿走卡槽的卡牌索引 (7 位，含背面朝上的真实牌面)
+     * - 每张卡牌 3 位位置码 (P0/P1 已建、P0/P1 奇迹下垫、弃牌堆，金字塔中与未入局的为 0)
+     * - 每座奇迹 3 位位置码 (待发、轮抽池、P0/P1 未建、P0/P1 已建)
+     * - 每枚科技标记 3 位位置码 (棋盘、盒中、P0、P1)
+     * - 双方金币、已领取的科技配对；军事位置与掠夺标记
+     *
+     * 资源产量、科技符号、连锁标记、交易优惠与分数都由已建卡牌 / 奇迹 / 标记推出，不单独存储。
+     * 已建卡牌、弃牌堆、奇迹与标记按集合编码，解码后按索引升序排列 (这些顺序不影响规则)；
+     * 奇迹与下垫卡牌按升序配对。不编码：玩家名称、日志、撤销历史与发牌随机流 (属于未来的发牌，
+     * 需要时由 captureDeal / restoreDeal 单独保存)，解码时保留目标控制器原有的值。
+     *
+     * 因此 unpack(pack(s)) 与 s 是同一局面 (Zobrist 哈希与合法动作集合相同)，
+     * pack(unpack(p)) == p。
+     */
+    class StatePacker {
+    public:
+        static constexpr int MAX_CARDS = 80;     // 卡牌位置码容量
+        static constexpr int MAX_WONDERS = 16;
+        static constexpr int MAX_TOKENS = 16;    // 按 ProgressToken 取值索引
+        static constexpr int MAX_COINS = 255;
+
+        /**
+         * @brief 编码 state 的当前局面
+         * @return 数据库或局面超出编码容量 (卡牌数、金币等) 时返回 false
+         */
+        static bool pack(const GameController& state, PackedState& out);
+
+        /**
+         * @brief 把编码的局面写入 state (state 需已用同一 CardDatabase 初始化)
+         * 覆盖全部对局状态并清空撤销历史。
+         * @return 编码内容与数据库不符时返回 false (此时 state 不被修改)
+         */
+        static bool unpack(const PackedState& packed, GameController& state);
+
+        /**
+         * @brief 记录 state 的随机流与奇迹顺序
+         * @return 奇迹数超出 DealState 容量时返回 false
+         */
+        static bool captureDeal(const GameController& state, DealState& out);
+
+        /**
+         * @brief 在 unpack 之后恢复 deal 记录的随机流与奇迹顺序
+         * @return deal 中的奇迹集合与 state 当前的待发 / 轮抽池不符时返回 false (此时 state 不被修改)
+         */
+        static bool restoreDeal(const DealState& deal, GameController& state);
+
+        /**
+         * @brief 实际使用的位数
+         */
+        static int usedBits();
+    };
+
+    /**
+     * @brief PackedState 不编码、但决定后续发展的部分
+     * 发牌 / 科技标记随机流与待发奇迹的顺序 (轮抽第二轮从中发牌)，以及轮抽池的显示顺序。
+     * 与 PackedState 一起保存即可把控制器恢复到可继续逐位重放的状态 (见 ReplaySeeker)。
+     */
+    struct DealState {
+        std::uint64_t gameSeed = 0;
+        Xoshiro256 deckRng;
+        Xoshiro256 tokenRng;
+        std::array<WonderIndex, StatePacker::MAX_WONDERS> remainingWonders{};   // 按 GameModel 中的顺序
+        std::array<WonderIndex, StatePacker::MAX_WONDERS> draftPool{};
+        std::uint8_t remainingCount = 0;
+        std::uint8_t draftCount = 0;
+    };
+
+}
+
+#endif // SEVEN_WONDERS_DUEL_PACKEDSTATE_H
@@ -3,14 +3,69 @@
 
 #include "Global.h"
 #include "Card.h"
+#include "CardDatabase.h"
+#include "Zobrist.h"
 #include <vector>
-#include <map>
-#include <set>
+#include <array>
+#include <cstdint>
 #include <string>
 #include <optional>
+#include <iterator>
+#include <type_traits>
 
 namespace SevenWondersDuel {
 
+    /**
+     * @brief 按索引存储、经数据库解析的只读区间
+     * Player 只保存 CardIndex / WonderIndex，遍历时再通过 CardDatabase 映射为指针。
+     */
+    template <typename T>
+    class IndexedRange {
+    public:
+        class Iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using difference_type   = std::ptrdiff_t;
+            using value_type        = const T*;
+            using pointer           = const T* const*;
+            using reference         = const T*;
+
+            Iterator(const std::uint8_t* pos, const CardDatabase* db) : m_pos(pos), m_db(db) {}
+
+            const T* operator*() const { return resolve(m_db, *m_pos); }
+            Iterator& operator++() { ++m_pos; return *this; }
+            Iterator operator++(int) { Iterator tmp = *this; ++m_pos; return tmp; }
+
+            friend bool operator==(const Iterator& a, const Iterator& b) { return a.m_pos == b.m_pos; }
+            friend bool operator!=(const Iterator& a, const Iterator& b) { return a.m_pos != b.m_pos; }
+
+        private:
+            const std::uint8_t* m_pos;
+            const CardDatabase* m_db;
+        };
+
+        IndexedRange(const std::uint8_t* first, int count, const CardDatabase* db)
+            : m_first(first), m_count(count), m_db(db) {}
+
+        Iterator begin() const { return Iterator(m_first, m_db); }
+        Iterator end() const { return Iterator(m_first + m_count, m_db); }
+        size_t size() const { return static_cast<size_t>(m_count); }
+        bool empty() const { return m_count == 0; }
+        const T* operator[](int i) const { return resolve(m_db, m_first[i]); }
+
+    private:
+        const std::uint8_t* m_first;
+        int m_count;
+        const CardDatabase* m_db;
+
+        static const T* resolve(const CardDatabase* db, std::uint8_t index) {
+            if constexpr (std::is_same_v<T, Wonder>) return db->getWonder(index);
+            else return db->getCard(index);
+        }
+    };
+
+    using WonderRange = IndexedRange<Wonder>;
+
     /**
      * @brief 玩家类
      * 维护玩家个人的所有游戏状态，包括：
@@ -19,76 +74,148 @@ namespace SevenWondersDuel {
      * - 资源产出能力 (Resource Production)
      * - 科技符号与进度标记
      * - 交易优惠状态
+     *
+     * 所有状态都存放在定长数组与位掩码中 (卡牌/奇迹以索引保存)，Player 是平凡可复制的，
+     * 克隆对局时可直接按字节拷贝。
      */
     class Player {
     private:
+        static constexpr int RESOURCE_KINDS = 5;
+        static constexpr int SCIENCE_KINDS = 8; // 含 NONE，按 ScienceSymbol 取值索引
+        static constexpr int CARD_TYPE_KINDS = 8; // 按 CardType 取值索引
+
         // 基础属性
+        const CardDatabase* m_database = nullptr; // 用于把索引解析为卡牌/奇迹
         int m_id; // 0 (先手/左侧) 或 1 (后手/右侧)
-        std::string m_name;
         int m_coins;
+        std::array<char, Config::MAX_PLAYER_NAME> m_name{};
 
-        // 持有的资产
-        std::vector<Card*> m_builtCards;        // 已建建筑
-        std::vector<Wonder*> m_builtWonders;    // 已建成的奇迹
-        std::vector<Wonder*> m_unbuiltWonders;  // 轮抽拿到但尚未建造的奇迹
+        // 持有的资产 (按获得顺序)
+        std::array<CardIndex, Config::MAX_BUILT_CARDS> m_builtCards{};                  // 已建建筑
+        std::array<WonderIndex, Config::MAX_WONDERS_PER_PLAYER> m_builtWonders{};       // 已建成的奇迹
+        std::array<CardIndex, Config::MAX_WONDERS_PER_PLAYER> m_wonderOverlays{};       // 与 m_builtWonders 一一对应：垫在奇迹下的卡牌
+        std::array<WonderIndex, Config::MAX_WONDERS_PER_PLAYER> m_unbuiltWonders{};     // 轮抽拿到但尚未建造的奇迹
+        std::uint8_t m_builtCardCount = 0;
+        std::uint8_t m_builtWonderCount = 0;
+        std::uint8_t m_unbuiltWonderCount = 0;
+
+        // 各颜色已建卡牌数，随 constructCard / removeCard 增量维护 (供公会与按颜色计金币效果 O(1) 查询)
+        std::array<std::uint8_t, CARD_TYPE_KINDS> m_cardTypeCounts{};
+
+        // --- 资源统计 (按 ResourceType 索引) ---
 
-        // --- 资源统计缓存 (用于 O(1) 查询) ---
-        
         // 玩家拥有的"固定"资源产量 (棕卡/灰卡)
-        std::map<ResourceType, int> m_fixedResources; 
-        
+        std::array<std::uint8_t, RESOURCE_KINDS> m_fixedResources{};
+
         // 玩家对对手可见的公开资源产量 (用于计算对手买资源的交易费)
         // 注意：某些卡牌只产资源但不增加此项 (如 Forum/Caravansery 这种多选一卡)
-        std::map<ResourceType, int> m_publicProduction; 
+        std::array<std::uint8_t, RESOURCE_KINDS> m_publicProduction{};
 
-        // "多选一"资源 (如：该卡每回合提供 1木 OR 1土)。
-        // 这种资源在购买判定时需要进行递归搜索以求最优解。
-        std::vector<std::vector<ResourceType>> m_choiceResources; 
+        // "多选一"资源，每项为可提供资源的位掩码 (第 ResourceType 位)。
+        // 这种资源在购买判定时需要搜索最优分配。
+        std::array<std::uint8_t, Config::MAX_CHOICE_PRODUCERS> m_choiceResources{};
+        std::uint8_t m_choiceCount = 0;
+
+        // 特殊Buff: 交易优惠 (第 ResourceType 位为 1 时，向银行购买该类资源固定 1 金币)
+        std::uint8_t m_tradingDiscounts = 0;
 
         // 科技
-        std::map<ScienceSymbol, int> m_scienceSymbols; // 拥有的符号计数
-        std::set<ScienceSymbol> m_claimedSciencePairs; // 记录已触发过"配对奖励"的符号，避免重复触发
+        std::array<std::uint8_t, SCIENCE_KINDS> m_scienceSymbols{}; // 拥有的符号计数
+        std::uint8_t m_claimedSciencePairs = 0; // 已触发过"配对奖励"的符号 (第 ScienceSymbol 位)
+
+        // 获得的绿色科技标记 (第 ProgressToken 位)
+        std::uint16_t m_progressTokens = 0;
+
+        // 连锁标记 (用于判定免费建造)，位由 CardDatabase 加载时分配
+        std::uint32_t m_ownedChainTags = 0;
 
-        // 连锁标记 (用于判定免费建造)
-        std::set<std::string> m_ownedChainTags; 
+        // 增量计分：卡牌/奇迹的静态分数、军事、金币与标记分数随状态修改同步维护；
+        // guild 一项只含紫卡的静态分数，动态部分见 m_guildScoreCache。
+        ScoreBreakdown m_score{};
 
-        // 获得的绿色科技标记
-        std::set<ProgressToken> m_progressTokens;
+        // 公会动态分数缓存：只依赖双方的颜色计数、奇迹数与金币档位，输入未变时直接复用。
+        // 缓存随 Player 一起按字节拷贝，每份副本各自维护 (不可跨线程共享同一 Player)。
+        using GuildScoreKey = std::array<std::uint8_t, 2 * (CARD_TYPE_KINDS + 2)>;
+        mutable GuildScoreKey m_guildScoreKey{};
+        mutable int m_guildScoreCache = 0;
+        mutable bool m_guildScoreValid = false;
 
-        // 特殊Buff: 交易优惠
-        // 对应黄色卡牌：若为 true，则向银行购买该类资源固定 1 金币
-        std::map<ResourceType, bool> m_tradingDiscounts; 
+        // 本玩家部分的 Zobrist 哈希 (金币、已建卡牌、奇迹、科技标记)，随修改接口增量维护
+        std::uint64_t m_hash = 0;
 
     public:
-        Player(int pid, std::string pname);
+        Player(int pid, const std::string& pname, const CardDatabase* database = nullptr);
 
         // --- Getters (属性查询) ---
         int getId() const { return m_id; }
-        const std::string& getName() const { return m_name; }
+        std::string getName() const { return std::string(m_name.data()); }
         int getCoins() const { return m_coins; }
 
-        const std::vector<Card*>& getBuiltCards() const { return m_builtCards; }
-        const std::vector<Wonder*>& getBuiltWonders() const { return m_builtWonders; }
-        const std::vector<Wonder*>& getUnbuiltWonders() const { return m_unbuiltWonders; }
+        WonderRange getBuiltWonders() const { return WonderRange(m_builtWonders.data(), m_builtWonderCount, m_database); }
+        WonderRange getUnbuiltWonders() const { return WonderRange(m_unbuiltWonders.data(), m_unbuiltWonderCount, m_database); }
+        int getBuiltCardCount() const { return m_builtCardCount; }
+        int getBuiltWonderCount() const { return m_builtWonderCount; }
 
-        const std::map<ResourceType, int>& getFixedResources() const { return m_fixedResources; }
-        const std::map<ResourceType, int>& getPublicProduction() const { return m_publicProduction; }
-        const std::vector<std::vector<ResourceType>>& getChoiceResources() const { return m_choiceResources; }
+        /**
+         * @brief 第 i 座已建成奇迹下垫着的卡牌
+         */
+        const Card* getWonderOverlay(int i) const { return m_database->getCard(m_wonderOverlays[i]); }
 
-        const std::map<ScienceSymbol, int>& getScienceSymbols() const { return m_scienceSymbols; }
-        const std::set<ScienceSymbol>& getClaimedSciencePairs() const { return m_claimedSciencePairs; }
-        
-        const std::set<std::string>& getOwnedChainTags() const { return m_ownedChainTags; }
-        const std::set<ProgressToken>& getProgressTokens() const { return m_progressTokens; }
-        const std::map<ResourceType, bool>& getTradingDiscounts() const { return m_tradingDiscounts; }
+        /**
+         * @brief 该玩家是否已建成指定奇迹
+         * 奇迹的建造状态属于对局数据，由玩家持有，而非共享的 Wonder 对象。
+         */
+        bool hasBuiltWonder(const Wonder* w) const;
+
+        int getFixedResource(ResourceType type) const { return m_fixedResources[static_cast<int>(type)]; }
+        int getPublicProduction(ResourceType type) const { return m_publicProduction[static_cast<int>(type)]; }
+        bool hasTradingDiscount(ResourceType type) const { return (m_tradingDiscounts >> static_cast<int>(type)) & 1u; }
+
+        int getChoiceResourceCount() const { return m_choiceCount; }
+        /** @brief 第 i 个"多选一"产出可提供的资源 (第 ResourceType 位) */
+        std::uint8_t getChoiceResourceMask(int i) const { return m_choiceResources[i]; }
+
+        int getScienceSymbolCount(ScienceSymbol s) const { return m_scienceSymbols[static_cast<int>(s)]; }
+        bool hasClaimedSciencePair(ScienceSymbol s) const { return (m_claimedSciencePairs >> static_cast<int>(s)) & 1u; }
+        std::uint8_t getClaimedSciencePairMask() const { return m_claimedSciencePairs; }
+
+        /**
+         * @brief 拥有的不同科技符号种类数 (不含 NONE)
+         */
+        int getDistinctScienceSymbolCount() const;
+
+        bool hasProgressToken(ProgressToken token) const { return (m_progressTokens >> static_cast<int>(token)) & 1u; }
+        int getProgressTokenCount() const { return Bits::popcount(m_progressTokens); }
+        std::uint16_t getProgressTokenMask() const { return m_progressTokens; }
+
+        /**
+         * @brief 是否持有建造该卡所需的连锁标记
+         */
+        bool hasChainFor(const Card* card) const { return (card->getRequiresChainBit() & m_ownedChainTags) != 0; }
+        std::uint32_t getOwnedChainTagMask() const { return m_ownedChainTags; }
 
         // --- 状态辅助查询 ---
 
         /**
-         * @brief 获取已建造的某颜色卡牌数量
+         * @brief 获取已建造的某颜色卡牌数量 (O(1)，读取增量计数)
          * 常用于公会卡或黄色卡牌的按颜色计分。
          */
-        int getCardCount(CardType type) const;
+        int getCardCount(CardType type) const { return m_cardTypeCounts[static_cast<int>(type)]; }
+
+        // --- 计分 (增量维护) ---
+
+        /**
+         * @brief 当前分项得分
+         * 除公会动态分数外均为直接读取；公会分数仅在其输入计数变化后重新计算。
+         * ScoringManager::calculateBreakdown 为逐项遍历的参考实现，调试构建下两者在每步动作后比对。
+         */
+        ScoreBreakdown getScoreBreakdown(const Player& opponent) const;
+        int getScore(const Player& opponent) const { return getScoreBreakdown(opponent).total(); }
+
+        /**
+         * @brief 本玩家部分的 Zobrist 哈希 (见 Zobrist)，由 GameModel::getHash 汇总
+         */
+        std::uint64_t getHash() const { return m_hash; }
 
         // --- 资源与购买逻辑核心 ---
 
@@ -112,19 +239,34 @@ namespace SevenWondersDuel {
 
         void payCoins(int amount);
         void gainCoins(int amount);
+
+        /**
+         * @brief 直接设置金币数 (撤销动作时恢复)
+         */
+        void setCoins(int coins);
         
+        /**
+         * @brief 更新军事分数 (由控制器在冲突标记移动后写入)
+         */
+        void setMilitaryVictoryPoints(int points) { m_score.military = points; }
+
         void setTradingDiscount(ResourceType r, bool active);
         void addClaimedSciencePair(ScienceSymbol s);
+        void setClaimedSciencePairMask(std::uint8_t mask) { m_claimedSciencePairs = mask; }
 
         /**
          * @brief 增加资源产量
          * @param isTradable 是否增加对手可见的产量 (影响对手交易费)
          */
         void addResource(ResourceType type, int count, bool isTradable);
+        void removeResource(ResourceType type, int count, bool isTradable);
         
         void addProductionChoice(const std::vector<ResourceType>& choices);
+        /** @brief 按资源位掩码 (第 r 位对应 ResourceType r) 增加 / 移除一项多选一产能 */
+        void addProductionChoice(std::uint8_t mask);
+        void removeProductionChoice(std::uint8_t mask);
         void addScienceSymbol(ScienceSymbol s);
-        void addChainTag(const std::string& tag);
+        void removeScienceSymbol(ScienceSymbol s);
         
         /**
          * @brief 获得科技标记
@@ -132,42 +274,70 @@ namespace SevenWondersDuel {
          */
         void addProgressToken(ProgressToken token);
 
+        /**
+         * @brief 交还科技标记 (addProgressToken 的逆操作，撤销动作时使用)
+         */
+        void removeProgressToken(ProgressToken token);
+
         // --- 建造与管理 ---
 
-        void constructCard(Card* card);
+        void constructCard(const Card* card) { insertCard(card, m_builtCardCount); }
+
+        /**
+         * @brief 把卡牌放回已建卡牌列表的指定位置 (撤销摧毁时恢复原有顺序)
+         * 与 constructCard 一样只更新列表、颜色计数、连锁标记、分数与哈希，不应用卡牌效果。
+         */
+        void insertCard(const Card* card, int position);
+
+        /**
+         * @brief 已建卡牌在建造顺序中的位置，未建造时返回 -1
+         */
+        int findBuiltCard(CardIndex card) const;
 
         /**
-         * @brief 移除已建造的卡牌 (用于被对手摧毁)
-         * @return 被移除的卡牌指针，若无对应颜色卡牌则返回 nullptr
+         * @brief 移除指定的已建卡牌 (用于被对手摧毁)
+         * 只更新卡牌列表、颜色计数、连锁标记、分数与哈希；卡牌效果的持续状态由调用方撤销 (见 Board::destroyCard)。
+         * @return 被移除的卡牌指针，若未建造该卡则返回 nullptr
          */
-        Card* removeCardByType(CardType type);
+        const Card* removeCard(CardIndex card);
 
         // 奇迹管理
-        void addUnbuiltWonder(Wonder* w);
-        void removeUnbuiltWonder(const std::string& wonderId);
+        void addUnbuiltWonder(const Wonder* w);
+        void removeUnbuiltWonder(WonderIndex wonder);
         void clearUnbuiltWonders();
         
         /**
          * @brief 建造手中的奇迹
          * @param overlayCard 用于垫在奇迹下的卡牌 (通常是刚从金字塔拿的)
          */
-        void constructWonder(std::string wonderId, Card* overlayCard);
+        void constructWonder(WonderIndex wonder, const Card* overlayCard);
+
+        /**
+         * @brief constructWonder 的逆操作：拆下奇迹与垫在下面的卡牌，放回手中第 position 位
+         * 不撤销奇迹效果 (由调用方负责)。
+         */
+        void unconstructWonder(WonderIndex wonder, int position);
+
+        /**
+         * @brief 手中未建奇迹的位置，不在手中时返回 -1
+         */
+        int findUnbuiltWonder(WonderIndex wonder) const;
 
         // --- 迭代器实现 (方便遍历特定颜色的已建卡牌) ---
         class BuiltCardIterator {
         public:
             using iterator_category = std::forward_iterator_tag;
             using difference_type   = std::ptrdiff_t;
-            using value_type        = Card*;
-            using pointer           = Card**;
-            using reference         = Card*&;
+            using value_type        = const Card*;
+            using pointer           = const Card* const*;
+            using reference         = const Card*;
 
-            BuiltCardIterator(const std::vector<Card*>* cards, int index, std::optional<CardType> filter)
-                : m_cards(cards), m_index(index), m_filter(filter) {
+            BuiltCardIterator(const Player* owner, int index, std::optional<CardType> filter)
+                : m_owner(owner), m_index(index), m_filter(filter) {
                 advanceToNextValid();
             }
 
-            Card* operator*() const { return (*m_cards)[m_index]; }
+            const Card* operator*() const { return m_owner->builtCardAt(m_index); }
             
             BuiltCardIterator& operator++() {
                 m_index++;
@@ -182,7 +352,7 @@ namespace SevenWondersDuel {
             }
 
             friend bool operator==(const BuiltCardIterator& a, const BuiltCardIterator& b) {
-                return a.m_index == b.m_index && a.m_cards == b.m_cards;
+                return a.m_index == b.m_index && a.m_owner == b.m_owner;
             }
 
             friend bool operator!=(const BuiltCardIterator& a, const BuiltCardIterator& b) {
@@ -190,14 +360,14 @@ namespace SevenWondersDuel {
             }
 
         private:
-            const std::vector<Card*>* m_cards;
+            const Player* m_owner;
             int m_index;
             std::optional<CardType> m_filter;
 
             void advanceToNextValid() {
-                while (m_index < (int)m_cards->size()) {
+                while (m_index < m_owner->m_builtCardCount) {
                     if (!m_filter.has_value()) break; // No filter, current is valid
-                    if ((*m_cards)[m_index]->getType() == m_filter.value()) break; // Match
+                    if (m_owner->builtCardAt(m_index)->getType() == m_filter.value()) break; // Match
                     m_index++;
                 }
             }
@@ -211,7 +381,18 @@ namespace SevenWondersDuel {
         };
 
         CardRange getCardsByType(CardType type) const;
+
+        /**
+         * @brief 全部已建卡牌 (按建造顺序)
+         */
         CardRange getAllCards() const;
+
+    private:
+        const Card* builtCardAt(int i) const { return m_database->getCard(m_builtCards[i]); }
+
+        void updateCoinScore() { m_score.coins = m_coins / Config::COINS_PER_VP; }
+        void updateTokenScore();
+        int guildDynamicScore(const Player& opponent) const;
     };
 }
 
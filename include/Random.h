@@ -0,0 +1,94 @@
+#ifndef SEVEN_WONDERS_DUEL_RANDOM_H
+#define SEVEN_WONDERS_DUEL_RANDOM_H
+
+#include <cstdint>
+#include <limits>
+
+namespace SevenWondersDuel {
+
+    /**
+     * @brief xoshiro256** 伪随机数生成器
+     * 满足 UniformRandomBitGenerator 要求，可直接用于 std::shuffle / std::uniform_int_distribution。
+     * 状态仅 32 字节，支持 jump() 跳过 2^128 步以派生互不重叠的子序列。
+     */
+    class Xoshiro256 {
+    public:
+        using result_type = std::uint64_t;
+
+        /**
+         * @param seed 任意 64 位种子，内部经 SplitMix64 扩展为 256 位状态
+         */
+        explicit Xoshiro256(std::uint64_t seed = 0);
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+        result_type operator()() {
+            const std::uint64_t result = rotl(m_s[1] * 5, 7) * 9;
+            const std::uint64_t t = m_s[1] << 17;
+            m_s[2] ^= m_s[0];
+            m_s[3] ^= m_s[1];
+            m_s[1] ^= m_s[2];
+            m_s[0] ^= m_s[3];
+            m_s[2] ^= t;
+            m_s[3] = rotl(m_s[3], 45);
+            return result;
+        }
+
+        /**
+         * @brief 前跳 2^128 步
+         * 每次调用得到一条与之前不重叠的独立随机流。
+         */
+        void jump();
+
+    private:
+        std::uint64_t m_s[4];
+
+        static std::uint64_t rotl(std::uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+    };
+
+    /**
+     * @brief SplitMix64 混合函数
+     * 用于把 (种子, 序号) 之类的输入打散为高质量的 64 位种子。
+     */
+    std::uint64_t splitMix64(std::uint64_t& state);
+
+    /**
+     * @brief 单局游戏内的独立随机流编号
+     * 每条流由同一个对局种子前跳 N 次 (N = 枚举值) 得到，彼此互不重叠。
+     */
+    enum class RngStream {
+        DECK,       // 奇迹轮抽与各时代卡牌发放
+        TOKENS,     // 科技标记的初始布置
+        AGENT_1,    // 玩家1 代理的决策随机性
+        AGENT_2     // 玩家2 代理的决策随机性
+    };
+
+    /**
+     * @brief 种子层级
+     * masterSeed --(gameIndex)--> gameSeed --(jump)--> 各随机流。
+     * 批量对局中的任意一局都可以仅凭 (masterSeed, gameIndex) 完整复现。
+     */
+    class SeedHierarchy {
+    public:
+        /**
+         * @brief 由主种子与对局序号派生对局种子
+         */
+        static std::uint64_t gameSeed(std::uint64_t masterSeed, std::uint64_t gameIndex);
+
+        /**
+         * @brief 由对局种子派生指定用途的随机流
+         */
+        static Xoshiro256 stream(std::uint64_t gameSeed, RngStream which);
+
+        /**
+         * @brief 玩家序号 (0/1) 对应的代理随机流编号
+         */
+        static RngStream agentStream(int playerIndex) {
+            return playerIndex == 0 ? RngStream::AGENT_1 : RngStream::AGENT_2;
+        }
+    };
+
+}
+
+#endif // SEVEN_WONDERS_DUEL_RANDOM_H
@@ -0,0 +1,278 @@
+#ifndef SEVEN_WONDERS_DUEL_REPLAY_H
+#define SEVEN_WONDERS_DUEL_REPLAY_H
+
+#include "Global.h"
+#include "GameController.h"
+#include "PackedState.h"
+#include <cstdint>
+#include <iosfwd>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace SevenWondersDuel {
+
+    class CardDatabase;
+    class CorpusReader;
+
+    /**
+     * @brief 编码后的动作 (2 字节)
+     * 高 4 位为 ActionType，低 12 位按类型存放目标：卡牌 7 位 + 奇迹 4 位 + 标志 1 位，
+     * 科技标记占用卡牌字段。
+     */
+    using ActionCode = std::uint16_t;
+
+    class ActionCodec {
+    public:
+        /**
+         * @return 索引超出编码范围时返回 false
+         */
+        static bool encode(const Action& action, ActionCode& out);
+        static bool decode(ActionCode code, Action& out);
+    };
+
+    /**
+     * @brief 一局对弈的二进制记录
+     * 对局完全由 (masterSeed, gameIndex) 派生的种子与动作序列决定，重放不需要代理本身。
+     */
+    struct GameRecord {
+        std::uint64_t masterSeed = 0;
+        std::uint64_t gameIndex = 0;
+        std::string agent1;                          // 代理标识 (AgentFactory 名称，最长 255 字节)
+        std::string agent2;
+        int winnerIndex = -1;                        // 记录时的结果，便于不重放即可筛选
+        VictoryType victoryType = VictoryType::NONE;
+        bool aborted = false;
+        std::vector<ActionCode> actions;
+
+        std::uint64_t gameSeed() const;
+    };
+
+    /**
+     * @brief 指向已编码记录的零拷贝视图 (例如内存映射的语料库)
+     * 名称与动作直接引用底层字节，视图的有效期不超过底层缓冲区。
+     */
+    struct GameRecordView {
+        std::uint64_t masterSeed = 0;
+        std::uint64_t gameIndex = 0;
+        std::string_view agent1;
+        std::string_view agent2;
+        int winnerIndex = -1;
+        VictoryType victoryType = VictoryType::NONE;
+        bool aborted = false;
+        const std::uint8_t* actionBytes = nullptr;   // 每个动作 2 字节 (小端)
+        size_t actionCount = 0;
+
+        ActionCode action(size_t i) const {
+            return static_cast<ActionCode>(actionBytes[2 * i] | (actionBytes[2 * i + 1] << 8));
+        }
+        std::uint64_t gameSeed() const;
+        GameRecord toRecord() const;
+    };
+
+    /**
+     * @brief 记录文件格式 (小端)
+     *
+     * 文件头 8 字节：魔数 "7WDR"、u16 版本、u16 保留。
+     * 之后是连续的记录：u32 动作数、u64 主种子、u64 对局序号、u8 结果
+     * (胜者 + 1 | 胜利类型 << 2 | 中止 << 4)、两个 (u8 长度 + 字节) 的代理标识、每个动作 u16。
+     * 一局通常 70 ~ 80 个动作，约 180 字节。
+     */
+    class ReplayFormat {
+    public:
+        static constexpr char MAGIC[4] = {'7', 'W', 'D', 'R'};
+        static constexpr std::uint16_t VERSION = 1;
+        static constexpr size_t FILE_HEADER_BYTES = 8;
+        static constexpr size_t MAX_AGENT_NAME = 255;
+
+        static void appendFileHeader(std::vector<std::uint8_t>& out);
+        static bool checkFileHeader(const std::uint8_t* data, size_t size);
+
+        /**
+         * @brief 把一条记录追加到 out 末尾
+         */
+        static void appendRecord(const GameRecord& record, std::vector<std::uint8_t>& out);
+
+        /**
+         * @brief 从 data 解析一条记录
+         * @return 消耗的字节数；数据不完整时返回 0
+         */
+        static size_t parseRecord(const std::uint8_t* data, size_t size, GameRecord& out);
+        static size_t parseRecord(const std::uint8_t* data, size_t size, GameRecordView& out);
+    };
+
+    /**
+     * @brief 顺序写出记录文件
+     */
+    class ReplayWriter {
+    public:
+        explicit ReplayWriter(std::ostream& out);
+
+        bool write(const GameRecord& record);
+
+        /**
+         * @brief 直接写出已按 appendRecord 编码好的字节 (多线程各自编码后批量写入)
+         */
+        bool writeEncoded(const std::vector<std::uint8_t>& bytes);
+
+        bool good() const;
+
+    private:
+        std::ostream& m_out;
+        std::vector<std::uint8_t> m_buffer;
+    };
+
+    /**
+     * @brief 顺序读取记录文件
+     */
+    class ReplayReader {
+    public:
+        explicit ReplayReader(std::istream& in);
+
+        /**
+         * @brief 文件头是否有效
+         */
+        bool isValid() const { return m_valid; }
+
+        /**
+         * @brief 读取下一条记录；文件结束或数据损坏时返回 false
+         */
+        bool next(GameRecord& out);
+
+    private:
+        std::istream& m_in;
+        bool m_valid = false;
+        std::vector<std::uint8_t> m_buffer;
+    };
+
+    /**
+     * @brief 重放引擎
+     * 复用同一个控制器，按记录的种子初始化后逐个 processAction 重新执行动作；默认关闭日志与撤销，
+     * 全速运行。重放的局面与记录时逐位相同 (发牌与科技标记都来自种子派生的随机流)。
+     */
+    class ReplayEngine {
+    public:
+        static constexpr size_t ALL = std::numeric_limits<size_t>::max();
+
+        /**
+         * @param keepLog 是否保留游戏日志 (查看单局时打开)
+         */
+        explicit ReplayEngine(std::shared_ptr<const CardDatabase> database, bool keepLog = false);
+
+        /**
+         * @brief 以 gameSeed 开始新的一局 (已完成 initializeGame + startGame，位于第 0 个动作之前)
+         */
+        void start(std::uint64_t gameSeed, const std::string& p1Name = "Player 1", const std::string& p2Name = "Player 2");
+
+        /**
+         * @brief 执行下一个动作
+         * @return 编码无效或动作不合法时返回 false (局面保持不变)
+         */
+        bool apply(ActionCode code);
+
+        /**
+         * @brief 从头重放 record 的前 count 个动作
+         * @return 全部动作均合法执行时返回 true
+         */
+        bool replay(const GameRecord& record, size_t count = ALL);
+        bool replay(const GameRecordView& record, size_t count = ALL);
+
+        /**
+         * @brief 当前局面下已执行的动作数
+         */
+        size_t getPosition() const { return m_position; }
+
+        const GameController& getGame() const { return m_game; }
+
+    private:
+        friend class ReplaySeeker;
+
+        std::shared_ptr<const CardDatabase> m_database;
+        GameController m_game;
+        size_t m_position = 0;
+    };
+
+
+    /**
+     * @brief 支持任意跳转的单局重放
+     * 载入记录时完整重放一遍，每 interval 个动作保存一个快照 (PackedState + DealState，约 200 字节)。
+     * seek(n) 解码不超过 n 的最近快照，再重新执行至多 interval - 1 个动作，
+     * 因此无论向前还是向后跳转，代价都与局面在对局中的位置无关。
+     * 开启日志时同时记录每个位置的日志长度，跳转后游戏日志与从头重放时一致。
+     */
+    class ReplaySeeker {
+    public:
+        static constexpr size_t DEFAULT_INTERVAL = 8;
+        static constexpr size_t NO_GAME = std::numeric_limits<size_t>::max();
+
+        /**
+         * @param interval 快照间隔 (动作数，至少为 1)
+         * @param keepLog 是否保留游戏日志 (交互查看时打开)
+         */
+        explicit ReplaySeeker(std::shared_ptr<const CardDatabase> database, size_t interval = DEFAULT_INTERVAL, bool keepLog = false);
+
+        /**
+         * @brief 载入一局记录并建立快照，结束后位于终局 (getActionCount() 处)
+         * @return 全部动作均合法执行时返回 true；否则只保留能重放的前缀
+         */
+        bool load(const GameRecord& record);
+        bool load(const GameRecordView& record);
+
+        /**
+         * @brief 跳转到执行完前 actionIndex 个动作后的局面
+         * @return actionIndex 超过 getActionCount() 时返回 false (局面保持不变)
+         */
+        bool seek(size_t actionIndex);
+
+        /**
+         * @brief 跳转到语料库第 gameId 局的 actionIndex 处 (与当前载入的不是同一局时先载入)
+         */
+        bool seek(const CorpusReader& corpus, size_t gameId, size_t actionIndex);
+
+        /**
+         * @brief 当前局面下已执行的动作数
+         */
+        size_t getPosition() const { return m_engine.getPosition(); }
+
+        /**
+         * @brief 可到达的动作数 (记录的动作数，或重放失败前的合法前缀长度)
+         */
+        size_t getActionCount() const { return m_actions.size(); }
+        size_t getSnapshotCount() const { return m_snapshots.size(); }
+        size_t getInterval() const { return m_interval; }
+
+        /**
+         * @brief 上一次 seek 重新执行的动作数 (不超过 interval - 1)
+         */
+        size_t getLastReplayed() const { return m_lastReplayed; }
+
+        const GameRecord& getRecord() const { return m_record; }
+        const GameController& getGame() const { return m_engine.getGame(); }
+
+    private:
+        struct Snapshot {
+            PackedState state;
+            DealState deal;
+            size_t logSize = 0;
+        };
+
+        bool build();
+        bool takeSnapshot();
+
+        ReplayEngine m_engine;
+        size_t m_interval;
+        bool m_keepLog;
+        GameRecord m_record;
+        std::vector<ActionCode> m_actions;    // 可重放的动作前缀
+        std::vector<Snapshot> m_snapshots;    // 第 i 个位于 i * interval 处
+        std::vector<std::string> m_fullLog;   // 终局时的完整日志
+        const CorpusReader* m_corpus = nullptr;
+        size_t m_gameId = NO_GAME;
+        size_t m_lastReplayed = 0;
+    };
+
+}
+
+#endif // SEVEN_WONDERS_DUEL_REPLAY_H
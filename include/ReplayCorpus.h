@@ -0,0 +1,131 @@
+#ifndef SEVEN_WONDERS_DUEL_REPLAYCORPUS_H
+#define SEVEN_WONDERS_DUEL_REPLAYCORPUS_H
+
+#include "Replay.h"
+#include "MappedFile.h"
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace SevenWondersDuel {
+
+    /**
+     * @brief 带索引的对局语料库文件 (小端)
+     *
+     * - 文件头 32 字节：魔数 "7WDC"、u16 版本、u16 保留、u32 保留、u64 对局数、u64 索引偏移、u64 保留
+     * - 记录区：从第 32 字节起连续存放记录，编码与 ReplayFormat 相同
+     * - 索引：文件末尾每局一个 u64 (记录相对文件开头的偏移)，按写入顺序排列
+     *
+     * 索引与文件头在 CorpusWriter::close() 时写入；未正常关闭的文件 (对局数为 0) 由 CorpusReader
+     * 顺序扫描记录区恢复。
+     */
+    class CorpusFormat {
+    public:
+        static constexpr char MAGIC[4] = {'7', 'W', 'D', 'C'};
+        static constexpr std::uint16_t VERSION = 1;
+        static constexpr size_t HEADER_BYTES = 32;
+    };
+
+    /**
+     * @brief 多线程追加写入的语料库
+     * 每个模拟线程持有一个 Buffer，在本地编码记录，攒够 flushBytes 后才加锁把整块字节与偏移
+     * 追加到文件，锁内只有一次写入与索引拼接。
+     */
+    class CorpusWriter {
+    public:
+        static constexpr size_t DEFAULT_FLUSH_BYTES = 1 << 20;
+
+        /**
+         * @brief 线程本地的追加缓冲 (不可跨线程共享)，析构时自动 flush
+         */
+        class Buffer {
+        public:
+            explicit Buffer(CorpusWriter& writer, size_t flushBytes = DEFAULT_FLUSH_BYTES);
+            ~Buffer();
+
+            Buffer(const Buffer&) = delete;
+            Buffer& operator=(const Buffer&) = delete;
+
+            void append(const GameRecord& record);
+            void flush();
+
+        private:
+            CorpusWriter& m_writer;
+            size_t m_flushBytes;
+            std::vector<std::uint8_t> m_bytes;
+            std::vector<std::uint64_t> m_offsets;   // 相对 m_bytes 开头
+        };
+
+        /**
+         * @brief 创建 (截断) 语料库文件
+         */
+        explicit CorpusWriter(const std::string& path);
+        ~CorpusWriter();
+
+        CorpusWriter(const CorpusWriter&) = delete;
+        CorpusWriter& operator=(const CorpusWriter&) = delete;
+
+        bool isOpen() const { return m_open; }
+
+        /**
+         * @brief 写出索引与文件头并关闭文件 (所有 Buffer 须已 flush 或析构)
+         * @return 期间任何写入失败时返回 false
+         */
+        bool close();
+
+        std::uint64_t getGameCount() const;
+
+    private:
+        void commit(const std::vector<std::uint8_t>& bytes, const std::vector<std::uint64_t>& offsets);
+
+        mutable std::mutex m_mutex;
+        std::ofstream m_out;
+        std::uint64_t m_end = CorpusFormat::HEADER_BYTES;
+        std::vector<std::uint64_t> m_index;
+        bool m_open = false;
+        bool m_failed = false;
+    };
+
+    /**
+     * @brief 内存映射的只读语料库
+     * 按索引 O(1) 定位第 N 局，返回直接指向映射内存的 GameRecordView (不拷贝、不解析动作)。
+     * 打开后可被多个线程并发读取。
+     */
+    class CorpusReader {
+    public:
+        /**
+         * @return 文件不存在、格式不符或记录区损坏时返回 false
+         */
+        bool open(const std::string& path);
+        void close();
+
+        size_t getGameCount() const { return m_count; }
+
+        /**
+         * @brief 第 n 局 (按写入顺序) 的零拷贝视图
+         */
+        bool getGame(size_t n, GameRecordView& out) const;
+
+        /**
+         * @brief 索引是否来自文件本身 (false 表示文件未正常关闭，索引由扫描恢复)
+         */
+        bool hasStoredIndex() const { return m_storedIndex; }
+
+        size_t getFileSize() const { return m_file.size(); }
+
+    private:
+        MappedFile m_file;
+        const std::uint8_t* m_index = nullptr;           // 文件内的索引
+        std::vector<std::uint64_t> m_recoveredIndex;      // 扫描恢复的索引
+        size_t m_count = 0;
+        size_t m_recordsEnd = 0;
+        bool m_storedIndex = false;
+
+        std::uint64_t offsetOf(size_t n) const;
+    };
+
+}
+
+#endif // SEVEN_WONDERS_DUEL_REPLAYCORPUS_H
@@ -11,6 +11,13 @@ namespace SevenWondersDuel {
      */
     class ScoringManager {
     public:
+        /**
+         * @brief 逐项遍历计算分项得分
+         * 这是计分规则的参考实现；对局中应读取 Player::getScoreBreakdown 的增量结果，
+         * 调试构建下控制器会在每步动作后比对两者。
+         */
+        static ScoreBreakdown calculateBreakdown(const Player& player, const Player& opponent, const Board& board);
+
         /**
          * @brief 计算玩家总分
          * 包含：卡牌分数 (含行会)、奇迹分数、军事分数、金币分数 (3:1)、科技标记分数。
@@ -0,0 +1,99 @@
+#ifndef SEVEN_WONDERS_DUEL_SELFPLAY_H
+#define SEVEN_WONDERS_DUEL_SELFPLAY_H
+
+#include "Global.h"
+#include "Replay.h"
+#include <string>
+#include <memory>
+#include <cstdint>
+#include <vector>
+
+namespace SevenWondersDuel {
+
+    class GameController;
+    class IPlayerAgent;
+    class CardDatabase;
+    class CorpusWriter;
+
+    /**
+     * @brief 批量自对弈配置
+     */
+    struct SelfPlayConfig {
+        int games = 1000;                              // 对局总数
+        std::uint64_t masterSeed = 1;                  // 主种子 (第 i 局种子 = SeedHierarchy::gameSeed(masterSeed, i))
+        std::uint64_t firstGameIndex = 0;              // 起始对局序号 (用于单独复现批量中的某一局)
+        std::string agent1 = "random";                 // 玩家1 AI 名称
+        std::string agent2 = "greedy";                 // 玩家2 AI 名称
+        int threads = 1;                               // 工作线程数
+        std::string dataPath = "../data/gamedata.json";
+        int maxActionsPerGame = 1000;                  // 单局动作上限 (防止死循环)
+        std::string recordPath;                        // 非空时把每局的二进制记录写入该语料库文件 (见 CorpusFormat)
+    };
+
+    /**
+     * @brief 单局对弈结果
+     */
+    struct GameOutcome {
+        int winnerIndex = -1;                      // -1: 平局或中止
+        VictoryType victoryType = VictoryType::NONE;
+        int actions = 0;                           // 成功执行的动作数
+        bool aborted = false;                      // AI 给出非法动作或超过动作上限
+    };
+
+    /**
+     * @brief 批量对弈统计
+     * 每个线程独立累计，结束后合并。
+     */
+    struct SelfPlayStats {
+        long long games = 0;
+        long long actions = 0;
+        long long wins[2] = {0, 0};
+        long long draws = 0;
+        long long aborted = 0;
+        long long victoryTypes[4] = {0, 0, 0, 0}; // 按 VictoryType 索引
+        double seconds = 0.0;
+
+        void record(const GameOutcome& outcome);
+        void merge(const SelfPlayStats& other);
+
+        double gamesPerSecond() const;
+        double actionsPerSecond() const;
+    };
+
+    /**
+     * @brief 无界面批量自对弈驱动器
+     * 直接在紧凑循环中调用 GameController::processAction，
+     * 不渲染、不等待、不做任何控制台输入输出。
+     */
+    class SelfPlayRunner {
+    public:
+        explicit SelfPlayRunner(SelfPlayConfig config);
+
+        /**
+         * @brief 执行全部对局
+         * 卡牌数据库只加载一次并由所有线程共享；每个线程复用同一个 GameController。
+         * 对局按序号交错分配给各工作线程，统计在所有线程结束后合并。
+         */
+        SelfPlayStats run();
+
+        /**
+         * @brief 在已初始化的控制器上跑完一整局
+         * @param game 已调用过 initializeGame 的控制器
+         * @param agent1 玩家1 代理
+         * @param agent2 玩家2 代理
+         * @param maxActions 动作上限
+         * @param actions 非空时追加每个成功执行的动作的编码
+         */
+        static GameOutcome playGame(GameController& game, IPlayerAgent& agent1, IPlayerAgent& agent2, int maxActions,
+                                    std::vector<ActionCode>* actions = nullptr);
+
+    private:
+        SelfPlayConfig m_config;
+
+        void runWorker(const std::shared_ptr<const CardDatabase>& database, int workerIndex, int workerCount, SelfPlayStats& stats,
+                       CorpusWriter* corpus) const;
+    };
+
+}
+
+#endif // SEVEN_WONDERS_DUEL_SELFPLAY_H
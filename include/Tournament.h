@@ -0,0 +1,116 @@
+#ifndef SEVEN_WONDERS_DUEL_TOURNAMENT_H
+#define SEVEN_WONDERS_DUEL_TOURNAMENT_H
+
+#include "Global.h"
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <utility>
+#include <cstdint>
+
+namespace SevenWondersDuel {
+
+    class IPlayerAgent;
+    class CardDatabase;
+
+    /**
+     * @brief 参赛者
+     * 工厂在每个工作线程中各调用一次，因此代理实例无需线程安全。
+     */
+    struct TournamentEntrant {
+        std::string name;
+        std::function<std::unique_ptr<IPlayerAgent>()> factory;
+    };
+
+    /**
+     * @brief 对阵编排方式
+     */
+    enum class PairingMode {
+        ROUND_ROBIN, // 所有参赛者两两对阵
+        GAUNTLET     // 第一个参赛者依次挑战其余所有人
+    };
+
+    /**
+     * @brief 锦标赛配置
+     */
+    struct TournamentConfig {
+        PairingMode mode = PairingMode::ROUND_ROBIN;
+        int gamesPerPairing = 1000;                    // 每组对阵的局数 (双方轮流先手)
+        std::uint64_t masterSeed = 1;
+        int threads = 1;
+        int chunkSize = 16;                            // 单个任务包含的对局数 (窃取粒度)
+        std::string dataPath = "../data/gamedata.json";
+        int maxActionsPerGame = 1000;
+    };
+
+    /**
+     * @brief 单组对阵结果 (始终从 entrantA 的视角统计，与座次无关)
+     */
+    struct PairingResult {
+        int entrantA = 0;
+        int entrantB = 0;
+        long long games = 0;
+        long long winsA = 0;
+        long long winsB = 0;
+        long long draws = 0;
+        long long aborted = 0;
+        long long actions = 0;
+
+        void merge(const PairingResult& other);
+
+        /**
+         * @brief A 的得分率 (胜 1 分，平 0.5 分，中止局不计)
+         */
+        double scoreA() const;
+
+        /**
+         * @brief A 得分率的 Wilson 置信区间
+         * @param z 正态分位数 (1.96 对应 95%)
+         */
+        std::pair<double, double> confidenceInterval(double z = 1.96) const;
+    };
+
+    /**
+     * @brief 锦标赛汇总
+     */
+    struct TournamentReport {
+        std::vector<std::string> entrantNames;
+        std::vector<PairingResult> pairings;
+        long long games = 0;
+        long long actions = 0;
+        long long steals = 0;       // 工作窃取成功次数
+        int threads = 0;
+        double seconds = 0.0;
+
+        double gamesPerSecond() const;
+    };
+
+    /**
+     * @brief 多线程锦标赛调度器
+     * 将所有对阵的对局切分为任务块，分配到每个工作线程的本地队列；
+     * 本地队列耗尽后从其他线程队列的另一端窃取任务 (work stealing)。
+     * 每个线程复用一个 GameController 和一组代理，结果写入线程私有的缓冲区，
+     * 全部线程结束后再合并，统计路径上没有任何共享写入。
+     *
+     * 同一组对阵中第 2k 与 2k+1 局使用相同的牌局种子并交换座次，以抵消先手与发牌的方差。
+     */
+    class TournamentRunner {
+    public:
+        TournamentRunner(TournamentConfig config, std::vector<TournamentEntrant> entrants);
+
+        TournamentReport run();
+
+        /**
+         * @brief 根据编排方式生成对阵表 (entrantA, entrantB)
+         */
+        static std::vector<std::pair<int, int>> makePairings(PairingMode mode, int entrantCount);
+
+    private:
+        TournamentConfig m_config;
+        std::vector<TournamentEntrant> m_entrants;
+    };
+
+}
+
+#endif // SEVEN_WONDERS_DUEL_TOURNAMENT_H
@@ -0,0 +1,123 @@
+#ifndef SEVEN_WONDERS_DUEL_TRANSPOSITIONTABLE_H
+#define SEVEN_WONDERS_DUEL_TRANSPOSITIONTABLE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace SevenWondersDuel {
+
+    /**
+     * @brief 置换表条目的内容 (打包为 64 位后存储)
+     * bound 的含义由使用方定义，但 0 保留为"空条目"，不能被存储。
+     */
+    struct TTData {
+        std::int32_t value = 0;
+        std::int16_t depth = 0;
+        std::uint8_t move = 0;
+        std::uint8_t bound = 0;       // 取值 1..3
+    };
+
+    /**
+     * @brief 置换表访问统计
+     * 由每个搜索线程各自持有并传入 probe / store (避免计数器本身成为共享写热点)，结束后再累加。
+     */
+    struct TTCounters {
+        long long probes = 0;
+        long long hits = 0;           // 校验通过的命中次数
+        long long stores = 0;
+        long long replacements = 0;   // 覆盖了另一局面的有效条目
+        long long racyReads = 0;      // 读取条目期间观察到其他线程正在写入
+        long long racyWrites = 0;     // 选定的槽位在写入前被其他线程改写
+
+        double hitRate() const { return probes > 0 ? static_cast<double>(hits) / probes : 0.0; }
+        long long contention() const { return racyReads + racyWrites; }
+
+        TTCounters& operator+=(const TTCounters& o) {
+            probes += o.probes; hits += o.hits; stores += o.stores;
+            replacements += o.replacements; racyReads += o.racyReads; racyWrites += o.racyWrites;
+            return *this;
+        }
+    };
+
+    /**
+     * @brief 多线程共享的无锁置换表 (Lazy SMP 风格)
+     *
+     * - 定长：按 MB 指定大小，构造时一次分配；以 64 字节 (一条缓存行) 的桶组织，每桶 BUCKET_SIZE 个条目
+     * - 无锁：条目为两个 64 位原子字 {key ^ data, data}，读写均为 relaxed 原子操作；
+     *   并发写入造成的"撕裂"条目无法通过 key ^ data 校验，读到时视为未命中 (Hyatt 的 XOR 校验法)
+     * - 老化：每次新搜索调用 newSearch() 推进 6 位世代号；桶满时替换 "深度 - AGE_WEIGHT × 世代差" 最小的条目，
+     *   同一局面总是原地更新
+     *
+     * 任何基于 IPlayerAgent 的搜索代理都可持有 (或通过 shared_ptr 共享) 一张表；多个线程对同一张表
+     * 并发 probe / store 无需任何互斥。
+     */
+    class SharedTranspositionTable {
+    public:
+        static constexpr int BUCKET_SIZE = 4;
+        static constexpr int AGE_WEIGHT = 8;
+        static constexpr int GENERATIONS = 64;
+
+        /**
+         * @param sizeMB 表大小 (MB)，向下取整到 2 的幂个桶，至少 1 个桶
+         */
+        explicit SharedTranspositionTable(size_t sizeMB);
+        ~SharedTranspositionTable();
+
+        SharedTranspositionTable(const SharedTranspositionTable&) = delete;
+        SharedTranspositionTable& operator=(const SharedTranspositionTable&) = delete;
+
+        /**
+         * @brief 查找 key；命中时写入 out 并返回 true
+         */
+        bool probe(std::uint64_t key, TTData& out, TTCounters& counters) const;
+
+        /**
+         * @brief 写入 key 的结果 (data.bound 必须非 0)
+         */
+        void store(std::uint64_t key, const TTData& data, TTCounters& counters);
+
+        /**
+         * @brief 开始新一次搜索：推进世代号，旧条目随之更容易被替换
+         */
+        void newSearch() { m_generation.store((m_generation.load(std::memory_order_relaxed) + 1) & (GENERATIONS - 1), std::memory_order_relaxed); }
+
+        /**
+         * @brief 清空全部条目 (不得与 probe / store 并发调用)
+         */
+        void clear();
+
+        size_t getBucketCount() const { return m_bucketMask + 1; }
+        size_t getEntryCount() const { return getBucketCount() * BUCKET_SIZE; }
+        size_t getSizeBytes() const { return getBucketCount() * sizeof(Bucket); }
+
+        /**
+         * @brief 按前若干桶抽样估计的占用率 (千分比，只计当前世代的条目)
+         */
+        int hashfull() const;
+
+    private:
+        struct Entry {
+            std::atomic<std::uint64_t> check;   // key ^ data
+            std::atomic<std::uint64_t> data;
+        };
+
+        struct alignas(64) Bucket {
+            Entry entries[BUCKET_SIZE];
+        };
+
+        static_assert(sizeof(Bucket) == 64, "a bucket must fill exactly one cache line");
+
+        std::unique_ptr<Bucket[]> m_buckets;
+        size_t m_bucketMask = 0;
+        std::atomic<std::uint32_t> m_generation{0};
+
+        static std::uint64_t pack(const TTData& d, std::uint32_t generation);
+        static TTData unpack(std::uint64_t word);
+        static std::uint32_t generationOf(std::uint64_t word) { return static_cast<std::uint32_t>(word >> 58); }
+        static int boundOf(std::uint64_t word) { return static_cast<int>((word >> 56) & 3u); }
+    };
+
+}
+
+#endif // SEVEN_WONDERS_DUEL_TRANSPOSITIONTABLE_H
@@ -0,0 +1,98 @@
+#ifndef SEVEN_WONDERS_DUEL_ZOBRIST_H
+#define SEVEN_WONDERS_DUEL_ZOBRIST_H
+
+#include "Global.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+namespace SevenWondersDuel {
+
+    class GameModel;
+    class CardPyramid;
+
+    /**
+     * @brief Zobrist 哈希键表
+     * 每个 "(位置, 取值)" 特征对应一个固定的 64 位随机键，局面哈希为其全部特征键的异或。
+     * 键表由固定种子的 SplitMix64 生成，跨进程、跨运行保持一致 (可用于落盘的对局语料去重)。
+     *
+     * 哈希在模型的修改接口 (Player / CardPyramid / MilitaryTrack / Board / GameModel) 中增量维护，
+     * GameCommands 只通过这些接口修改状态，因此每个命令执行后哈希自动保持最新。
+     * 覆盖的特征：金字塔各卡槽 (卡牌 + 背面/正面，被拿走后不计)、双方已建卡牌与奇迹下垫的卡牌、
+     * 双方未建/已建奇迹、轮抽池、弃牌堆、棋盘/盒中/双方的科技标记、双方金币、
+     * 军事位置与掠夺标记、当前玩家、时代；GameState 等控制器状态由 GameController::getStateHash 并入。
+     * 不覆盖：尚未进入轮抽池的奇迹顺序与随机流状态 (属于未来的发牌，而非当前局面)。
+     */
+    class Zobrist {
+    public:
+        static constexpr int INDEX_KINDS = 256;                              // CardIndex / WonderIndex 取值范围
+        static constexpr int COIN_KEYS = 128;                                // 金币超过 127 时共用最后一个键
+        static constexpr int MILITARY_POSITIONS = 2 * Config::MILITARY_THRESHOLD_WIN + 1;
+        static constexpr int TOKEN_KINDS = 16;                               // 按 ProgressToken 取值索引
+        static constexpr int STATE_KINDS = 16;                               // 按 GameState 取值索引
+        static constexpr int CARD_TYPE_KINDS = 8;                            // 按 CardType 取值索引
+
+        static std::uint64_t pyramidSlot(int slot, CardIndex card, bool faceUp) { return s_keys.pyramid[slot][faceUp ? 1 : 0][card]; }
+        static std::uint64_t builtCard(int player, CardIndex card) { return s_keys.builtCard[player & 1][card]; }
+        static std::uint64_t wonderOverlay(int player, CardIndex card) { return s_keys.overlay[player & 1][card]; }
+        static std::uint64_t unbuiltWonder(int player, WonderIndex wonder) { return s_keys.wonder[player & 1][0][wonder]; }
+        static std::uint64_t builtWonder(int player, WonderIndex wonder) { return s_keys.wonder[player & 1][1][wonder]; }
+        static std::uint64_t draftPool(WonderIndex wonder) { return s_keys.draftPool[wonder]; }
+        static std::uint64_t discardedCard(CardIndex card) { return s_keys.discard[card]; }
+
+        static std::uint64_t playerToken(int player, ProgressToken t) { return s_keys.playerToken[player & 1][static_cast<int>(t) & (TOKEN_KINDS - 1)]; }
+        static std::uint64_t boardToken(ProgressToken t) { return s_keys.boardToken[static_cast<int>(t) & (TOKEN_KINDS - 1)]; }
+        static std::uint64_t boxToken(ProgressToken t) { return s_keys.boxToken[static_cast<int>(t) & (TOKEN_KINDS - 1)]; }
+
+        static std::uint64_t coins(int player, int amount) { return s_keys.coins[player & 1][std::clamp(amount, 0, COIN_KEYS - 1)]; }
+        static std::uint64_t militaryPosition(int position) {
+            return s_keys.military[std::clamp(position + Config::MILITARY_THRESHOLD_WIN, 0, MILITARY_POSITIONS - 1)];
+        }
+        static std::uint64_t lootToken(int i) { return s_keys.loot[i & 3]; }
+
+        static std::uint64_t currentPlayer(int player) { return s_keys.currentPlayer[player & 1]; }
+        static std::uint64_t age(int age) { return s_keys.age[age & 3]; }
+        static std::uint64_t gameState(GameState s) { return s_keys.state[static_cast<int>(s) & (STATE_KINDS - 1)]; }
+        static std::uint64_t extraTurn() { return s_keys.extraTurn; }
+        static std::uint64_t pendingDestruction(CardType t) { return s_keys.destruction[static_cast<int>(t) & (CARD_TYPE_KINDS - 1)]; }
+
+        /**
+         * @brief 不依赖增量维护，按模型当前内容从头计算哈希 (调试比对与测试用)
+         * 结果应与 GameModel::getHash() 相同。
+         */
+        static std::uint64_t computeModelHash(const GameModel& model);
+
+        /**
+         * @brief 把哈希中背面朝上卡槽的牌面替换为"该槽有一张背面牌"
+         * 得到只依赖公开信息的键，供不读取隐藏牌面的搜索 (置换表、残局记忆化) 使用。
+         */
+        static std::uint64_t hideFaceDownCards(std::uint64_t hash, const CardPyramid& pyramid);
+
+    private:
+        struct Keys {
+            std::uint64_t pyramid[Config::PYRAMID_SLOTS][2][INDEX_KINDS];
+            std::uint64_t builtCard[2][INDEX_KINDS];
+            std::uint64_t overlay[2][INDEX_KINDS];
+            std::uint64_t wonder[2][2][INDEX_KINDS];
+            std::uint64_t draftPool[INDEX_KINDS];
+            std::uint64_t discard[INDEX_KINDS];
+            std::uint64_t playerToken[2][TOKEN_KINDS];
+            std::uint64_t boardToken[TOKEN_KINDS];
+            std::uint64_t boxToken[TOKEN_KINDS];
+            std::uint64_t coins[2][COIN_KEYS];
+            std::uint64_t military[MILITARY_POSITIONS];
+            std::uint64_t loot[4];
+            std::uint64_t currentPlayer[2];
+            std::uint64_t age[4];
+            std::uint64_t state[STATE_KINDS];
+            std::uint64_t extraTurn;
+            std::uint64_t destruction[CARD_TYPE_KINDS];
+        };
+
+        static const Keys s_keys;
+        static Keys generate();
+    };
+
+}
+
+#endif // SEVEN_WONDERS_DUEL_ZOBRIST_H
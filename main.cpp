@@ -2,10 +2,13 @@
 #include "GameView.h"
 #include "InputManager.h"
 #include "Agent.h"
+#include "MCTS.h"
 #include "ScoringManager.h"
 #include <iostream>
 #include <memory>
 #include <limits>
+#include <thread>
+#include <algorithm>
 
 using namespace SevenWondersDuel;
 #ifdef _WIN32
@@ -73,6 +76,24 @@ int main() {
         agent2 = std::make_unique<GreedyAIAgent>();
         p1Name = "Random AI";
         p2Name = "Greedy AI";
+    } else if (modeChoice == 5) {
+        // Human vs MCTS AI (每步思考约 2 秒，树并行使用全部核心)
+        MCTSConfig config;
+        config.timeLimitMs = 2000.0;
+        config.threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        config.parallelMode = MCTSParallelMode::TREE;
+        agent1 = std::make_unique<HumanAgent>();
+        agent2 = std::make_unique<MCTSAgent>(config);
+        p1Name = view.promptPlayerName(1, "Player 1");
+        p2Name = "MCTS AI";
+    } else if (modeChoice == 6) {
+        // Human vs ISMCTS AI (只依据公开信息搜索，每步约 2 秒)
+        MCTSConfig config;
+        config.timeLimitMs = 2000.0;
+        agent1 = std::make_unique<HumanAgent>();
+        agent2 = std::make_unique<ISMCTSAgent>(config);
+        p1Name = view.promptPlayerName(1, "Player 1");
+        p2Name = "ISMCTS AI";
     } else {
         // Quit or invalid - exit
         return 0;
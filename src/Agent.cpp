@@ -2,6 +2,9 @@
 #include "GameController.h"
 #include "GameView.h"
 #include "InputManager.h"
+#include "MCTS.h"
+#include "AlphaBeta.h"
+#include "EndgameSolver.h"
 #include <iostream>
 #include <random>
 #include <algorithm>
@@ -10,19 +13,39 @@
 
 namespace SevenWondersDuel {
 
-    // 辅助：获取随机数引擎
-    std::mt19937& getRNG() {
-        static std::random_device rd;
-        static std::mt19937 rng(rd());
-        return rng;
-    }
-
     // ==========================================================
     //  IPlayerAgent
     // ==========================================================
 
     bool IPlayerAgent::isHuman() const { return false; }
 
+    void IPlayerAgent::setRandomStream(const Xoshiro256& rng) {}
+
+    namespace {
+        // 在生成器产出的合法动作表中查找 (代替逐个 validateAction 试探)
+        bool isLegal(const std::vector<LegalAction>& legal, const Action& action) {
+            for (const auto& la : legal) {
+                if (la.action.type == action.type &&
+                    la.action.targetCard == action.targetCard &&
+                    la.action.targetWonder == action.targetWonder &&
+                    la.action.selectedToken == action.selectedToken &&
+                    la.action.chooseSelf == action.chooseSelf) return true;
+            }
+            return false;
+        }
+    }
+
+    // ==========================================================
+    //  AI Agents: 构造
+    // ==========================================================
+
+    // 默认以硬件熵为种子；批量对局会通过 setRandomStream 覆盖
+    RandomAIAgent::RandomAIAgent(bool showThinking)
+        : m_showThinking(showThinking), m_rng(std::random_device{}()) {}
+
+    GreedyAIAgent::GreedyAIAgent(bool showThinking)
+        : m_showThinking(showThinking), m_rng(std::random_device{}()) {}
+
     // ==========================================================
     //  Human Agent
     // ==========================================================
@@ -39,17 +62,20 @@ namespace SevenWondersDuel {
 
     Action RandomAIAgent::decideAction(GameController& game, GameView& view, InputManager& input) {
         // 1. 提示 AI 正在思考
-        std::cout << "\033[1;35m[AI] 正在思考...\033[0m" << std::endl;
+        if (m_showThinking) {
+            std::cout << "\033[1;35m[AI] 正在思考...\033[0m" << std::endl;
 
-        // 2. 模拟思考时间 (1.5秒)
-        std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+            // 2. 模拟思考时间 (1.5秒)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+        }
 
         const GameModel& model = game.getModel();
         GameState state = game.getState();
         Action action;
         action.type = static_cast<ActionType>(-1); // Init invalid
 
-        auto& rng = getRNG();
+        auto& rng = m_rng;
+        game.generateLegalActions(m_legalActions);
 
         // ------------------------------------------------------
         // 1. 奇迹轮抽阶段
@@ -58,11 +84,13 @@ namespace SevenWondersDuel {
             if (!model.getDraftPool().empty()) {
                 std::uniform_int_distribution<int> dist(0, model.getDraftPool().size() - 1);
                 action.type = ActionType::DRAFT_WONDER;
-                Wonder* selectedWonder = model.getDraftPool()[dist(rng)];
-                action.targetWonderId = selectedWonder->getId();
+                const Wonder* selectedWonder = model.getDraftPool()[dist(rng)];
+                action.targetWonder = selectedWonder->getIndex();
 
-                std::cout << "\033[1;35m[AI] 决定拿取奇迹: " << selectedWonder->getName() << "\033[0m\n";
-                std::this_thread::sleep_for(std::chrono::milliseconds(2000)); // 决策后暂停
+                if (m_showThinking) {
+                    std::cout << "\033[1;35m[AI] 决定拿取奇迹: " << selectedWonder->getName() << "\033[0m\n";
+                    std::this_thread::sleep_for(std::chrono::milliseconds(2000)); // 决策后暂停
+                }
                 return action;
             }
         }
@@ -79,8 +107,10 @@ namespace SevenWondersDuel {
                 action.type = ActionType::SELECT_PROGRESS_TOKEN;
                 action.selectedToken = tokens[dist(rng)];
 
-                std::cout << "\033[1;35m[AI] 获得科技配对奖励，选择标记...\033[0m\n";
-                std::this_thread::sleep_for(std::chrono::milliseconds(2000)); // 决策后暂停
+                if (m_showThinking) {
+                    std::cout << "\033[1;35m[AI] 获得科技配对奖励，选择标记...\033[0m\n";
+                    std::this_thread::sleep_for(std::chrono::milliseconds(2000)); // 决策后暂停
+                }
                 return action;
             }
         }
@@ -93,8 +123,10 @@ namespace SevenWondersDuel {
                 action.type = ActionType::SELECT_PROGRESS_TOKEN;
                 action.selectedToken = tokens[dist(rng)];
 
-                std::cout << "\033[1;35m[AI] 触发图书馆效果，从盒子中选择标记...\033[0m\n";
-                std::this_thread::sleep_for(std::chrono::milliseconds(2000)); // 决策后暂停
+                if (m_showThinking) {
+                    std::cout << "\033[1;35m[AI] 触发图书馆效果，从盒子中选择标记...\033[0m\n";
+                    std::this_thread::sleep_for(std::chrono::milliseconds(2000)); // 决策后暂停
+                }
                 return action;
             }
         }
@@ -102,18 +134,21 @@ namespace SevenWondersDuel {
         // C. 摧毁对手卡牌
         else if (state == GameState::WAITING_FOR_DESTRUCTION) {
             const Player* opp = model.getOpponent();
-            std::vector<Card*> candidates = opp->getBuiltCards();
+            auto builtCards = opp->getAllCards();
+            std::vector<const Card*> candidates(builtCards.begin(), builtCards.end());
             std::shuffle(candidates.begin(), candidates.end(), rng);
 
             // 1. 尝试摧毁
             for (auto c : candidates) {
                 Action tryDestruct;
                 tryDestruct.type = ActionType::SELECT_DESTRUCTION;
-                tryDestruct.targetCardId = c->getId();
+                tryDestruct.targetCard = c->getIndex();
 
-                if (game.validateAction(tryDestruct).isValid) {
-                    std::cout << "\033[1;35m[AI] 决定摧毁对手的卡牌: " << c->getName() << "\033[0m\n";
-                    std::this_thread::sleep_for(std::chrono::milliseconds(2000)); // 决策后暂停
+                if (isLegal(m_legalActions, tryDestruct)) {
+                    if (m_showThinking) {
+                        std::cout << "\033[1;35m[AI] 决定摧毁对手的卡牌: " << c->getName() << "\033[0m\n";
+                        std::this_thread::sleep_for(std::chrono::milliseconds(2000)); // 决策后暂停
+                    }
                     return tryDestruct;
                 }
             }
@@ -121,10 +156,12 @@ namespace SevenWondersDuel {
             // 2. 放弃
             Action skipAction;
             skipAction.type = ActionType::SELECT_DESTRUCTION;
-            skipAction.targetCardId = "";
-            if (game.validateAction(skipAction).isValid) {
-                std::cout << "\033[1;35m[AI] 没有合适的目标，选择跳过摧毁。\033[0m\n";
-                std::this_thread::sleep_for(std::chrono::milliseconds(2000)); // 决策后暂停
+            skipAction.targetCard = NO_CARD;
+            if (isLegal(m_legalActions, skipAction)) {
+                if (m_showThinking) {
+                    std::cout << "\033[1;35m[AI] 没有合适的目标，选择跳过摧毁。\033[0m\n";
+                    std::this_thread::sleep_for(std::chrono::milliseconds(2000)); // 决策后暂停
+                }
                 return skipAction;
             }
 
@@ -135,16 +172,18 @@ namespace SevenWondersDuel {
         else if (state == GameState::WAITING_FOR_DISCARD_BUILD) {
             const auto& pile = model.getBoard()->getDiscardPile();
             if (!pile.empty()) {
-                std::vector<Card*> candidates = pile;
+                std::vector<const Card*> candidates = pile;
                 std::shuffle(candidates.begin(), candidates.end(), rng);
 
                 for (auto c : candidates) {
                     Action tryResurrect;
                     tryResurrect.type = ActionType::SELECT_FROM_DISCARD;
-                    tryResurrect.targetCardId = c->getId();
-                    if (game.validateAction(tryResurrect).isValid) {
-                        std::cout << "\033[1;35m[AI] 决定从弃牌堆复活: " << c->getName() << "\033[0m\n";
-                        std::this_thread::sleep_for(std::chrono::milliseconds(2000)); // 决策后暂停
+                    tryResurrect.targetCard = c->getIndex();
+                    if (isLegal(m_legalActions, tryResurrect)) {
+                        if (m_showThinking) {
+                            std::cout << "\033[1;35m[AI] 决定从弃牌堆复活: " << c->getName() << "\033[0m\n";
+                            std::this_thread::sleep_for(std::chrono::milliseconds(2000)); // 决策后暂停
+                        }
                         return tryResurrect;
                     }
                 }
@@ -157,10 +196,12 @@ namespace SevenWondersDuel {
             std::uniform_int_distribution<int> dist(0, 1);
             action.type = ActionType::CHOOSE_STARTING_PLAYER;
             bool chooseMe = (dist(rng) == 0);
-            action.targetCardId = chooseMe ? "ME" : "OPPONENT";
+            action.chooseSelf = chooseMe;
 
-            std::cout << "\033[1;35m[AI] 决定下个时代 " << (chooseMe ? "自己" : "对手") << " 先手。\033[0m\n";
-            std::this_thread::sleep_for(std::chrono::milliseconds(2000)); // 决策后暂停
+            if (m_showThinking) {
+                std::cout << "\033[1;35m[AI] 决定下个时代 " << (chooseMe ? "自己" : "对手") << " 先手。\033[0m\n";
+                std::this_thread::sleep_for(std::chrono::milliseconds(2000)); // 决策后暂停
+            }
             return action;
         }
 
@@ -175,7 +216,7 @@ namespace SevenWondersDuel {
             std::vector<const CardSlot*> validSlots;
 
             for(const auto& slot : pyramid) {
-                if(slot.getCardPtr() && slot.isFaceUp()) validSlots.push_back(&slot);
+                if(slot.getCardPtr()) validSlots.push_back(&slot);
             }
 
             if (validSlots.empty()) return action;
@@ -189,12 +230,14 @@ namespace SevenWondersDuel {
                     for(auto slot : validSlots) {
                         Action tryWonder;
                         tryWonder.type = ActionType::BUILD_WONDER;
-                        tryWonder.targetCardId = slot->getCardPtr()->getId();
-                        tryWonder.targetWonderId = w->getId();
-
-                        if (game.validateAction(tryWonder).isValid) {
-                            std::cout << "\033[1;35m[AI] 决定建造奇迹: " << w->getName() << " (使用卡牌: " << slot->getCardPtr()->getName() << ")\033[0m\n";
-                            std::this_thread::sleep_for(std::chrono::milliseconds(2000)); // 决策后暂停
+                        tryWonder.targetCard = slot->getCardPtr()->getIndex();
+                        tryWonder.targetWonder = w->getIndex();
+
+                        if (isLegal(m_legalActions, tryWonder)) {
+                            if (m_showThinking) {
+                                std::cout << "\033[1;35m[AI] 决定建造奇迹: " << w->getName() << " (使用卡牌: " << slot->getCardPtr()->getName() << ")\033[0m\n";
+                                std::this_thread::sleep_for(std::chrono::milliseconds(2000)); // 决策后暂停
+                            }
                             return tryWonder;
                         }
                     }
@@ -205,20 +248,24 @@ namespace SevenWondersDuel {
             for (auto slot : validSlots) {
                 Action tryBuild;
                 tryBuild.type = ActionType::BUILD_CARD;
-                tryBuild.targetCardId = slot->getCardPtr()->getId();
+                tryBuild.targetCard = slot->getCardPtr()->getIndex();
 
-                if (game.validateAction(tryBuild).isValid) {
-                    std::cout << "\033[1;35m[AI] 决定建造卡牌: " << slot->getCardPtr()->getName() << "\033[0m\n";
-                    std::this_thread::sleep_for(std::chrono::milliseconds(2000)); // 决策后暂停
+                if (isLegal(m_legalActions, tryBuild)) {
+                    if (m_showThinking) {
+                        std::cout << "\033[1;35m[AI] 决定建造卡牌: " << slot->getCardPtr()->getName() << "\033[0m\n";
+                        std::this_thread::sleep_for(std::chrono::milliseconds(2000)); // 决策后暂停
+                    }
                     return tryBuild;
                 }
             }
 
             // --- 策略 C: 弃牌换钱 (Fallback) ---
             action.type = ActionType::DISCARD_FOR_COINS;
-            action.targetCardId = validSlots[0]->getCardPtr()->getId();
-            std::cout << "\033[1;35m[AI] 资源不足，决定弃掉卡牌换钱: " << validSlots[0]->getCardPtr()->getName() << "\033[0m\n";
-            std::this_thread::sleep_for(std::chrono::milliseconds(2000)); // 决策后暂停
+            action.targetCard = validSlots[0]->getCardPtr()->getIndex();
+            if (m_showThinking) {
+                std::cout << "\033[1;35m[AI] 资源不足，决定弃掉卡牌换钱: " << validSlots[0]->getCardPtr()->getName() << "\033[0m\n";
+                std::this_thread::sleep_for(std::chrono::milliseconds(2000)); // 决策后暂停
+            }
             return action;
         }
 
@@ -231,24 +278,27 @@ namespace SevenWondersDuel {
 
     Action GreedyAIAgent::decideAction(GameController& game, GameView& view, InputManager& input) {
         // 1. 提示 AI 正在思考
-        std::cout << "\033[1;36m[GreedyAI] 正在思考...\033[0m" << std::endl;
+        if (m_showThinking) {
+            std::cout << "\033[1;36m[GreedyAI] 正在思考...\033[0m" << std::endl;
 
-        // 2. 模拟思考时间 (1秒)
-        std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+            // 2. 模拟思考时间 (1秒)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+        }
 
         const GameModel& model = game.getModel();
         GameState state = game.getState();
         Action action;
         action.type = static_cast<ActionType>(-1); // Init invalid
 
-        auto& rng = getRNG();
+        auto& rng = m_rng;
+        game.generateLegalActions(m_legalActions);
 
         // ------------------------------------------------------
         // 1. 奇迹轮抽阶段：选择分数最高的奇迹
         // ------------------------------------------------------
         if (state == GameState::WONDER_DRAFT_PHASE_1 || state == GameState::WONDER_DRAFT_PHASE_2) {
             if (!model.getDraftPool().empty()) {
-                Wonder* bestWonder = nullptr;
+                const Wonder* bestWonder = nullptr;
                 int bestVP = -1;
 
                 for (auto w : model.getDraftPool()) {
@@ -261,10 +311,12 @@ namespace SevenWondersDuel {
 
                 if (bestWonder) {
                     action.type = ActionType::DRAFT_WONDER;
-                    action.targetWonderId = bestWonder->getId();
-                    std::cout << "\033[1;36m[GreedyAI] 选择高分奇迹: " << bestWonder->getName()
-                              << " (VP: " << bestVP << ")\033[0m\n";
-                    std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+                    action.targetWonder = bestWonder->getIndex();
+                    if (m_showThinking) {
+                        std::cout << "\033[1;36m[GreedyAI] 选择高分奇迹: " << bestWonder->getName()
+                                  << " (VP: " << bestVP << ")\033[0m\n";
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+                    }
                     return action;
                 }
             }
@@ -282,8 +334,10 @@ namespace SevenWondersDuel {
                 action.type = ActionType::SELECT_PROGRESS_TOKEN;
                 action.selectedToken = tokens[dist(rng)];
 
-                std::cout << "\033[1;36m[GreedyAI] 获得科技配对奖励，选择标记...\033[0m\n";
-                std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+                if (m_showThinking) {
+                    std::cout << "\033[1;36m[GreedyAI] 获得科技配对奖励，选择标记...\033[0m\n";
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+                }
                 return action;
             }
         }
@@ -296,8 +350,10 @@ namespace SevenWondersDuel {
                 action.type = ActionType::SELECT_PROGRESS_TOKEN;
                 action.selectedToken = tokens[dist(rng)];
 
-                std::cout << "\033[1;36m[GreedyAI] 触发图书馆效果，从盒子中选择标记...\033[0m\n";
-                std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+                if (m_showThinking) {
+                    std::cout << "\033[1;36m[GreedyAI] 触发图书馆效果，从盒子中选择标记...\033[0m\n";
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+                }
                 return action;
             }
         }
@@ -305,10 +361,11 @@ namespace SevenWondersDuel {
         // C. 摧毁对手卡牌 - 优先摧毁对手高分蓝卡
         else if (state == GameState::WAITING_FOR_DESTRUCTION) {
             const Player* opp = model.getOpponent();
-            std::vector<Card*> candidates = opp->getBuiltCards();
+            auto builtCards = opp->getAllCards();
+            std::vector<const Card*> candidates(builtCards.begin(), builtCards.end());
 
             // 按分数降序排序，优先摧毁高分卡
-            std::sort(candidates.begin(), candidates.end(), [&](Card* a, Card* b) {
+            std::sort(candidates.begin(), candidates.end(), [&](const Card* a, const Card* b) {
                 return a->getVictoryPoints(opp, model.getCurrentPlayer())
                      > b->getVictoryPoints(opp, model.getCurrentPlayer());
             });
@@ -316,11 +373,13 @@ namespace SevenWondersDuel {
             for (auto c : candidates) {
                 Action tryDestruct;
                 tryDestruct.type = ActionType::SELECT_DESTRUCTION;
-                tryDestruct.targetCardId = c->getId();
+                tryDestruct.targetCard = c->getIndex();
 
-                if (game.validateAction(tryDestruct).isValid) {
-                    std::cout << "\033[1;36m[GreedyAI] 决定摧毁对手的高分卡牌: " << c->getName() << "\033[0m\n";
-                    std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+                if (isLegal(m_legalActions, tryDestruct)) {
+                    if (m_showThinking) {
+                        std::cout << "\033[1;36m[GreedyAI] 决定摧毁对手的高分卡牌: " << c->getName() << "\033[0m\n";
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+                    }
                     return tryDestruct;
                 }
             }
@@ -328,10 +387,12 @@ namespace SevenWondersDuel {
             // 没有合法目标，跳过
             Action skipAction;
             skipAction.type = ActionType::SELECT_DESTRUCTION;
-            skipAction.targetCardId = "";
-            if (game.validateAction(skipAction).isValid) {
-                std::cout << "\033[1;36m[GreedyAI] 没有合适的目标，选择跳过摧毁。\033[0m\n";
-                std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+            skipAction.targetCard = NO_CARD;
+            if (isLegal(m_legalActions, skipAction)) {
+                if (m_showThinking) {
+                    std::cout << "\033[1;36m[GreedyAI] 没有合适的目标，选择跳过摧毁。\033[0m\n";
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+                }
                 return skipAction;
             }
 
@@ -342,10 +403,10 @@ namespace SevenWondersDuel {
         else if (state == GameState::WAITING_FOR_DISCARD_BUILD) {
             const auto& pile = model.getBoard()->getDiscardPile();
             if (!pile.empty()) {
-                std::vector<Card*> candidates = pile;
+                std::vector<const Card*> candidates = pile;
 
                 // 按分数降序排序，优先复活高分卡
-                std::sort(candidates.begin(), candidates.end(), [&](Card* a, Card* b) {
+                std::sort(candidates.begin(), candidates.end(), [&](const Card* a, const Card* b) {
                     return a->getVictoryPoints(model.getCurrentPlayer(), model.getOpponent())
                          > b->getVictoryPoints(model.getCurrentPlayer(), model.getOpponent());
                 });
@@ -353,10 +414,12 @@ namespace SevenWondersDuel {
                 for (auto c : candidates) {
                     Action tryResurrect;
                     tryResurrect.type = ActionType::SELECT_FROM_DISCARD;
-                    tryResurrect.targetCardId = c->getId();
-                    if (game.validateAction(tryResurrect).isValid) {
-                        std::cout << "\033[1;36m[GreedyAI] 决定从弃牌堆复活高分卡: " << c->getName() << "\033[0m\n";
-                        std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+                    tryResurrect.targetCard = c->getIndex();
+                    if (isLegal(m_legalActions, tryResurrect)) {
+                        if (m_showThinking) {
+                            std::cout << "\033[1;36m[GreedyAI] 决定从弃牌堆复活高分卡: " << c->getName() << "\033[0m\n";
+                            std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+                        }
                         return tryResurrect;
                     }
                 }
@@ -367,10 +430,12 @@ namespace SevenWondersDuel {
         // E. 选择先手 - 总是选择自己先手
         else if (state == GameState::WAITING_FOR_START_PLAYER_SELECTION) {
             action.type = ActionType::CHOOSE_STARTING_PLAYER;
-            action.targetCardId = "ME"; // 贪心策略：总是自己先手
+            action.chooseSelf = true; // 贪心策略：总是自己先手
 
-            std::cout << "\033[1;36m[GreedyAI] 决定下个时代自己先手。\033[0m\n";
-            std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+            if (m_showThinking) {
+                std::cout << "\033[1;36m[GreedyAI] 决定下个时代自己先手。\033[0m\n";
+                std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+            }
             return action;
         }
 
@@ -386,7 +451,7 @@ namespace SevenWondersDuel {
             std::vector<const CardSlot*> validSlots;
 
             for (const auto& slot : pyramid) {
-                if (slot.getCardPtr() && slot.isFaceUp()) {
+                if (slot.getCardPtr()) {
                     validSlots.push_back(&slot);
                 }
             }
@@ -398,12 +463,12 @@ namespace SevenWondersDuel {
             std::vector<std::pair<const CardSlot*, int>> otherCards; // <slot, VP>
 
             for (auto slot : validSlots) {
-                Card* card = slot->getCardPtr();
+                const Card* card = slot->getCardPtr();
                 Action tryBuild;
                 tryBuild.type = ActionType::BUILD_CARD;
-                tryBuild.targetCardId = card->getId();
+                tryBuild.targetCard = card->getIndex();
 
-                if (game.validateAction(tryBuild).isValid) {
+                if (isLegal(m_legalActions, tryBuild)) {
                     int vp = card->getVictoryPoints(me, opp);
                     if (card->getType() == CardType::CIVILIAN) {
                         blueCards.push_back({slot, vp});
@@ -420,11 +485,13 @@ namespace SevenWondersDuel {
             // 优先选择分数最高的蓝卡
             if (!blueCards.empty()) {
                 action.type = ActionType::BUILD_CARD;
-                action.targetCardId = blueCards[0].first->getCardPtr()->getId();
-                std::cout << "\033[1;36m[GreedyAI] 决定建造高分蓝卡: "
-                          << blueCards[0].first->getCardPtr()->getName()
-                          << " (VP: " << blueCards[0].second << ")\033[0m\n";
-                std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+                action.targetCard = blueCards[0].first->getCardPtr()->getIndex();
+                if (m_showThinking) {
+                    std::cout << "\033[1;36m[GreedyAI] 决定建造高分蓝卡: "
+                              << blueCards[0].first->getCardPtr()->getName()
+                              << " (VP: " << blueCards[0].second << ")\033[0m\n";
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+                }
                 return action;
             }
 
@@ -434,11 +501,13 @@ namespace SevenWondersDuel {
 
             if (!otherCards.empty()) {
                 action.type = ActionType::BUILD_CARD;
-                action.targetCardId = otherCards[0].first->getCardPtr()->getId();
-                std::cout << "\033[1;36m[GreedyAI] 决定建造卡牌: "
-                          << otherCards[0].first->getCardPtr()->getName()
-                          << " (VP: " << otherCards[0].second << ")\033[0m\n";
-                std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+                action.targetCard = otherCards[0].first->getCardPtr()->getIndex();
+                if (m_showThinking) {
+                    std::cout << "\033[1;36m[GreedyAI] 决定建造卡牌: "
+                              << otherCards[0].first->getCardPtr()->getName()
+                              << " (VP: " << otherCards[0].second << ")\033[0m\n";
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+                }
                 return action;
             }
 
@@ -448,13 +517,15 @@ namespace SevenWondersDuel {
                     for (auto slot : validSlots) {
                         Action tryWonder;
                         tryWonder.type = ActionType::BUILD_WONDER;
-                        tryWonder.targetCardId = slot->getCardPtr()->getId();
-                        tryWonder.targetWonderId = w->getId();
-
-                        if (game.validateAction(tryWonder).isValid) {
-                            std::cout << "\033[1;36m[GreedyAI] 决定建造奇迹: " << w->getName()
-                                      << " (使用卡牌: " << slot->getCardPtr()->getName() << ")\033[0m\n";
-                            std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+                        tryWonder.targetCard = slot->getCardPtr()->getIndex();
+                        tryWonder.targetWonder = w->getIndex();
+
+                        if (isLegal(m_legalActions, tryWonder)) {
+                            if (m_showThinking) {
+                                std::cout << "\033[1;36m[GreedyAI] 决定建造奇迹: " << w->getName()
+                                          << " (使用卡牌: " << slot->getCardPtr()->getName() << ")\033[0m\n";
+                                std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+                            }
                             return tryWonder;
                         }
                     }
@@ -463,14 +534,37 @@ namespace SevenWondersDuel {
 
             // --- 策略 D: 弃牌换钱 (Fallback) ---
             action.type = ActionType::DISCARD_FOR_COINS;
-            action.targetCardId = validSlots[0]->getCardPtr()->getId();
-            std::cout << "\033[1;36m[GreedyAI] 资源不足，决定弃掉卡牌换钱: "
-                      << validSlots[0]->getCardPtr()->getName() << "\033[0m\n";
-            std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+            action.targetCard = validSlots[0]->getCardPtr()->getIndex();
+            if (m_showThinking) {
+                std::cout << "\033[1;36m[GreedyAI] 资源不足，决定弃掉卡牌换钱: "
+                          << validSlots[0]->getCardPtr()->getName() << "\033[0m\n";
+                std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+            }
             return action;
         }
 
         return action;
     }
 
+    // ==========================================================
+    //  Agent Factory
+    // ==========================================================
+
+    std::unique_ptr<IPlayerAgent> AgentFactory::createAI(const std::string& name, bool showThinking) {
+        // "<名称>+exact"：第三时代残局切换为精确求解
+        const std::string exactSuffix = "+exact";
+        if (name.size() > exactSuffix.size() && name.compare(name.size() - exactSuffix.size(), exactSuffix.size(), exactSuffix) == 0) {
+            auto inner = createAI(name.substr(0, name.size() - exactSuffix.size()), showThinking);
+            if (!inner) return nullptr;
+            return std::make_unique<EndgameAgent>(std::move(inner), EndgameAgent::DEFAULT_EXACT_BELOW_CARDS,
+                                                  EndgameAgent::DEFAULT_TIME_LIMIT_MS, showThinking);
+        }
+        if (name == "random") return std::make_unique<RandomAIAgent>(showThinking);
+        if (name == "greedy") return std::make_unique<GreedyAIAgent>(showThinking);
+        if (name == "mcts") return std::make_unique<MCTSAgent>(MCTSConfig(), showThinking);
+        if (name == "ismcts") return std::make_unique<ISMCTSAgent>(MCTSConfig(), showThinking);
+        if (name == "alphabeta") return std::make_unique<AlphaBetaAgent>(AlphaBetaConfig(), showThinking);
+        return nullptr;
+    }
+
 }
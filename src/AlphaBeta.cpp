@@ -0,0 +1,380 @@
+#include "AlphaBeta.h"
+#include "GameController.h"
+#include "Zobrist.h"
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <thread>
+
+namespace SevenWondersDuel {
+
+    namespace {
+        constexpr int INF = 1 << 30;
+        constexpr int WIN_SCORE = 100000;      // 终局胜负的评估值 (减去层数，越早获胜越好)
+        constexpr int WIN_BOUND = WIN_SCORE - 1000;  // 绝对值不小于此值的是"若干层后分出胜负"的评估 (层数远小于 1000)
+        constexpr int CLOCK_CHECK_INTERVAL = 256;
+        constexpr std::uint8_t NO_MOVE = 0xFF;
+        constexpr int COMPLETE_DEPTH = 1000;   // 置换表中"子树未被深度截断"的结果按此深度保存，任何深度都可复用
+
+        // 静态评估权重 (单位 1/4 分)
+        constexpr int SCORE_WEIGHT = 4;
+        constexpr int MILITARY_STEP_WEIGHT = 2;   // 分数之外，冲突标记每格的额外压力
+        constexpr int SCIENCE_SYMBOL_WEIGHT = 3;  // 每种不同科技符号 (科技胜利进度)
+        constexpr int COIN_WEIGHT = 1;            // 金币的平滑价值 (计分只按每 3 枚 1 分取整)
+        constexpr int PRODUCTION_WEIGHT = 3;      // 第一、二时代每单位资源产量 (第三时代后产量不再计价)
+        constexpr int CARD_WEIGHT = 4;            // 每张已建卡牌 / 奇迹的基础价值 (分数之外的资源、连锁与效果)
+
+        int production(const Player& p) {
+            int total = p.getChoiceResourceCount();
+            for (int r = 0; r < 5; ++r) total += p.getFixedResource(static_cast<ResourceType>(r));
+            return total;
+        }
+
+        /**
+         * @brief 存入置换表前把胜负值换算为相对当前节点 (距分出胜负的层数)
+         * 置换表跨决策保留、多线程共享，同一局面可能在不同层数被命中，只能保存与层数无关的值。
+         */
+        int toTableValue(int value, int ply) {
+            if (value >= WIN_BOUND) return value + ply;
+            if (value <= -WIN_BOUND) return value - ply;
+            return value;
+        }
+
+        /**
+         * @brief toTableValue 的逆变换：按命中节点的层数换算回相对根节点的值
+         */
+        int fromTableValue(int value, int ply) {
+            if (value >= WIN_BOUND) return value - ply;
+            if (value <= -WIN_BOUND) return value + ply;
+            return value;
+        }
+
+        Action invalidAction() {
+            Action none;
+            none.type = static_cast<ActionType>(-1);
+            return none;
+        }
+
+        /**
+         * @brief 廉价的着法排序分数，越大越先搜索
+         */
+        int orderScore(const LegalAction& la, const GameModel& model) {
+            const Action& a = la.action;
+            switch (a.type) {
+                case ActionType::BUILD_WONDER: {
+                    const Wonder* w = model.getWonder(a.targetWonder);
+                    return 300 + (w ? 10 * w->getStaticVictoryPoints() : 0) - la.cost;
+                }
+                case ActionType::BUILD_CARD: {
+                    const Card* c = model.getCard(a.targetCard);
+                    int s = 200 - la.cost;
+                    if (c) {
+                        s += 10 * c->getStaticVictoryPoints();
+                        if (c->getType() == CardType::MILITARY || c->getType() == CardType::SCIENTIFIC) s += 20;
+                    }
+                    return s;
+                }
+                case ActionType::DISCARD_FOR_COINS:
+                    return 0;
+                default:
+                    return 100;
+            }
+        }
+
+        /**
+         * @brief 子局面是否已进入新发的牌 (新时代或第二轮奇迹轮抽)，超出搜索视界
+         */
+        bool crossesDeal(const GameController& parent, const GameController& child) {
+            if (child.getModel().getCurrentAge() != parent.getModel().getCurrentAge()) return true;
+            GameState ps = parent.getState();
+            return (ps == GameState::WONDER_DRAFT_PHASE_1 || ps == GameState::WONDER_DRAFT_PHASE_2) && child.getState() != ps;
+        }
+
+        /**
+         * @brief 动作是否翻开了背面朝上的卡牌
+         */
+        bool revealsCards(const GameController& parent, const GameController& child) {
+            CardPyramid::SlotMask before = parent.getModel().getBoard()->getCardStructure().getFaceUpMask();
+            CardPyramid::SlotMask after = child.getModel().getBoard()->getCardStructure().getFaceUpMask();
+            return (after & ~before) != 0;
+        }
+    }
+
+    // ==========================================================
+    //  AlphaBetaAgent
+    // ==========================================================
+
+    AlphaBetaAgent::AlphaBetaAgent(AlphaBetaConfig config, bool showThinking)
+        : AlphaBetaAgent(config, std::make_shared<SharedTranspositionTable>(config.ttSizeMB), showThinking) {}
+
+    AlphaBetaAgent::AlphaBetaAgent(AlphaBetaConfig config, std::shared_ptr<SharedTranspositionTable> table, bool showThinking)
+        : m_config(config), m_showThinking(showThinking), m_rng(std::random_device{}()), m_table(std::move(table)) {}
+
+    AlphaBetaAgent::~AlphaBetaAgent() = default;
+
+    Action AlphaBetaAgent::decideAction(GameController& game, GameView& view, InputManager& input) {
+        if (m_showThinking) {
+            std::cout << "\033[1;33m[AlphaBeta] 正在思考...\033[0m" << std::endl;
+        }
+
+        Action best = search(game);
+
+        if (m_showThinking) {
+            std::cout << "\033[1;33m[AlphaBeta] 深度 " << m_lastStats.depth << (m_lastStats.complete ? " (完整)" : "")
+                      << ", 评估 " << std::fixed << std::setprecision(2) << m_lastStats.score / static_cast<double>(SCORE_WEIGHT)
+                      << ", " << m_lastStats.nodes << " 节点 (" << m_lastStats.threads << " 线程), "
+                      << std::setprecision(0) << m_lastStats.nodesPerSecond() << " 节点/s, "
+                      << "置换表命中率 " << std::setprecision(1) << 100.0 * m_lastStats.ttHitRate() << "%\033[0m" << std::endl;
+        }
+        return best;
+    }
+
+    Action AlphaBetaAgent::search(const GameController& root) {
+        auto start = Clock::now();
+        m_lastStats = AlphaBetaStats();
+
+        // 置换表跨决策保留 (相邻决策的局面高度重叠)，推进世代号让旧条目优先被替换
+        m_table->newSearch();
+
+        int threads = std::max(1, m_config.threads);
+        int maxDepth = std::max(1, m_config.maxDepth);
+        size_t plies = static_cast<size_t>(maxDepth) + 3;   // 辅助线程最多比主线程深一层
+        while (static_cast<int>(m_workers.size()) < threads) {
+            m_workers.push_back(std::make_unique<Worker>());
+            m_workers.back()->id = static_cast<int>(m_workers.size()) - 1;
+        }
+        for (int t = 0; t < threads; ++t) {
+            Worker& w = *m_workers[t];
+            if (w.stack.size() < plies) {
+                w.stack.resize(plies);
+                w.moves.resize(plies);
+                w.order.resize(plies);
+            }
+            for (auto& s : w.stack) if (!s) s = root.clone();
+            w.stack[0]->copyFrom(root);
+            w.nodes = 0;
+            w.ttCutoffs = 0;
+            w.tt = TTCounters();
+        }
+
+        Worker& main = *m_workers[0];
+        m_lastStats.threads = threads;
+        root.generateLegalActions(main.moves[0]);
+        if (main.moves[0].size() <= 1) {
+            m_lastStats.nodes = 1;
+            m_lastStats.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+            return main.moves[0].empty() ? invalidAction() : main.moves[0][0].action;
+        }
+        orderMoves(main, 0, -1);
+        Action best = main.moves[0][main.order[0][0]].action;
+
+        m_sampleSeed = m_rng();
+        m_timed = m_config.timeLimitMs > 0.0;
+        m_deadline = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(m_config.timeLimitMs));
+        int rootPlayer = root.getModel().getCurrentPlayerIndex();
+
+        // Lazy SMP：辅助线程与主线程独立搜索同一局面，只通过置换表共享结果
+        m_stop.store(false, std::memory_order_relaxed);
+        std::vector<std::thread> pool;
+        for (int t = 1; t < threads; ++t) {
+            Worker& w = *m_workers[t];
+            w.moves[0] = main.moves[0];
+            pool.emplace_back([this, &w, maxDepth]() { helperMain(w, maxDepth); });
+        }
+
+        for (int depth = 1; depth <= maxDepth; ++depth) {
+            main.aborted = false;
+            main.hitDepthLimit = false;
+            main.rootBest = -1;
+
+            int value = alphaBeta(main, 0, depth, -INF, INF);
+            if (main.aborted || main.rootBest < 0) break;
+
+            best = main.moves[0][main.rootBest].action;
+            m_lastStats.depth = depth;
+            m_lastStats.score = rootPlayer == 0 ? value : -value;
+            if (!main.hitDepthLimit) {
+                m_lastStats.complete = true;
+                break;
+            }
+            if (m_timed && Clock::now() >= m_deadline) break;
+        }
+
+        m_stop.store(true, std::memory_order_relaxed);
+        for (auto& t : pool) t.join();
+
+        TTCounters tt;
+        for (int t = 0; t < threads; ++t) {
+            m_lastStats.nodes += m_workers[t]->nodes;
+            m_lastStats.ttCutoffs += m_workers[t]->ttCutoffs;
+            tt += m_workers[t]->tt;
+        }
+        m_lastStats.ttProbes = tt.probes;
+        m_lastStats.ttHits = tt.hits;
+        m_lastStats.ttContention = tt.contention();
+        m_lastStats.ttHashfull = m_table->hashfull();
+        m_lastStats.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        return best;
+    }
+
+    void AlphaBetaAgent::helperMain(Worker& w, int maxDepth) {
+        // 奇数号线程从深一层开始，使各线程在同一时刻处于不同深度
+        for (int depth = 1 + (w.id & 1); depth <= maxDepth + 1; ++depth) {
+            w.aborted = false;
+            w.hitDepthLimit = false;
+            w.rootBest = -1;
+            alphaBeta(w, 0, depth, -INF, INF);
+            if (w.aborted || !w.hitDepthLimit) break;
+        }
+    }
+
+    int AlphaBetaAgent::alphaBeta(Worker& w, int ply, int depth, int alpha, int beta) {
+        GameController& state = *w.stack[ply];
+        w.nodes++;
+
+        if (state.getState() == GameState::GAME_OVER) return evaluate(state, ply);
+        if (depth <= 0) {
+            w.hitDepthLimit = true;
+            return evaluate(state, ply);
+        }
+        if (timeUp(w)) {
+            w.aborted = true;
+            return 0;
+        }
+
+        std::uint64_t key = searchKey(state);
+        int ttMove = -1;
+        TTData entry;
+        if (m_table->probe(key, entry, w.tt)) {
+            if (entry.move != NO_MOVE) ttMove = entry.move;
+            // 根节点总是完整搜索，以便得到最佳动作
+            if (ply > 0 && entry.depth >= depth) {
+                int v = fromTableValue(entry.value, ply);
+                Bound b = static_cast<Bound>(entry.bound);
+                if (b == Bound::EXACT ||
+                    (b == Bound::LOWER && v >= beta) ||
+                    (b == Bound::UPPER && v <= alpha)) {
+                    w.ttCutoffs++;
+                    if (entry.depth < COMPLETE_DEPTH) w.hitDepthLimit = true;
+                    return v;
+                }
+            }
+        }
+
+        if (ply > 0) state.generateLegalActions(w.moves[ply]);
+        if (w.moves[ply].empty()) return evaluate(state, ply);
+        orderMoves(w, ply, ttMove);
+
+        bool maximizing = state.getModel().getCurrentPlayerIndex() == 0;
+        int origAlpha = alpha, origBeta = beta;
+        int best = maximizing ? -INF : INF;
+        int bestMove = w.order[ply][0];
+        bool outerLimit = w.hitDepthLimit;
+        w.hitDepthLimit = false;
+
+        for (int i : w.order[ply]) {
+            int v = searchChild(w, ply, i, depth - 1, alpha, beta, key);
+            if (w.aborted) return 0;
+
+            if (maximizing ? v > best : v < best) {
+                best = v;
+                bestMove = i;
+            }
+            if (maximizing) alpha = std::max(alpha, best);
+            else beta = std::min(beta, best);
+            if (alpha >= beta) break;
+        }
+
+        TTData result;
+        result.value = toTableValue(best, ply);
+        result.depth = static_cast<std::int16_t>(w.hitDepthLimit ? depth : COMPLETE_DEPTH);
+        result.bound = static_cast<std::uint8_t>(best <= origAlpha ? Bound::UPPER : (best >= origBeta ? Bound::LOWER : Bound::EXACT));
+        result.move = static_cast<std::uint8_t>(std::min(bestMove, static_cast<int>(NO_MOVE)));
+        m_table->store(key, result, w.tt);
+        w.hitDepthLimit |= outerLimit;
+        if (ply == 0) w.rootBest = bestMove;
+        return best;
+    }
+
+    int AlphaBetaAgent::searchChild(Worker& w, int ply, int moveIndex, int depth, int alpha, int beta, std::uint64_t key) {
+        const GameController& parent = *w.stack[ply];
+        GameController& child = *w.stack[ply + 1];
+        const Action action = w.moves[ply][moveIndex].action;
+
+        child.copyFrom(parent);
+        if (!child.processAction(action)) return evaluate(parent, ply);
+
+        if (child.getState() != GameState::GAME_OVER && crossesDeal(parent, child)) {
+            w.nodes++;
+            return evaluate(child, ply + 1);
+        }
+        if (!revealsCards(parent, child)) return alphaBeta(w, ply + 1, depth, alpha, beta);
+
+        // 机会节点：按公开信息重新抽样背面朝上的卡牌后再执行动作，取平均
+        // 抽样种子只由 (决策种子, 局面键, 动作, 样本序号) 决定，迭代加深的各轮与各线程看到相同的样本
+        int samples = std::max(1, m_config.chanceSamples);
+        long long sum = 0;
+        for (int k = 0; k < samples; ++k) {
+            Xoshiro256 rng(m_sampleSeed ^ key ^ (static_cast<std::uint64_t>(moveIndex) << 32) ^ static_cast<std::uint64_t>(k));
+            child.copyFrom(parent);
+            w.determinizer.sample(child, rng);
+            child.processAction(action);
+            sum += alphaBeta(w, ply + 1, depth, -INF, INF);
+            if (w.aborted) return 0;
+        }
+        return static_cast<int>(sum / samples);
+    }
+
+    void AlphaBetaAgent::orderMoves(Worker& w, int ply, int ttMove) {
+        const std::vector<LegalAction>& moves = w.moves[ply];
+        const GameModel& model = w.stack[ply]->getModel();
+        std::vector<int>& order = w.order[ply];
+
+        order.resize(moves.size());
+        for (size_t i = 0; i < moves.size(); ++i) order[i] = static_cast<int>(i);
+        std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+            return orderScore(moves[a], model) > orderScore(moves[b], model);
+        });
+
+        // 辅助线程在根节点轮换首选着法，使各线程优先展开不同的子树
+        if (ply == 0 && w.id > 0 && ttMove < 0) {
+            std::rotate(order.begin(), order.begin() + w.id % order.size(), order.end());
+        }
+        if (ttMove >= 0 && ttMove < static_cast<int>(moves.size())) {
+            auto it = std::find(order.begin(), order.end(), ttMove);
+            std::rotate(order.begin(), it, it + 1);
+        }
+    }
+
+    bool AlphaBetaAgent::timeUp(Worker& w) {
+        if (w.id > 0 && m_stop.load(std::memory_order_relaxed)) return true;
+        if (!m_timed) return false;
+        if (w.nodes % CLOCK_CHECK_INTERVAL != 0) return false;
+        return Clock::now() >= m_deadline;
+    }
+
+    std::uint64_t AlphaBetaAgent::searchKey(const GameController& state) {
+        return Zobrist::hideFaceDownCards(state.getStateHash(), state.getModel().getBoard()->getCardStructure());
+    }
+
+    int AlphaBetaAgent::evaluate(const GameController& state, int ply) {
+        const GameModel& model = state.getModel();
+        if (state.getState() == GameState::GAME_OVER) {
+            int winner = model.getWinnerIndex();
+            if (winner < 0) return 0;
+            return winner == 0 ? WIN_SCORE - ply : -(WIN_SCORE - ply);
+        }
+
+        const Player& p0 = *model.getPlayers()[0];
+        const Player& p1 = *model.getPlayers()[1];
+        int value = SCORE_WEIGHT * (p0.getScore(p1) - p1.getScore(p0));
+        value += MILITARY_STEP_WEIGHT * model.getBoard()->getMilitaryTrack().getPosition();
+        value += SCIENCE_SYMBOL_WEIGHT * (p0.getDistinctScienceSymbolCount() - p1.getDistinctScienceSymbolCount());
+        value += COIN_WEIGHT * (p0.getCoins() - p1.getCoins());
+        value += CARD_WEIGHT * (p0.getBuiltCardCount() + p0.getBuiltWonderCount() - p1.getBuiltCardCount() - p1.getBuiltWonderCount());
+        if (model.getCurrentAge() < 3) value += PRODUCTION_WEIGHT * (production(p0) - production(p1));
+        return value;
+    }
+
+}
@@ -1,5 +1,6 @@
 #include "Board.h"
 #include "Player.h"
+#include "Zobrist.h"
 #include <algorithm>
 #include <cmath>
 
@@ -9,8 +10,13 @@ namespace SevenWondersDuel {
     //  MilitaryTrack
     // ==========================================================
 
-    std::vector<int> MilitaryTrack::move(int shields, int currentPlayerId) {
-        std::vector<int> lootEvents;
+    MilitaryTrack::MilitaryTrack() {
+        m_hash = Zobrist::militaryPosition(m_position);
+        for (int i = 0; i < 4; ++i) m_hash ^= Zobrist::lootToken(i);
+    }
+
+    MilitaryLoot MilitaryTrack::move(int shields, int currentPlayerId) {
+        MilitaryLoot lootEvents;
 
         // P0 (Id=0) 向正方向(+)推，P1 (Id=1) 向负方向(-)推
         int direction = (currentPlayerId == 0) ? 1 : -1;
@@ -20,31 +26,45 @@ namespace SevenWondersDuel {
         // 钳制范围
         if (m_position > Config::MILITARY_THRESHOLD_WIN) m_position = Config::MILITARY_THRESHOLD_WIN;
         if (m_position < -Config::MILITARY_THRESHOLD_WIN) m_position = -Config::MILITARY_THRESHOLD_WIN;
+        m_hash ^= Zobrist::militaryPosition(startPos) ^ Zobrist::militaryPosition(m_position);
 
         // 检查掠夺 (跨越阈值)
         // P1 (右侧玩家) 被攻击 (Position > 0)
         if (startPos < Config::MILITARY_THRESHOLD_LOOT_1 && m_position >= Config::MILITARY_THRESHOLD_LOOT_1 && m_lootTokens[2]) {
             m_lootTokens[2] = false;
-            lootEvents.push_back(Config::MILITARY_LOOT_VALUE_1);
+            m_hash ^= Zobrist::lootToken(2);
+            lootEvents.push(Config::MILITARY_LOOT_VALUE_1);
         }
         if (startPos < Config::MILITARY_THRESHOLD_LOOT_2 && m_position >= Config::MILITARY_THRESHOLD_LOOT_2 && m_lootTokens[3]) {
             m_lootTokens[3] = false;
-            lootEvents.push_back(Config::MILITARY_LOOT_VALUE_2);
+            m_hash ^= Zobrist::lootToken(3);
+            lootEvents.push(Config::MILITARY_LOOT_VALUE_2);
         }
 
         // P0 (左侧玩家) 被攻击 (Position < 0)
         if (startPos > -Config::MILITARY_THRESHOLD_LOOT_1 && m_position <= -Config::MILITARY_THRESHOLD_LOOT_1 && m_lootTokens[0]) {
             m_lootTokens[0] = false;
-            lootEvents.push_back(-Config::MILITARY_LOOT_VALUE_1);
+            m_hash ^= Zobrist::lootToken(0);
+            lootEvents.push(-Config::MILITARY_LOOT_VALUE_1);
         }
         if (startPos > -Config::MILITARY_THRESHOLD_LOOT_2 && m_position <= -Config::MILITARY_THRESHOLD_LOOT_2 && m_lootTokens[1]) {
             m_lootTokens[1] = false;
-            lootEvents.push_back(-Config::MILITARY_LOOT_VALUE_2);
+            m_hash ^= Zobrist::lootToken(1);
+            lootEvents.push(-Config::MILITARY_LOOT_VALUE_2);
         }
 
         return lootEvents;
     }
 
+    void MilitaryTrack::restore(int position, const bool lootTokens[4]) {
+        m_position = std::clamp(position, -Config::MILITARY_THRESHOLD_WIN, Config::MILITARY_THRESHOLD_WIN);
+        m_hash = Zobrist::militaryPosition(m_position);
+        for (int i = 0; i < 4; ++i) {
+            m_lootTokens[i] = lootTokens[i];
+            if (m_lootTokens[i]) m_hash ^= Zobrist::lootToken(i);
+        }
+    }
+
     int MilitaryTrack::getVictoryPoints(int playerId) const {
         int absPos = std::abs(m_position);
         int points = 0;
@@ -62,164 +82,176 @@ namespace SevenWondersDuel {
     //  CardPyramid
     // ==========================================================
 
-    void CardPyramid::init(int age, const std::vector<Card*>& deck) {
-        m_slots.clear();
-        int cardIdx = 0;
-
-        if (age == 1) {
-            // Age 1: 正金字塔 (2-3-4-5-6)
-            addSlot(0, 2, true, deck, cardIdx);
-            addSlot(1, 3, false, deck, cardIdx);
-            addSlot(2, 4, true, deck, cardIdx);
-            addSlot(3, 5, false, deck, cardIdx);
-            addSlot(4, 6, true, deck, cardIdx);
-
-            setupDependenciesAge1();
-        }
-        else if (age == 2) {
-            // Age 2: 倒金字塔 (6-5-4-3-2)
-            addSlot(0, 6, true, deck, cardIdx);
-            addSlot(1, 5, false, deck, cardIdx);
-            addSlot(2, 4, true, deck, cardIdx);
-            addSlot(3, 3, false, deck, cardIdx);
-            addSlot(4, 2, true, deck, cardIdx);
-
-            setupDependenciesAge2();
-        }
-        else if (age == 3) {
-            // Age 3: 蛇形结构 (20 cards)
-            // 结构 (从顶到底): 2(U) - 3(D) - 4(U) - 2(D) - 4(U) - 3(D) - 2(U)
-            addSlot(0, 2, true, deck, cardIdx);
-            addSlot(1, 3, false, deck, cardIdx);
-            addSlot(2, 4, true, deck, cardIdx);
-            addSlot(3, 2, false, deck, cardIdx); 
-            addSlot(4, 4, true, deck, cardIdx);
-            addSlot(5, 3, false, deck, cardIdx);
-            addSlot(6, 2, true, deck, cardIdx); 
-
-            setupDependenciesAge3();
+    namespace {
+
+        using SlotMask = CardPyramid::SlotMask;
+        constexpr int SLOTS = Config::PYRAMID_SLOTS;
+        constexpr int MAX_ROWS = 7;
+
+        constexpr SlotMask S(int slot) { return SlotMask(1) << slot; }
+
+        /**
+         * @brief 一个时代的固定布局
+         * 卡槽按行从上到下、行内从左到右编号 0..19；
+         * coveredBy[i] 为压在第 i 槽上的卡槽集合，全部被拿走后第 i 槽即可拿取并翻面。
+         */
+        struct PyramidLayout {
+            int rowCount;
+            std::array<int, MAX_ROWS> rowSizes;
+            std::array<bool, MAX_ROWS> rowFaceUp;
+            std::array<SlotMask, SLOTS> coveredBy;
+        };
+
+        constexpr std::array<SlotMask, SLOTS> invertCoverage(const std::array<SlotMask, SLOTS>& coveredBy) {
+            std::array<SlotMask, SLOTS> covers{};
+            for (int i = 0; i < SLOTS; ++i)
+                for (int j = 0; j < SLOTS; ++j)
+                    if (coveredBy[j] & S(i)) covers[i] |= S(j);
+            return covers;
         }
-    }
 
+        // Age 1: 正金字塔 (2-3-4-5-6)，每张牌被下一行相邻两张压住
+        constexpr PyramidLayout AGE1_LAYOUT = {
+            5, {2, 3, 4, 5, 6}, {true, false, true, false, true},
+            {
+                /* 第0行 */ S(2) | S(3), S(3) | S(4),
+                /* 第1行 */ S(5) | S(6), S(6) | S(7), S(7) | S(8),
+                /* 第2行 */ S(9) | S(10), S(10) | S(11), S(11) | S(12), S(12) | S(13),
+                /* 第3行 */ S(14) | S(15), S(15) | S(16), S(16) | S(17), S(17) | S(18), S(18) | S(19),
+                /* 第4行 */ 0, 0, 0, 0, 0, 0
+            }
+        };
+
+        // Age 2: 倒金字塔 (6-5-4-3-2)，每张牌被下一行至多两张压住
+        constexpr PyramidLayout AGE2_LAYOUT = {
+            5, {6, 5, 4, 3, 2}, {true, false, true, false, true},
+            {
+                /* 第0行 */ S(6), S(6) | S(7), S(7) | S(8), S(8) | S(9), S(9) | S(10), S(10),
+                /* 第1行 */ S(11), S(11) | S(12), S(12) | S(13), S(13) | S(14), S(14),
+                /* 第2行 */ S(15), S(15) | S(16), S(16) | S(17), S(17),
+                /* 第3行 */ S(18), S(18) | S(19), S(19),
+                /* 第4行 */ 0, 0
+            }
+        };
+
+        // Age 3: 蛇形结构 2(U)-3(D)-4(U)-2(D)-4(U)-3(D)-2(U)，中间第 3 行左右分开
+        constexpr PyramidLayout AGE3_LAYOUT = {
+            7, {2, 3, 4, 2, 4, 3, 2}, {true, false, true, false, true, false, true},
+            {
+                /* 第0行 */ S(2) | S(3), S(3) | S(4),
+                /* 第1行 */ S(5) | S(6), S(6) | S(7), S(7) | S(8),
+                /* 第2行 */ S(9), S(9), S(10), S(10),
+                /* 第3行 */ S(11) | S(12), S(13) | S(14),
+                /* 第4行 */ S(15), S(15) | S(16), S(16) | S(17), S(17),
+                /* 第5行 */ S(18), S(18) | S(19), S(19),
+                /* 第6行 */ 0, 0
+            }
+        };
 
-    Card* CardPyramid::removeCard(const std::string& cardId) {
-        Card* removedCard = nullptr;
-        int removedIdx = -1;
+        constexpr std::array<SlotMask, SLOTS> AGE1_COVERS = invertCoverage(AGE1_LAYOUT.coveredBy);
+        constexpr std::array<SlotMask, SLOTS> AGE2_COVERS = invertCoverage(AGE2_LAYOUT.coveredBy);
+        constexpr std::array<SlotMask, SLOTS> AGE3_COVERS = invertCoverage(AGE3_LAYOUT.coveredBy);
 
-        for (int i = 0; i < (int)m_slots.size(); ++i) {
-            if (m_slots[i].getId() == cardId || (m_slots[i].getCardPtr() && m_slots[i].getCardPtr()->getId() == cardId)) {
-                if (m_slots[i].isRemoved()) return nullptr; // 已经被移除了
-                m_slots[i].setRemoved(true);
-                removedCard = m_slots[i].getCardPtr();
-                removedIdx = i;
-                break;
-            }
-        }
+    }
 
-        if (removedIdx == -1) return nullptr;
+    void CardPyramid::init(int age, const std::vector<const Card*>& deck) {
+        layout(age, deck.data(), static_cast<int>(deck.size()));
+    }
 
-        // 更新依赖
-        for (auto& s : m_slots) {
-            if (!s.isRemoved()) {
-                s.notifyCoveringRemoved(removedIdx);
+    void CardPyramid::layout(int age, const Card* const* cards, int count) {
+        const PyramidLayout* layout = nullptr;
+        if (age == 1) { layout = &AGE1_LAYOUT; m_covers = AGE1_COVERS.data(); }
+        else if (age == 2) { layout = &AGE2_LAYOUT; m_covers = AGE2_COVERS.data(); }
+        else if (age == 3) { layout = &AGE3_LAYOUT; m_covers = AGE3_COVERS.data(); }
+
+        m_slotCount = 0;
+        m_slotMask = m_removed = m_faceUp = m_exposed = 0;
+        m_hash = 0;
+        m_coveredBy = nullptr;
+        if (!layout) { m_covers = nullptr; return; }
+        m_coveredBy = layout->coveredBy.data();
+
+        for (int r = 0; r < layout->rowCount; ++r) {
+            for (int k = 0; k < layout->rowSizes[r]; ++k) {
+                if (m_slotCount >= count) break;
+                CardSlot& slot = m_slots[m_slotCount];
+                slot.setCardPtr(cards[m_slotCount]);
+                slot.setRow(r);
+                slot.setIndex(k);
+                if (layout->rowFaceUp[r]) m_faceUp |= S(m_slotCount);
+                m_slotCount++;
             }
         }
-        return removedCard;
-    }
 
-    void CardPyramid::addSlot(int row, int count, bool faceUp, const std::vector<Card*>& deck, int& deckIdx) {
-        for (int i = 0; i < count; ++i) {
-            if (deckIdx >= (int)deck.size()) break;
-            CardSlot slot;
-            slot.setCardPtr(deck[deckIdx++]);
-            slot.setId(slot.getCardPtr()->getId());
-            slot.setFaceUp(faceUp);
-            slot.setRow(row);
-            slot.setIndex(i);
-            m_slots.push_back(slot);
+        m_slotMask = (m_slotCount >= 32) ? ~SlotMask(0) : (S(m_slotCount) - 1);
+        for (int i = 0; i < m_slotCount; ++i) {
+            if ((m_coveredBy[i] & m_slotMask) == 0) m_exposed |= S(i);
+            m_hash ^= slotKey(i);
         }
     }
 
-    int CardPyramid::getAbsIndex(CardSlot* ptr) {
-        return static_cast<int>(ptr - &m_slots[0]);
-    }
-
-    std::vector<CardSlot*> CardPyramid::getSlotsByRow(int r) {
-        std::vector<CardSlot*> res;
-        for (auto& s : m_slots) {
-            if (s.getRow() == r) res.push_back(&s);
+    void CardPyramid::restore(int age, const std::array<const Card*, Config::PYRAMID_SLOTS>& slots, int slotCount, SlotMask removed, SlotMask faceUp) {
+        layout(age, slots.data(), slotCount);
+        m_removed = removed & m_slotMask;
+        m_faceUp = faceUp & m_slotMask;
+        m_exposed = 0;
+        m_hash = 0;
+        SlotMask alive = m_slotMask & ~m_removed;
+        for (int i = 0; i < m_slotCount; ++i) {
+            if (((alive >> i) & 1u) && (m_coveredBy[i] & alive) == 0) m_exposed |= S(i);
+            m_hash ^= slotKey(i);
         }
-        return res;
     }
 
-    void CardPyramid::setupDependenciesAge1() {
-        for (int r = 0; r < 4; ++r) {
-            auto upper = getSlotsByRow(r);
-            auto lower = getSlotsByRow(r+1);
+    void CardPyramid::restoreMasks(SlotMask removed, SlotMask faceUp, SlotMask exposed) {
+        SlotMask changed = ((m_removed ^ removed) | (m_faceUp ^ faceUp)) & m_slotMask;
+        for (SlotMask rest = changed; rest; rest &= rest - 1) m_hash ^= slotKey(Bits::lowestBit(rest));
+        m_removed = removed & m_slotMask;
+        m_faceUp = faceUp & m_slotMask;
+        m_exposed = exposed & m_slotMask;
+        for (SlotMask rest = changed; rest; rest &= rest - 1) m_hash ^= slotKey(Bits::lowestBit(rest));
+    }
 
-            for (int k = 0; k < (int)upper.size(); ++k) {
-                if (k < (int)lower.size()) upper[k]->addCoveredBy(getAbsIndex(lower[k]));
-                if (k+1 < (int)lower.size()) upper[k]->addCoveredBy(getAbsIndex(lower[k+1]));
+    const Card* CardPyramid::removeCard(CardIndex card) {
+        for (SlotMask rest = m_slotMask & ~m_removed; rest; rest &= rest - 1) {
+            int i = Bits::lowestBit(rest);
+            if (m_slots[i].getCardPtr() && m_slots[i].getCardPtr()->getIndex() == card) {
+                removeSlot(i);
+                return m_slots[i].getCardPtr();
             }
         }
+        return nullptr;
     }
 
-    void CardPyramid::setupDependenciesAge2() {
-        for (int r = 0; r < 4; ++r) {
-            auto upper = getSlotsByRow(r);   // 宽层 (被遮挡)
-            auto lower = getSlotsByRow(r+1); // 窄层 (遮挡者)
-
-            for (int k = 0; k < (int)lower.size(); ++k) {
-                if (k < (int)upper.size()) {
-                    upper[k]->addCoveredBy(getAbsIndex(lower[k]));
-                }
-                if (k+1 < (int)upper.size()) {
-                    upper[k+1]->addCoveredBy(getAbsIndex(lower[k]));
-                }
-            }
-        }
+    bool CardPyramid::replaceHiddenCard(int slot, const Card* card) {
+        if (slot < 0 || slot >= m_slotCount || isFaceUp(slot) || isRemoved(slot)) return false;
+        m_hash ^= slotKey(slot);
+        m_slots[slot].setCardPtr(card);
+        m_hash ^= slotKey(slot);
+        return true;
     }
 
-    void CardPyramid::setupDependenciesAge3() {
-        for (int r = 0; r < 6; ++r) {
-            auto upper = getSlotsByRow(r);     // 被遮挡
-            auto lower = getSlotsByRow(r + 1); // 遮挡者
+    std::uint64_t CardPyramid::slotKey(int slot) const {
+        const Card* card = m_slots[slot].getCardPtr();
+        if (!card || isRemoved(slot)) return 0;
+        return Zobrist::pyramidSlot(slot, card->getIndex(), isFaceUp(slot));
+    }
 
-            if (r == 2) {
-                if (lower.size() > 0 && upper.size() > 1) {
-                    upper[0]->addCoveredBy(getAbsIndex(lower[0]));
-                    upper[1]->addCoveredBy(getAbsIndex(lower[0]));
-                }
-                if (lower.size() > 1 && upper.size() > 3) {
-                    upper[2]->addCoveredBy(getAbsIndex(lower[1]));
-                    upper[3]->addCoveredBy(getAbsIndex(lower[1]));
-                }
-            }
-            else if (r == 3) {
-                if (upper.size() > 0 && lower.size() > 1) {
-                    upper[0]->addCoveredBy(getAbsIndex(lower[0]));
-                    upper[0]->addCoveredBy(getAbsIndex(lower[1]));
-                }
-                if (upper.size() > 1 && lower.size() > 3) {
-                    upper[1]->addCoveredBy(getAbsIndex(lower[2]));
-                    upper[1]->addCoveredBy(getAbsIndex(lower[3]));
-                }
-            }
-            else if (upper.size() > lower.size()) {
-                for (int k = 0; k < (int)lower.size(); ++k) {
-                    if (k < (int)upper.size()) upper[k]->addCoveredBy(getAbsIndex(lower[k]));
-                    if (k+1 < (int)upper.size()) upper[k+1]->addCoveredBy(getAbsIndex(lower[k]));
-                }
-            }
-            else if (upper.size() < lower.size()) {
-                for (int k = 0; k < (int)upper.size(); ++k) {
-                    if (k < (int)lower.size()) upper[k]->addCoveredBy(getAbsIndex(lower[k]));
-                    if (k+1 < (int)lower.size()) upper[k]->addCoveredBy(getAbsIndex(lower[k+1]));
-                }
-            }
-            else {
-                 for (int k = 0; k < (int)upper.size(); ++k) {
-                    upper[k]->addCoveredBy(getAbsIndex(lower[k]));
+    void CardPyramid::removeSlot(int slot) {
+        m_hash ^= slotKey(slot);
+        m_removed |= S(slot);
+        m_exposed &= ~S(slot);
+
+        // 只需检查被它压住的卡槽
+        SlotMask alive = m_slotMask & ~m_removed;
+        for (SlotMask below = m_covers[slot] & alive; below; below &= below - 1) {
+            int j = Bits::lowestBit(below);
+            if ((m_coveredBy[j] & alive) == 0) {
+                m_exposed |= S(j);
+                if (!isFaceUp(j)) {
+                    m_hash ^= slotKey(j);
+                    m_faceUp |= S(j);
+                    m_hash ^= slotKey(j);
                 }
             }
         }
@@ -229,54 +261,77 @@ namespace SevenWondersDuel {
     //  Board
     // ==========================================================
 
-    std::vector<int> Board::moveMilitary(int shields, int currentPlayerId) {
+    MilitaryLoot Board::moveMilitary(int shields, int currentPlayerId) {
         return m_militaryTrack.move(shields, currentPlayerId);
     }
 
-    void Board::initPyramid(int age, const std::vector<Card*>& deck) {
+    void Board::initPyramid(int age, const std::vector<const Card*>& deck) {
         m_cardStructure.init(age, deck);
     }
 
-    Card* Board::removeCardFromPyramid(const std::string& cardId) {
-        return m_cardStructure.removeCard(cardId);
+    const Card* Board::removeCardFromPyramid(CardIndex card) {
+        return m_cardStructure.removeCard(card);
     }
 
-    void Board::addToDiscardPile(Card* c) {
-        if (c) m_discardPile.push_back(c);
+    void Board::insertIntoDiscardPile(int position, const Card* c) {
+        if (!c) return;
+        position = std::clamp(position, 0, static_cast<int>(m_discardPile.size()));
+        m_discardPile.insert(m_discardPile.begin() + position, c);
+        m_hash ^= Zobrist::discardedCard(c->getIndex());
     }
 
-    Card* Board::removeCardFromDiscardPile(const std::string& cardId) {
+    const Card* Board::removeCardFromDiscardPile(CardIndex card) {
         auto it = std::find_if(m_discardPile.begin(), m_discardPile.end(), 
-            [&](Card* c){ return c->getId() == cardId; });
+            [&](const Card* c){ return c->getIndex() == card; });
         
         if (it != m_discardPile.end()) {
-            Card* c = *it;
+            const Card* c = *it;
             m_discardPile.erase(it);
+            m_hash ^= Zobrist::discardedCard(card);
             return c;
         }
         return nullptr;
     }
 
     void Board::setAvailableProgressTokens(const std::vector<ProgressToken>& tokens) {
+        for (ProgressToken t : m_availableProgressTokens) m_hash ^= Zobrist::boardToken(t);
         m_availableProgressTokens = tokens;
+        for (ProgressToken t : m_availableProgressTokens) m_hash ^= Zobrist::boardToken(t);
     }
     
     void Board::setBoxProgressTokens(const std::vector<ProgressToken>& tokens) {
+        for (ProgressToken t : m_boxProgressTokens) m_hash ^= Zobrist::boxToken(t);
         m_boxProgressTokens = tokens;
+        for (ProgressToken t : m_boxProgressTokens) m_hash ^= Zobrist::boxToken(t);
     }
 
     void Board::addAvailableProgressToken(ProgressToken t) {
         m_availableProgressTokens.push_back(t);
+        m_hash ^= Zobrist::boardToken(t);
     }
     
     void Board::addBoxProgressToken(ProgressToken t) {
         m_boxProgressTokens.push_back(t);
+        m_hash ^= Zobrist::boxToken(t);
+    }
+
+    void Board::insertAvailableProgressToken(int position, ProgressToken t) {
+        position = std::clamp(position, 0, static_cast<int>(m_availableProgressTokens.size()));
+        m_availableProgressTokens.insert(m_availableProgressTokens.begin() + position, t);
+        m_hash ^= Zobrist::boardToken(t);
+    }
+
+    void Board::insertBoxProgressToken(int position, ProgressToken t) {
+        position = std::clamp(position, 0, static_cast<int>(m_boxProgressTokens.size()));
+        m_boxProgressTokens.insert(m_boxProgressTokens.begin() + position, t);
+        m_hash ^= Zobrist::boxToken(t);
     }
 
     bool Board::removeAvailableProgressToken(ProgressToken t) {
         auto it = std::find(m_availableProgressTokens.begin(), m_availableProgressTokens.end(), t);
         if (it != m_availableProgressTokens.end()) {
             m_availableProgressTokens.erase(it);
+            m_hash ^= Zobrist::boardToken(t);
             return true;
         }
         return false;
@@ -286,16 +341,18 @@ namespace SevenWondersDuel {
         auto it = std::find(m_boxProgressTokens.begin(), m_boxProgressTokens.end(), t);
         if (it != m_boxProgressTokens.end()) {
             m_boxProgressTokens.erase(it);
+            m_hash ^= Zobrist::boxToken(t);
             return true;
         }
         return false;
     }
 
-    void Board::destroyCard(Player* target, CardType color) {
-        Card* removed = target->removeCardByType(color);
-        if (removed) {
-            m_discardPile.push_back(removed);
-        }
+    void Board::destroyCard(Player* target, CardIndex card) {
+        const Card* removed = target->removeCard(card);
+        if (!removed) return;
+        // 被摧毁的卡牌不再提供产量等持续效果
+        for (const auto& effect : removed->getEffects()) effect->revertPassive(target);
+        addToDiscardPile(removed);
     }
 
 }
@@ -1,30 +1,27 @@
 #include "Card.h"
-#include <algorithm>
+#include "Player.h"
 
 namespace SevenWondersDuel {
 
-    // ==========================================================
-    //  CardSlot
-    // ==========================================================
-
-    bool CardSlot::notifyCoveringRemoved(int index) {
-        auto it = std::remove(m_coveredBy.begin(), m_coveredBy.end(), index);
-        if (it != m_coveredBy.end()) {
-            m_coveredBy.erase(it, m_coveredBy.end());
-            if (m_coveredBy.empty()) {
-                if (!m_isFaceUp) {
-                    m_isFaceUp = true;
-                    return true;
-                }
+    namespace {
+        int sumStaticScore(const std::vector<std::shared_ptr<IEffect>>& effects) {
+            int total = 0;
+            for (const auto& eff : effects) {
+                if (eff->isScoreStatic()) total += eff->calculateScore(nullptr, nullptr);
             }
+            return total;
         }
-        return false;
     }
 
     // ==========================================================
     //  Card
     // ==========================================================
 
+    void Card::setEffects(std::vector<std::shared_ptr<IEffect>> effects) {
+        m_effects = std::move(effects);
+        m_staticVictoryPoints = sumStaticScore(m_effects);
+    }
+
     int Card::getVictoryPoints(const Player* self, const Player* opponent) const {
         int total = 0;
         for(const auto& eff : m_effects) {
@@ -37,18 +34,13 @@ namespace SevenWondersDuel {
     //  Wonder
     // ==========================================================
 
-    void Wonder::build(const Card* overlay) {
-        m_isBuilt = true;
-        m_builtOverlayCard = overlay;
-    }
-
-    void Wonder::reset() {
-        m_isBuilt = false;
-        m_builtOverlayCard = nullptr;
+    void Wonder::setEffects(std::vector<std::shared_ptr<IEffect>> effects) {
+        m_effects = std::move(effects);
+        m_staticVictoryPoints = sumStaticScore(m_effects);
     }
 
     int Wonder::getVictoryPoints(const Player* self, const Player* opponent) const {
-        if (!m_isBuilt) return 0;
+        if (!self || !self->hasBuiltWonder(this)) return 0;
         int total = 0;
         for(const auto& eff : m_effects) {
             total += eff->calculateScore(self, opponent);
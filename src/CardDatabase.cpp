@@ -0,0 +1,84 @@
+#include "CardDatabase.h"
+#include "GameFactory.h"
+#include "CardImage.h"
+#include "MappedFile.h"
+#include <iostream>
+#include <cstdlib>
+
+namespace SevenWondersDuel {
+
+    CardDatabase::CardDatabase(std::vector<Card> cards, std::vector<Wonder> wonders, std::vector<ProgressToken> tokens)
+        : m_cards(std::move(cards)), m_wonders(std::move(wonders)), m_tokens(std::move(tokens)) {
+        if (m_cards.size() >= NO_CARD || m_wonders.size() >= NO_WONDER) {
+            std::cerr << "Too many cards or wonders for 8-bit indices" << std::endl;
+            std::exit(1);
+        }
+
+        // 连锁标记按首次出现的顺序分配位
+        std::unordered_map<std::string, std::uint32_t> chainBits;
+        auto chainBitFor = [&](const std::string& tag) -> std::uint32_t {
+            if (tag.empty()) return 0;
+            auto it = chainBits.find(tag);
+            if (it != chainBits.end()) return it->second;
+            if (chainBits.size() >= 32) {
+                std::cerr << "Too many distinct chain tags for a 32-bit mask" << std::endl;
+                std::exit(1);
+            }
+            std::uint32_t bit = std::uint32_t(1) << chainBits.size();
+            chainBits.emplace(tag, bit);
+            return bit;
+        };
+
+        // 容器此后不再改变，元素地址稳定
+        for (size_t i = 0; i < m_cards.size(); ++i) {
+            m_cards[i].setIndex(static_cast<CardIndex>(i));
+            m_cards[i].setChainBits(chainBitFor(m_cards[i].getChainTag()), chainBitFor(m_cards[i].getRequiresChainTag()));
+            m_cardIndex.emplace(m_cards[i].getId(), &m_cards[i]);
+        }
+        for (size_t i = 0; i < m_wonders.size(); ++i) {
+            m_wonders[i].setIndex(static_cast<WonderIndex>(i));
+            m_wonderIndex.emplace(m_wonders[i].getId(), &m_wonders[i]);
+        }
+    }
+
+    std::shared_ptr<const CardDatabase> CardDatabase::fromFactory(IGameFactory& factory) {
+        return std::make_shared<const CardDatabase>(factory.createCards(), factory.createWonders(), factory.createProgressTokens());
+    }
+
+    std::shared_ptr<const CardDatabase> CardDatabase::loadFromJson(const std::string& jsonPath) {
+        BaseGameFactory factory(jsonPath);
+        return fromFactory(factory);
+    }
+
+    std::shared_ptr<const CardDatabase> CardDatabase::loadFromImage(const std::string& imagePath) {
+        MappedFile image;
+        if (!image.open(imagePath)) return nullptr;
+        BinaryGameFactory factory(image.data(), image.size());
+        return factory.isValid() ? fromFactory(factory) : nullptr;
+    }
+
+    std::shared_ptr<const CardDatabase> CardDatabase::load(const std::string& jsonPath) {
+        std::uint64_t jsonChecksum = 0;
+        bool haveJson = CardImageFormat::checksumFile(jsonPath, jsonChecksum);
+
+        MappedFile image;
+        if (image.open(CardImageFormat::imagePathFor(jsonPath))) {
+            BinaryGameFactory factory(image.data(), image.size());
+            if (factory.isValid() && (!haveJson || factory.getSourceChecksum() == jsonChecksum)) return fromFactory(factory);
+            std::cerr << "Card image " << CardImageFormat::imagePathFor(jsonPath)
+                      << (factory.isValid() ? " is stale" : " is damaged") << "; loading " << jsonPath << std::endl;
+        }
+        return loadFromJson(jsonPath);
+    }
+
+    const Card* CardDatabase::findCard(const std::string& id) const {
+        auto it = m_cardIndex.find(id);
+        return it != m_cardIndex.end() ? it->second : nullptr;
+    }
+
+    const Wonder* CardDatabase::findWonder(const std::string& id) const {
+        auto it = m_wonderIndex.find(id);
+        return it != m_wonderIndex.end() ? it->second : nullptr;
+    }
+
+}
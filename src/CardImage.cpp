@@ -0,0 +1,36 @@
+#include "CardImage.h"
+#include "MappedFile.h"
+
+namespace SevenWondersDuel {
+
+    constexpr char CardImageFormat::MAGIC[4];
+
+    std::uint64_t CardImageFormat::checksum(const std::uint8_t* data, size_t size) {
+        // 每次吸收 8 字节 (按小端组成的字)，与主机字节序无关
+        std::uint64_t h = 0xCBF29CE484222325ULL ^ size;
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8) {
+            std::uint64_t w = 0;
+            for (int b = 7; b >= 0; --b) w = (w << 8) | data[i + b];
+            h = (h ^ w) * 0x9E3779B97F4A7C15ULL;
+            h ^= h >> 29;
+        }
+        for (; i < size; ++i) h = (h ^ data[i]) * 0x100000001B3ULL;
+        return h ^ (h >> 32);
+    }
+
+    bool CardImageFormat::checksumFile(const std::string& path, std::uint64_t& out) {
+        MappedFile file;
+        if (!file.open(path)) return false;
+        out = checksum(file.data(), file.size());
+        return true;
+    }
+
+    std::string CardImageFormat::imagePathFor(const std::string& jsonPath) {
+        size_t slash = jsonPath.find_last_of("/\\");
+        size_t dot = jsonPath.find_last_of('.');
+        if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) return jsonPath + ".bin";
+        return jsonPath.substr(0, dot) + ".bin";
+    }
+
+}
@@ -0,0 +1,117 @@
+#include "Determinization.h"
+#include "GameController.h"
+#include <algorithm>
+#include <random>
+
+namespace SevenWondersDuel {
+
+    namespace {
+        // 把 pool 中随机 n 张移到前部 (部分 Fisher-Yates)，追加到 out
+        void drawInto(std::vector<const Card*>& pool, size_t n, std::vector<const Card*>& out, Xoshiro256& rng) {
+            n = std::min(n, pool.size());
+            for (size_t i = 0; i < n; ++i) {
+                std::uniform_int_distribution<size_t> dist(i, pool.size() - 1);
+                std::swap(pool[i], pool[dist(rng)]);
+                out.push_back(pool[i]);
+            }
+        }
+    }
+
+    void Determinizer::collectUnseenCards(const GameModel& model, std::vector<const Card*>& ageCards, std::vector<const Card*>& guilds) {
+        ageCards.clear();
+        guilds.clear();
+
+        // 已公开的卡牌 (按 CardIndex 置位)
+        std::array<std::uint64_t, 4> seen{};
+        auto mark = [&seen](const Card* c) {
+            if (c) seen[c->getIndex() >> 6] |= 1ull << (c->getIndex() & 63);
+        };
+
+        const Board& board = *model.getBoard();
+        const CardPyramid& pyramid = board.getCardStructure();
+        for (int i = 0; i < pyramid.getSlotCount(); ++i) mark(pyramid.getVisibleCard(i));
+        for (const Card* c : board.getDiscardPile()) mark(c);
+        for (const auto& p : model.getPlayers()) {
+            for (const Card* c : p->getAllCards()) mark(c);
+            for (int w = 0; w < p->getBuiltWonderCount(); ++w) mark(p->getWonderOverlay(w));
+        }
+
+        int age = model.getCurrentAge();
+        for (const auto& card : model.getAllCards()) {
+            CardIndex idx = card.getIndex();
+            if ((seen[idx >> 6] >> (idx & 63)) & 1u) continue;
+            if (card.getType() == CardType::GUILD) {
+                if (age == 3) guilds.push_back(&card);
+            } else if (card.getAge() == age) {
+                ageCards.push_back(&card);
+            }
+        }
+    }
+
+    size_t Determinizer::hiddenGuildCount(const GameModel& model, size_t unseenGuilds, size_t hiddenSlots) {
+        if (model.getCurrentAge() != 3) return 0;
+        // 第三时代：金字塔中恰有 GUILDS_PER_GAME 张公会，未公开的部分都在背面朝上的卡槽里
+        int totalGuilds = 0;
+        for (const auto& card : model.getAllCards()) if (card.getType() == CardType::GUILD) totalGuilds++;
+        int visibleGuilds = totalGuilds - static_cast<int>(unseenGuilds);
+        size_t guildSlots = static_cast<size_t>(std::max(0, Config::GUILDS_PER_GAME - visibleGuilds));
+        return std::min({guildSlots, hiddenSlots, unseenGuilds});
+    }
+
+    bool Determinizer::placeHiddenCard(GameController& state, int slot, const Card* card) {
+        Board* board = state.m_model->getBoardMut();
+        const CardPyramid& pyramid = board->getCardStructure();
+        if (slot < 0 || slot >= pyramid.getSlotCount() || pyramid.isFaceUp(slot) || pyramid.isRemoved(slot)) return false;
+
+        const Card* previous = pyramid.getSlot(slot).getCardPtr();
+        if (previous == card) return true;
+        for (int i = 0; i < pyramid.getSlotCount(); ++i) {
+            if (i != slot && !pyramid.isFaceUp(i) && !pyramid.isRemoved(i) && pyramid.getSlot(i).getCardPtr() == card) {
+                board->replaceHiddenPyramidCard(i, previous);
+                break;
+            }
+        }
+        return board->replaceHiddenPyramidCard(slot, card);
+    }
+
+    void Determinizer::sample(GameController& state, Xoshiro256& rng) {
+        GameModel& model = *state.m_model;
+
+        // 1. 背面朝上的卡槽：从未出现的卡牌中重新抽取
+        const CardPyramid& pyramid = model.getBoard()->getCardStructure();
+        m_hiddenSlots.clear();
+        for (int i = 0; i < pyramid.getSlotCount(); ++i) {
+            if (!pyramid.isRemoved(i) && !pyramid.isFaceUp(i)) m_hiddenSlots.push_back(i);
+        }
+
+        if (!m_hiddenSlots.empty()) {
+            collectUnseenCards(model, m_unseenAge, m_unseenGuilds);
+            size_t hidden = m_hiddenSlots.size();
+
+            size_t guildSlots = hiddenGuildCount(model, m_unseenGuilds.size(), hidden);
+
+            m_hand.clear();
+            drawInto(m_unseenGuilds, guildSlots, m_hand, rng);
+            drawInto(m_unseenAge, hidden - guildSlots, m_hand, rng);
+
+            // 卡池不足说明局面并非由正常发牌得到，此时保持原样
+            if (m_hand.size() == hidden) {
+                std::shuffle(m_hand.begin(), m_hand.end(), rng);
+                Board* board = model.getBoardMut();
+                for (size_t i = 0; i < hidden; ++i) board->replaceHiddenPyramidCard(m_hiddenSlots[i], m_hand[i]);
+            }
+        }
+
+        // 2. 剩余奇迹的顺序 (决定第二轮轮抽的 4 座)
+        m_wonders = model.getRemainingWonders();
+        if (m_wonders.size() > 1) {
+            std::shuffle(m_wonders.begin(), m_wonders.end(), rng);
+            model.clearRemainingWonders();
+            for (const Wonder* w : m_wonders) model.addToRemainingWonders(w);
+        }
+
+        // 3. 之后时代的发牌
+        state.m_deckRng = Xoshiro256(rng());
+    }
+
+}
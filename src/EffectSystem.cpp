@@ -7,16 +7,26 @@
 namespace SevenWondersDuel {
     
     // --- 1. ProductionEffect ---
-    void ProductionEffect::apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) {
+    void ProductionEffect::apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) const {
+        applyPassive(self);
+    }
+
+    void ProductionEffect::applyPassive(Player* self) const {
         if (isChoice) {
-            std::vector<ResourceType> choices;
+            self->addProductionChoice(choiceMask);
+        } else {
             for (auto const& [type, count] : producedResources) {
-                choices.push_back(type);
+                self->addResource(type, count, isTradable);
             }
-            self->addProductionChoice(choices);
+        }
+    }
+
+    void ProductionEffect::revertPassive(Player* self) const {
+        if (isChoice) {
+            self->removeProductionChoice(choiceMask);
         } else {
             for (auto const& [type, count] : producedResources) {
-                self->addResource(type, count, isTradable);
+                self->removeResource(type, count, isTradable);
             }
         }
     }
@@ -34,13 +44,13 @@ namespace SevenWondersDuel {
     }
 
     // --- 2. MilitaryEffect ---
-    void MilitaryEffect::apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) {
+    void MilitaryEffect::apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) const {
         int finalShields = shields;
 
         // 规则修复：Strategy Token 仅对军事建筑 (Red Cards) 生效，+1 盾
-        if (isFromCard && self->getProgressTokens().count(ProgressToken::STRATEGY)) {
+        if (isFromCard && self->hasProgressToken(ProgressToken::STRATEGY)) {
             finalShields += 1;
-            logger->addLog("[Effect] Strategy Token adds +1 Shield.");
+            if (logger->isLogEnabled()) logger->addLog("[Effect] Strategy Token adds +1 Shield.");
         }
 
         auto lootEvents = actions->moveMilitary(finalShields, self->getId());
@@ -49,7 +59,7 @@ namespace SevenWondersDuel {
             // 扣对手的钱
             int loss = std::abs(amount);
             opponent->payCoins(loss);
-            logger->addLog("[Military] Opponent lost " + std::to_string(loss) + " coins!");
+            if (logger->isLogEnabled()) logger->addLog("[Military] Opponent lost " + std::to_string(loss) + " coins!");
         }
     }
 
@@ -58,17 +68,25 @@ namespace SevenWondersDuel {
     }
 
     // --- 3. ScienceEffect ---
-    void ScienceEffect::apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) {
-        self->addScienceSymbol(symbol);
+    void ScienceEffect::apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) const {
+        applyPassive(self);
         // 配对逻辑已在 GameController::handleBuildCard 中通过 checkForNewSciencePairs 统一处理
     }
 
+    void ScienceEffect::applyPassive(Player* self) const {
+        self->addScienceSymbol(symbol);
+    }
+
+    void ScienceEffect::revertPassive(Player* self) const {
+        self->removeScienceSymbol(symbol);
+    }
+
     std::string ScienceEffect::getDescription() const {
         return "Science Symbol";
     }
 
     // --- 4. VictoryPointEffect ---
-    void VictoryPointEffect::apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) {
+    void VictoryPointEffect::apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) const {
         // 立即效果无，只计分
     }
 
@@ -81,7 +99,7 @@ namespace SevenWondersDuel {
     }
 
     // --- 5. CoinEffect ---
-    void CoinEffect::apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) {
+    void CoinEffect::apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) const {
         self->gainCoins(amount);
     }
 
@@ -90,12 +108,12 @@ namespace SevenWondersDuel {
     }
 
     // --- 6. CoinsPerTypeEffect (商业/行会) ---
-    void CoinsPerTypeEffect::apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) {
+    void CoinsPerTypeEffect::apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) const {
         int count = 0;
         count += self->getCardCount(targetType);
 
         if (countWonder) {
-            count += self->getBuiltWonders().size();
+            count += self->getBuiltWonderCount();
         }
 
         int bonus = count * coinsPerCard;
@@ -107,16 +125,25 @@ namespace SevenWondersDuel {
     }
 
     // --- 7. TradeDiscountEffect ---
-    void TradeDiscountEffect::apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) {
+    void TradeDiscountEffect::apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) const {
+        applyPassive(self);
+    }
+
+    void TradeDiscountEffect::applyPassive(Player* self) const {
         self->setTradingDiscount(resource, true);
     }
 
+    void TradeDiscountEffect::revertPassive(Player* self) const {
+        // 每种资源的优惠只由一张卡提供，直接清除即可
+        self->setTradingDiscount(resource, false);
+    }
+
     std::string TradeDiscountEffect::getDescription() const {
         return "Fixed trading price (1 coin) for " + resourceToString(resource);
     }
 
     // --- 8. DestroyCardEffect ---
-    void DestroyCardEffect::apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) {
+    void DestroyCardEffect::apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) const {
         actions->setPendingDestructionType(targetColor);
         actions->setState(GameState::WAITING_FOR_DESTRUCTION);
     }
@@ -126,27 +153,27 @@ namespace SevenWondersDuel {
     }
 
     // --- 9. ExtraTurnEffect ---
-    void ExtraTurnEffect::apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) {
+    void ExtraTurnEffect::apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) const {
         actions->grantExtraTurn();
     }
 
     // --- 10. BuildFromDiscardEffect ---
-    void BuildFromDiscardEffect::apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) {
+    void BuildFromDiscardEffect::apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) const {
         // [UPDATED] 如果弃牌堆为空，则不触发等待状态，直接记录日志
         if (actions->isDiscardPileEmpty()) {
-             logger->addLog("[Effect] Discard pile is empty. Mausoleum effect skipped.");
+             if (logger->isLogEnabled()) logger->addLog("[Effect] Discard pile is empty. Mausoleum effect skipped.");
              return;
         }
         actions->setState(GameState::WAITING_FOR_DISCARD_BUILD);
     }
 
     // --- 11. ProgressTokenSelectEffect ---
-    void ProgressTokenSelectEffect::apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) {
+    void ProgressTokenSelectEffect::apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) const {
         actions->setState(GameState::WAITING_FOR_TOKEN_SELECTION_LIB);
     }
 
     // --- 12. OpponentLoseCoinsEffect ---
-    void OpponentLoseCoinsEffect::apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) {
+    void OpponentLoseCoinsEffect::apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) const {
         int loss = std::min(opponent->getCoins(), amount);
         opponent->payCoins(loss);
     }
@@ -182,7 +209,7 @@ namespace SevenWondersDuel {
     public:
         int calculateCoins(const Player* self, const Player* opponent) const override { return 0; }
         int calculateVP(const Player* self, const Player* opponent) const override {
-            return std::max((int)self->getBuiltWonders().size(), (int)opponent->getBuiltWonders().size()) * 2;
+            return std::max(self->getBuiltWonderCount(), opponent->getBuiltWonderCount()) * 2;
         }
     };
 
@@ -236,7 +263,7 @@ namespace SevenWondersDuel {
         }
     }
 
-    void GuildEffect::apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) {
+    void GuildEffect::apply(Player* self, Player* opponent, ILogger* logger, IGameActions* actions) const {
         int coins = m_strategy->calculateCoins(self, opponent);
         if (coins > 0) self->gainCoins(coins);
     }
@@ -253,21 +280,30 @@ namespace SevenWondersDuel {
 
     std::vector<std::shared_ptr<IEffect>> EffectFactory::createEffects(const nlohmann::json& vList, CardType sourceType, bool isFromCard) {
         std::vector<std::shared_ptr<IEffect>> effects;
+        for (const EffectSpec& spec : parseEffects(vList, sourceType, isFromCard)) {
+            effects.push_back(createEffect(spec));
+        }
+        return effects;
+    }
+
+    std::vector<EffectSpec> EffectFactory::parseEffects(const nlohmann::json& vList, CardType sourceType, bool isFromCard) {
+        std::vector<EffectSpec> specs;
 
         for (const auto& effVal : vList) {
             std::string type = effVal["type"].get<std::string>();
+            EffectSpec spec;
 
             if (type == "PRODUCTION" || type == "PRODUCTION_CHOICE") {
-                std::map<ResourceType, int> res;
-                
+                spec.kind = EffectKind::PRODUCTION;
+
                 if (effVal.contains("resources")) {
                     if (effVal["resources"].is_array()) {
                         for(const auto& item : effVal["resources"]) {
-                            res[strToResource(item.get<std::string>())] = 1;
+                            spec.resources[static_cast<int>(strToResource(item.get<std::string>()))] = 1;
                         }
                     } else if (effVal["resources"].is_object()) {
                          for (const auto& [key, val] : effVal["resources"].items()) {
-                            res[strToResource(key)] = val.get<int>();
+                            spec.resources[static_cast<int>(strToResource(key))] = static_cast<std::uint8_t>(val.get<int>());
                         }
                     }
                 }
@@ -281,45 +317,56 @@ namespace SevenWondersDuel {
                 if (!isFromCard) isTradable = false;
                 if (isChoice) isTradable = false; // Choice 资源肯定不参与交易计算
 
-                effects.push_back(std::make_shared<ProductionEffect>(res, isChoice, isTradable));
+                if (isChoice) spec.flags |= EffectSpec::CHOICE;
+                if (isTradable) spec.flags |= EffectSpec::TRADABLE;
             }
             else if (type == "MILITARY") {
                 // 传入 isFromCard 标记
-                effects.push_back(std::make_shared<MilitaryEffect>(effVal["shields"].get<int>(), isFromCard));
+                spec.kind = EffectKind::MILITARY;
+                spec.amount = effVal["shields"].get<int>();
+                if (isFromCard) spec.flags |= EffectSpec::FROM_CARD;
             }
             else if (type == "VICTORY_POINTS") {
-                effects.push_back(std::make_shared<VictoryPointEffect>(effVal["amount"].get<int>()));
+                spec.kind = EffectKind::VICTORY_POINTS;
+                spec.amount = effVal["amount"].get<int>();
             }
             else if (type == "SCIENCE") {
-                effects.push_back(std::make_shared<ScienceEffect>(strToScienceSymbol(effVal["symbol"].get<std::string>())));
+                spec.kind = EffectKind::SCIENCE;
+                spec.arg = static_cast<std::uint8_t>(strToScienceSymbol(effVal["symbol"].get<std::string>()));
             }
             else if (type == "COINS") {
-                effects.push_back(std::make_shared<CoinEffect>(effVal["amount"].get<int>()));
+                spec.kind = EffectKind::COINS;
+                spec.amount = effVal["amount"].get<int>();
             }
             else if (type == "TRADE_DISCOUNT") {
-                effects.push_back(std::make_shared<TradeDiscountEffect>(strToResource(effVal["resource"].get<std::string>())));
+                spec.kind = EffectKind::TRADE_DISCOUNT;
+                spec.arg = static_cast<std::uint8_t>(strToResource(effVal["resource"].get<std::string>()));
             }
             else if (type == "COINS_PER_TYPE") {
                 CardType t = strToCardType(effVal["target_type"].get<std::string>());
                 if (effVal["target_type"].get<std::string>() == "WONDER") t = CardType::WONDER;
 
-                bool countWonder = (t == CardType::WONDER);
-                effects.push_back(std::make_shared<CoinsPerTypeEffect>(t, effVal["amount"].get<int>(), countWonder));
+                spec.kind = EffectKind::COINS_PER_TYPE;
+                spec.arg = static_cast<std::uint8_t>(t);
+                spec.amount = effVal["amount"].get<int>();
+                if (t == CardType::WONDER) spec.flags |= EffectSpec::COUNT_WONDER;
             }
             else if (type == "DESTROY_CARD") {
-                effects.push_back(std::make_shared<DestroyCardEffect>(strToCardType(effVal["target_color"].get<std::string>())));
+                spec.kind = EffectKind::DESTROY_CARD;
+                spec.arg = static_cast<std::uint8_t>(strToCardType(effVal["target_color"].get<std::string>()));
             }
             else if (type == "EXTRA_TURN") {
-                effects.push_back(std::make_shared<ExtraTurnEffect>());
+                spec.kind = EffectKind::EXTRA_TURN;
             }
             else if (type == "BUILD_FROM_DISCARD") {
-                effects.push_back(std::make_shared<BuildFromDiscardEffect>());
+                spec.kind = EffectKind::BUILD_FROM_DISCARD;
             }
             else if (type == "PROGRESS_TOKEN_SELECT") {
-                effects.push_back(std::make_shared<ProgressTokenSelectEffect>());
+                spec.kind = EffectKind::PROGRESS_TOKEN_SELECT;
             }
             else if (type == "OPPONENT_LOSE_COINS") {
-                effects.push_back(std::make_shared<OpponentLoseCoinsEffect>(effVal["amount"].get<int>()));
+                spec.kind = EffectKind::OPPONENT_LOSE_COINS;
+                spec.amount = effVal["amount"].get<int>();
             }
             else if (type == "GUILD") {
                 std::string criteriaStr = effVal["criteria"].get<std::string>();
@@ -333,9 +380,58 @@ namespace SevenWondersDuel {
                 else if(criteriaStr == "COINS") c = GuildCriteria::COINS;
                 else c = GuildCriteria::YELLOW_CARDS;
 
-                effects.push_back(std::make_shared<GuildEffect>(c));
+                spec.kind = EffectKind::GUILD;
+                spec.arg = static_cast<std::uint8_t>(c);
+            }
+            else {
+                continue;
             }
+            specs.push_back(spec);
+        }
+        return specs;
+    }
+
+    std::shared_ptr<IEffect> EffectFactory::createEffect(const EffectSpec& spec) {
+        switch (spec.kind) {
+            case EffectKind::PRODUCTION: {
+                std::map<ResourceType, int> res;
+                for (int r = 0; r < EffectSpec::RESOURCE_KINDS; ++r) {
+                    if (spec.resources[r] > 0) res[static_cast<ResourceType>(r)] = spec.resources[r];
+                }
+                return std::make_shared<ProductionEffect>(res, (spec.flags & EffectSpec::CHOICE) != 0, (spec.flags & EffectSpec::TRADABLE) != 0);
+            }
+            case EffectKind::MILITARY:
+                return std::make_shared<MilitaryEffect>(spec.amount, (spec.flags & EffectSpec::FROM_CARD) != 0);
+            case EffectKind::VICTORY_POINTS:
+                return std::make_shared<VictoryPointEffect>(spec.amount);
+            case EffectKind::SCIENCE:
+                if (spec.arg > static_cast<int>(ScienceSymbol::LAW)) return nullptr;
+                return std::make_shared<ScienceEffect>(static_cast<ScienceSymbol>(spec.arg));
+            case EffectKind::COINS:
+                return std::make_shared<CoinEffect>(spec.amount);
+            case EffectKind::TRADE_DISCOUNT:
+                if (spec.arg >= EffectSpec::RESOURCE_KINDS) return nullptr;
+                return std::make_shared<TradeDiscountEffect>(static_cast<ResourceType>(spec.arg));
+            case EffectKind::COINS_PER_TYPE:
+                if (spec.arg > static_cast<int>(CardType::WONDER)) return nullptr;
+                return std::make_shared<CoinsPerTypeEffect>(static_cast<CardType>(spec.arg), spec.amount, (spec.flags & EffectSpec::COUNT_WONDER) != 0);
+            case EffectKind::DESTROY_CARD:
+                if (spec.arg > static_cast<int>(CardType::WONDER)) return nullptr;
+                return std::make_shared<DestroyCardEffect>(static_cast<CardType>(spec.arg));
+            case EffectKind::EXTRA_TURN:
+                return std::make_shared<ExtraTurnEffect>();
+            case EffectKind::BUILD_FROM_DISCARD:
+                return std::make_shared<BuildFromDiscardEffect>();
+            case EffectKind::PROGRESS_TOKEN_SELECT:
+                return std::make_shared<ProgressTokenSelectEffect>();
+            case EffectKind::OPPONENT_LOSE_COINS:
+                return std::make_shared<OpponentLoseCoinsEffect>(spec.amount);
+            case EffectKind::GUILD:
+                if (spec.arg > static_cast<int>(GuildCriteria::COINS)) return nullptr;
+                return std::make_shared<GuildEffect>(static_cast<GuildCriteria>(spec.arg));
+            default:
+                return nullptr;
         }
-        return effects;
     }
+
 }
\ No newline at end of file
@@ -0,0 +1,279 @@
+#include "EndgameSolver.h"
+#include "Determinization.h"
+#include "GameController.h"
+#include "Zobrist.h"
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <limits>
+
+namespace SevenWondersDuel {
+
+    namespace {
+        constexpr double INF = std::numeric_limits<double>::infinity();
+        constexpr double TIE_BREAK_MARGIN = 0.5;   // 同分时按蓝卡分决出的胜负
+        constexpr int CLOCK_CHECK_INTERVAL = 1024;
+        constexpr int PLIES_PER_CARD = 4;           // 每张卡最多引出的连续决策 (建奇迹 -> 摧毁 / 陵墓 -> 科技标记)
+
+        /**
+         * @brief 廉价的着法排序分数：建造优先于弃牌，分高、便宜的优先
+         */
+        int orderScore(const LegalAction& la, const GameModel& model) {
+            const Action& a = la.action;
+            switch (a.type) {
+                case ActionType::BUILD_WONDER: {
+                    const Wonder* w = model.getWonder(a.targetWonder);
+                    return 300 + (w ? 10 * w->getStaticVictoryPoints() : 0) - la.cost;
+                }
+                case ActionType::BUILD_CARD: {
+                    const Card* c = model.getCard(a.targetCard);
+                    return 200 + (c ? 10 * c->getStaticVictoryPoints() : 0) - la.cost;
+                }
+                case ActionType::DISCARD_FOR_COINS:
+                    return 0;
+                default:
+                    return 100;
+            }
+        }
+    }
+
+    // ==========================================================
+    //  EndgameSolver
+    // ==========================================================
+
+    EndgameSolver::EndgameSolver(double timeLimitMs) : m_timeLimitMs(timeLimitMs) {}
+
+    EndgameSolver::~EndgameSolver() = default;
+
+    bool EndgameSolver::isApplicable(const GameController& state, int maxCards) {
+        if (state.getState() == GameState::GAME_OVER) return false;
+        const GameModel& model = state.getModel();
+        if (model.getCurrentAge() != 3) return false;
+        return model.getBoard()->getCardStructure().getRemainingCount() <= maxCards;
+    }
+
+    EndgameResult EndgameSolver::solve(const GameController& root) {
+        auto start = Clock::now();
+        m_result = EndgameResult();
+        if (!isApplicable(root, Config::PYRAMID_SLOTS)) return m_result;
+
+        if (m_memo.size() > m_maxMemoEntries) m_memo.clear();
+
+        int remaining = root.getModel().getBoard()->getCardStructure().getRemainingCount();
+        ensureDepth(static_cast<size_t>(remaining * PLIES_PER_CARD + 8), root);
+        m_stack[0]->copyFrom(root);
+        root.generateLegalActions(m_moves[0]);
+        if (m_moves[0].empty()) return m_result;
+
+        m_timed = m_timeLimitMs > 0.0;
+        m_deadline = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(m_timeLimitMs));
+        m_aborted = false;
+        m_rootBest = -1;
+
+        double value = search(0, -INF, INF);
+
+        m_result.memoEntries = m_memo.size();
+        m_result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        if (m_aborted || m_rootBest < 0) return m_result;
+
+        m_result.solved = true;
+        m_result.bestMove = m_moves[0][m_rootBest].action;
+        m_result.margin = root.getModel().getCurrentPlayerIndex() == 0 ? value : -value;
+        return m_result;
+    }
+
+    void EndgameSolver::ensureDepth(size_t plies, const GameController& root) {
+        if (m_stack.size() < plies) {
+            m_stack.resize(plies);
+            m_moves.resize(plies);
+            m_order.resize(plies);
+            m_unseenAge.resize(plies);
+            m_unseenGuilds.resize(plies);
+            m_revealSlots.resize(plies);
+            m_revealCards.resize(plies);
+        }
+        for (auto& s : m_stack) if (!s) s = root.clone();
+    }
+
+    double EndgameSolver::search(int ply, double alpha, double beta) {
+        GameController& state = *m_stack[ply];
+        m_result.nodes++;
+
+        if (state.getState() == GameState::GAME_OVER) return terminalValue(state);
+        if (m_timed && m_result.nodes % CLOCK_CHECK_INTERVAL == 0 && Clock::now() >= m_deadline) {
+            m_aborted = true;
+            return 0.0;
+        }
+        // 连续决策超出预留层数说明局面异常，放弃求解而不是越界
+        if (static_cast<size_t>(ply) + 1 >= m_stack.size()) {
+            m_aborted = true;
+            return 0.0;
+        }
+
+        std::uint64_t key = Zobrist::hideFaceDownCards(state.getStateHash(), state.getModel().getBoard()->getCardStructure());
+        int memoMove = -1;
+        auto it = m_memo.find(key);
+        if (it != m_memo.end()) {
+            const MemoEntry& e = it->second;
+            memoMove = e.move;
+            // 根节点总是完整搜索，以便得到最佳动作
+            if (ply > 0 && (e.bound == Bound::EXACT ||
+                            (e.bound == Bound::LOWER && e.value >= beta) ||
+                            (e.bound == Bound::UPPER && e.value <= alpha))) {
+                m_result.memoHits++;
+                return e.value;
+            }
+        }
+
+        if (ply > 0) state.generateLegalActions(m_moves[ply]);
+        if (m_moves[ply].empty()) return terminalValue(state);
+        orderMoves(ply, memoMove);
+
+        bool maximizing = state.getModel().getCurrentPlayerIndex() == 0;
+        double origAlpha = alpha, origBeta = beta;
+        double best = maximizing ? -INF : INF;
+        int bestMove = m_order[ply][0];
+
+        for (int i : m_order[ply]) {
+            double v = searchAction(ply, i, alpha, beta);
+            if (m_aborted) return 0.0;
+
+            if (maximizing ? v > best : v < best) {
+                best = v;
+                bestMove = i;
+            }
+            if (maximizing) alpha = std::max(alpha, best);
+            else beta = std::min(beta, best);
+            if (alpha >= beta) break;
+        }
+
+        Bound bound = best <= origAlpha ? Bound::UPPER : (best >= origBeta ? Bound::LOWER : Bound::EXACT);
+        m_memo[key] = MemoEntry{best, bound, static_cast<std::uint8_t>(std::min(bestMove, 0xFF))};
+        if (ply == 0) m_rootBest = bestMove;
+        return best;
+    }
+
+    double EndgameSolver::searchAction(int ply, int moveIndex, double alpha, double beta) {
+        const GameController& parent = *m_stack[ply];
+        GameController& child = *m_stack[ply + 1];
+        const Action action = m_moves[ply][moveIndex].action;
+
+        child.copyFrom(parent);
+        if (!child.processAction(action)) return terminalValue(parent);
+
+        const CardPyramid& before = parent.getModel().getBoard()->getCardStructure();
+        CardPyramid::SlotMask revealed = child.getModel().getBoard()->getCardStructure().getFaceUpMask() & ~before.getFaceUpMask();
+        if (revealed == 0 || child.getModel().getCurrentAge() != 3) return search(ply + 1, alpha, beta);
+
+        // 机会节点：被翻开的牌面在公开信息下的每种可能都搜索一遍，按概率加权
+        std::vector<int>& slots = m_revealSlots[ply];
+        slots.clear();
+        int hidden = 0;
+        for (int i = 0; i < before.getSlotCount(); ++i) {
+            if (before.isRemoved(i) || before.isFaceUp(i)) continue;
+            hidden++;
+            if ((revealed >> i) & 1u) slots.push_back(i);
+        }
+
+        Determinizer::collectUnseenCards(parent.getModel(), m_unseenAge[ply], m_unseenGuilds[ply]);
+        int hiddenGuilds = static_cast<int>(Determinizer::hiddenGuildCount(parent.getModel(), m_unseenGuilds[ply].size(), hidden));
+        m_revealCards[ply].clear();
+        return expectReveal(ply, action, 0, hidden, hiddenGuilds);
+    }
+
+    double EndgameSolver::expectReveal(int ply, const Action& action, size_t next, int hidden, int hiddenGuilds) {
+        const std::vector<int>& slots = m_revealSlots[ply];
+        std::vector<const Card*>& chosen = m_revealCards[ply];
+
+        if (next == slots.size()) {
+            GameController& child = *m_stack[ply + 1];
+            child.copyFrom(*m_stack[ply]);
+            for (size_t k = 0; k < slots.size(); ++k) Determinizer::placeHiddenCard(child, slots[k], chosen[k]);
+            child.processAction(action);
+            return search(ply + 1, -INF, INF);
+        }
+
+        int chosenGuilds = 0;
+        for (const Card* c : chosen) if (c->getType() == CardType::GUILD) chosenGuilds++;
+        int h = hidden - static_cast<int>(next);
+        int g = hiddenGuilds - chosenGuilds;
+
+        // 剩余 h 个背面卡槽中恰有 g 张公会：该槽为某张公会的概率 g/h/|公会候选|，其余卡同理
+        double sum = 0.0;
+        auto expand = [&](const std::vector<const Card*>& pool, int slotsOfKind) {
+            if (slotsOfKind <= 0) return;
+            int candidates = 0;
+            for (const Card* c : pool) if (std::find(chosen.begin(), chosen.end(), c) == chosen.end()) candidates++;
+            if (candidates == 0) return;
+            double p = static_cast<double>(slotsOfKind) / h / candidates;
+            for (size_t i = 0; i < pool.size() && !m_aborted; ++i) {
+                const Card* c = pool[i];
+                if (std::find(chosen.begin(), chosen.end(), c) != chosen.end()) continue;
+                chosen.push_back(c);
+                sum += p * expectReveal(ply, action, next + 1, hidden, hiddenGuilds);
+                chosen.pop_back();
+            }
+        };
+        expand(m_unseenGuilds[ply], g);
+        expand(m_unseenAge[ply], h - g);
+        return m_aborted ? 0.0 : sum;
+    }
+
+    void EndgameSolver::orderMoves(int ply, int memoMove) {
+        const std::vector<LegalAction>& moves = m_moves[ply];
+        const GameModel& model = m_stack[ply]->getModel();
+        std::vector<int>& order = m_order[ply];
+
+        order.resize(moves.size());
+        for (size_t i = 0; i < moves.size(); ++i) order[i] = static_cast<int>(i);
+        std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+            return orderScore(moves[a], model) > orderScore(moves[b], model);
+        });
+
+        if (memoMove >= 0 && memoMove < static_cast<int>(moves.size())) {
+            auto it = std::find(order.begin(), order.end(), memoMove);
+            std::rotate(order.begin(), it, it + 1);
+        }
+    }
+
+    double EndgameSolver::terminalValue(const GameController& state) {
+        const GameModel& model = state.getModel();
+        int winner = model.getWinnerIndex();
+        if (state.getState() == GameState::GAME_OVER && model.getVictoryType() != VictoryType::CIVILIAN) {
+            if (winner < 0) return 0.0;
+            return winner == 0 ? INSTANT_WIN_MARGIN : -INSTANT_WIN_MARGIN;
+        }
+
+        const Player& p0 = *model.getPlayers()[0];
+        const Player& p1 = *model.getPlayers()[1];
+        double margin = p0.getScore(p1) - p1.getScore(p0);
+        if (margin == 0.0 && winner >= 0 && state.getState() == GameState::GAME_OVER) {
+            margin = winner == 0 ? TIE_BREAK_MARGIN : -TIE_BREAK_MARGIN;
+        }
+        return margin;
+    }
+
+    // ==========================================================
+    //  EndgameAgent
+    // ==========================================================
+
+    EndgameAgent::EndgameAgent(std::unique_ptr<IPlayerAgent> inner, int exactBelowCards, double timeLimitMs, bool showThinking)
+        : m_inner(std::move(inner)), m_exactBelowCards(exactBelowCards), m_showThinking(showThinking), m_solver(timeLimitMs) {}
+
+    Action EndgameAgent::decideAction(GameController& game, GameView& view, InputManager& input) {
+        m_lastResult = EndgameResult();
+        if (EndgameSolver::isApplicable(game, m_exactBelowCards)) {
+            m_lastResult = m_solver.solve(game);
+            if (m_lastResult.solved) {
+                if (m_showThinking) {
+                    std::cout << "\033[1;33m[Endgame] 精确求解: 期望分差 " << std::fixed << std::setprecision(2) << m_lastResult.margin
+                              << ", " << m_lastResult.nodes << " 节点, 记忆表 " << m_lastResult.memoEntries << " 条, "
+                              << std::setprecision(1) << 1000.0 * m_lastResult.seconds << " ms\033[0m" << std::endl;
+                }
+                return m_lastResult.bestMove;
+            }
+        }
+        return m_inner->decideAction(game, view, input);
+    }
+
+}
@@ -5,39 +5,78 @@
 
 namespace SevenWondersDuel {
 
+    namespace {
+        // 元素在容器中的位置 (未找到时为 -1)，撤销时按原位置放回
+        template <typename Container, typename Pred>
+        int indexOf(const Container& items, Pred pred) {
+            auto it = std::find_if(items.begin(), items.end(), pred);
+            return it == items.end() ? -1 : static_cast<int>(it - items.begin());
+        }
+    }
+
     std::unique_ptr<IGameCommand> CommandFactory::createCommand(const Action& action) {
         switch (action.type) {
-            case ActionType::DRAFT_WONDER: return std::make_unique<DraftWonderCommand>(action.targetWonderId);
-            case ActionType::BUILD_CARD: return std::make_unique<BuildCardCommand>(action.targetCardId);
-            case ActionType::DISCARD_FOR_COINS: return std::make_unique<DiscardCardCommand>(action.targetCardId);
-            case ActionType::BUILD_WONDER: return std::make_unique<BuildWonderCommand>(action.targetCardId, action.targetWonderId);
+            case ActionType::DRAFT_WONDER: return std::make_unique<DraftWonderCommand>(action.targetWonder);
+            case ActionType::BUILD_CARD: return std::make_unique<BuildCardCommand>(action.targetCard);
+            case ActionType::DISCARD_FOR_COINS: return std::make_unique<DiscardCardCommand>(action.targetCard);
+            case ActionType::BUILD_WONDER: return std::make_unique<BuildWonderCommand>(action.targetCard, action.targetWonder);
             case ActionType::SELECT_PROGRESS_TOKEN: return std::make_unique<SelectProgressTokenCommand>(action.selectedToken);
-            case ActionType::SELECT_DESTRUCTION: return std::make_unique<DestructionCommand>(action.targetCardId);
-            case ActionType::SELECT_FROM_DISCARD: return std::make_unique<SelectFromDiscardCommand>(action.targetCardId);
-            case ActionType::CHOOSE_STARTING_PLAYER: return std::make_unique<ChooseStartingPlayerCommand>(action.targetCardId);
+            case ActionType::SELECT_DESTRUCTION: return std::make_unique<DestructionCommand>(action.targetCard);
+            case ActionType::SELECT_FROM_DISCARD: return std::make_unique<SelectFromDiscardCommand>(action.targetCard);
+            case ActionType::CHOOSE_STARTING_PLAYER: return std::make_unique<ChooseStartingPlayerCommand>(action.chooseSelf);
             default: return nullptr;
         }
     }
 
+    bool CommandFactory::executeCommand(GameController& controller, const Action& action) {
+        switch (action.type) {
+            case ActionType::DRAFT_WONDER: DraftWonderCommand(action.targetWonder).execute(controller); return true;
+            case ActionType::BUILD_CARD: BuildCardCommand(action.targetCard).execute(controller); return true;
+            case ActionType::DISCARD_FOR_COINS: DiscardCardCommand(action.targetCard).execute(controller); return true;
+            case ActionType::BUILD_WONDER: BuildWonderCommand(action.targetCard, action.targetWonder).execute(controller); return true;
+            case ActionType::SELECT_PROGRESS_TOKEN: SelectProgressTokenCommand(action.selectedToken).execute(controller); return true;
+            case ActionType::SELECT_DESTRUCTION: DestructionCommand(action.targetCard).execute(controller); return true;
+            case ActionType::SELECT_FROM_DISCARD: SelectFromDiscardCommand(action.targetCard).execute(controller); return true;
+            case ActionType::CHOOSE_STARTING_PLAYER: ChooseStartingPlayerCommand(action.chooseSelf).execute(controller); return true;
+            default: return false;
+        }
+    }
+
+    void CommandFactory::undoCommand(GameController& controller, const UndoRecord& record) {
+        const Action& action = record.action;
+        switch (action.type) {
+            case ActionType::DRAFT_WONDER: DraftWonderCommand(action.targetWonder).undo(controller, record); break;
+            case ActionType::BUILD_CARD: BuildCardCommand(action.targetCard).undo(controller, record); break;
+            case ActionType::DISCARD_FOR_COINS: DiscardCardCommand(action.targetCard).undo(controller, record); break;
+            case ActionType::BUILD_WONDER: BuildWonderCommand(action.targetCard, action.targetWonder).undo(controller, record); break;
+            case ActionType::SELECT_PROGRESS_TOKEN: SelectProgressTokenCommand(action.selectedToken).undo(controller, record); break;
+            case ActionType::SELECT_DESTRUCTION: DestructionCommand(action.targetCard).undo(controller, record); break;
+            case ActionType::SELECT_FROM_DISCARD: SelectFromDiscardCommand(action.targetCard).undo(controller, record); break;
+            case ActionType::CHOOSE_STARTING_PLAYER: ChooseStartingPlayerCommand(action.chooseSelf).undo(controller, record); break;
+            default: break;
+        }
+    }
+
     // ==========================================================
     //  DraftWonderCommand
     // ==========================================================
 
-    DraftWonderCommand::DraftWonderCommand(std::string id) : wonderId(std::move(id)) {}
+    DraftWonderCommand::DraftWonderCommand(WonderIndex w) : wonder(w) {}
 
     void DraftWonderCommand::execute(GameController& controller) {
         auto& model = *controller.m_model;
         Player* currPlayer = model.getCurrentPlayerMut();
 
         auto& pool = model.getDraftPool();
-        auto it = std::find_if(pool.begin(), pool.end(), [&](Wonder* w){ return w->getId() == wonderId; });
+        auto it = std::find_if(pool.begin(), pool.end(), [&](const Wonder* w){ return w->getIndex() == wonder; });
 
         if (it != pool.end()) {
-            Wonder* w = *it;
+            if (controller.m_recording) controller.m_recording->position = static_cast<int>(it - pool.begin());
+            const Wonder* w = *it;
             currPlayer->addUnbuiltWonder(w);
-            model.removeFromDraftPool(w->getId());
+            model.removeFromDraftPool(w->getIndex());
 
-            model.addLog("[" + currPlayer->getName() + "] drafted wonder: " + w->getName());
+            if (model.isLogEnabled()) model.addLog("[" + currPlayer->getName() + "] drafted wonder: " + w->getName());
 
             bool shouldSwitch = true;
             if (controller.m_draftTurnCount == 1) shouldSwitch = false;
@@ -50,7 +89,7 @@ namespace SevenWondersDuel {
                     controller.dealWondersToDraft();
                     controller.m_draftTurnCount = 0;
                     model.setCurrentPlayerIndex(1);
-                    model.addLog("[System] Wonder Draft Phase 2 Begins. Player 2 starts.");
+                    if (model.isLogEnabled()) model.addLog("[System] Wonder Draft Phase 2 Begins. Player 2 starts.");
                 } else {
                     controller.setupAge(1);
                     model.setCurrentPlayerIndex(0);
@@ -63,37 +102,43 @@ namespace SevenWondersDuel {
         }
     }
 
+    void DraftWonderCommand::undo(GameController& controller, const UndoRecord& record) {
+        if (record.position < 0) return;
+        auto& model = *controller.m_model;
+        model.getPlayers()[record.currentPlayer]->removeUnbuiltWonder(wonder);
+        model.insertIntoDraftPool(record.position, model.getWonder(wonder));
+    }
+
     // ==========================================================
     //  BuildCardCommand
     // ==========================================================
 
-    BuildCardCommand::BuildCardCommand(std::string id) : cardId(std::move(id)) {}
+    BuildCardCommand::BuildCardCommand(CardIndex c) : card(c) {}
 
     void BuildCardCommand::execute(GameController& controller) {
         auto& model = *controller.m_model;
         Player* currPlayer = model.getCurrentPlayerMut();
         Player* opponent = model.getOpponentMut();
-        Card* targetCard = controller.findCardInPyramid(cardId);
+        const Card* targetCard = controller.findCardInPyramid(card);
 
         auto costInfo = currPlayer->calculateCost(targetCard->getCost(), *opponent, targetCard->getType());
         
         bool isChain = false;
-        if (!targetCard->getRequiresChainTag().empty() &&
-            currPlayer->getOwnedChainTags().count(targetCard->getRequiresChainTag())) {
+        if (currPlayer->hasChainFor(targetCard)) {
             costInfo.second = 0;
             isChain = true;
         }
 
         currPlayer->payCoins(costInfo.second);
 
-        model.getBoardMut()->removeCardFromPyramid(targetCard->getId());
+        model.getBoardMut()->removeCardFromPyramid(targetCard->getIndex());
         currPlayer->constructCard(targetCard);
 
-        model.addLog("[" + currPlayer->getName() + "] built " + targetCard->getName());
+        if (model.isLogEnabled()) model.addLog("[" + currPlayer->getName() + "] built " + targetCard->getName());
 
-        if (isChain && currPlayer->getProgressTokens().count(ProgressToken::URBANISM)) {
+        if (isChain && currPlayer->hasProgressToken(ProgressToken::URBANISM)) {
             currPlayer->gainCoins(Config::URBANISM_CHAIN_BONUS);
-            model.addLog("[Effect] Urbanism: +4 coins from chain build.");
+            if (model.isLogEnabled()) model.addLog("[Effect] Urbanism: +4 coins from chain build.");
         }
 
         for(auto& eff : targetCard->getEffects()) {
@@ -109,63 +154,83 @@ namespace SevenWondersDuel {
         }
     }
 
+    void BuildCardCommand::undo(GameController& controller, const UndoRecord& record) {
+        auto& model = *controller.m_model;
+        Player* player = model.getPlayers()[record.currentPlayer].get();
+        const Card* built = model.getCard(card);
+        for (auto& eff : built->getEffects()) eff->revertPassive(player);
+        player->removeCard(card);
+    }
+
     // ==========================================================
     //  DiscardCardCommand
     // ==========================================================
 
-    DiscardCardCommand::DiscardCardCommand(std::string id) : cardId(std::move(id)) {}
+    DiscardCardCommand::DiscardCardCommand(CardIndex c) : card(c) {}
 
     void DiscardCardCommand::execute(GameController& controller) {
         auto& model = *controller.m_model;
         Player* currPlayer = model.getCurrentPlayerMut();
-        Card* targetCard = controller.findCardInPyramid(cardId);
+        const Card* targetCard = controller.findCardInPyramid(card);
 
-        model.getBoardMut()->removeCardFromPyramid(targetCard->getId());
+        model.getBoardMut()->removeCardFromPyramid(targetCard->getIndex());
         model.getBoardMut()->addToDiscardPile(targetCard);
 
         int gain = Config::BASE_DISCARD_GAIN + currPlayer->getCardCount(CardType::COMMERCIAL);
         currPlayer->gainCoins(gain);
 
-        model.addLog("[" + currPlayer->getName() + "] discarded " + targetCard->getName() + " (+ " + std::to_string(gain) + " coins)");
+        if (model.isLogEnabled()) model.addLog("[" + currPlayer->getName() + "] discarded " + targetCard->getName() + " (+ " + std::to_string(gain) + " coins)");
 
         controller.onTurnEnd();
     }
 
+    void DiscardCardCommand::undo(GameController& controller, const UndoRecord& record) {
+        controller.m_model->getBoardMut()->removeCardFromDiscardPile(card);
+    }
+
     // ==========================================================
     //  BuildWonderCommand
     // ==========================================================
 
-    BuildWonderCommand::BuildWonderCommand(std::string cid, std::string wid) : cardId(std::move(cid)), wonderId(std::move(wid)) {}
+    BuildWonderCommand::BuildWonderCommand(CardIndex c, WonderIndex w) : card(c), wonder(w) {}
 
     void BuildWonderCommand::execute(GameController& controller) {
         auto& model = *controller.m_model;
         Player* currPlayer = model.getCurrentPlayerMut();
         Player* opponent = model.getOpponentMut();
-        Card* pyramidCard = controller.findCardInPyramid(cardId);
-        Wonder* wonder = controller.findWonderInHand(currPlayer, wonderId);
+        const Card* pyramidCard = controller.findCardInPyramid(card);
+        const Wonder* target = controller.findWonderInHand(currPlayer, wonder);
 
-        auto costInfo = currPlayer->calculateCost(wonder->getCost(), *opponent, CardType::WONDER);
+        auto costInfo = currPlayer->calculateCost(target->getCost(), *opponent, CardType::WONDER);
         currPlayer->payCoins(costInfo.second);
 
-        model.getBoardMut()->removeCardFromPyramid(pyramidCard->getId());
-        currPlayer->constructWonder(wonder->getId(), pyramidCard);
+        model.getBoardMut()->removeCardFromPyramid(pyramidCard->getIndex());
+        if (controller.m_recording) controller.m_recording->position = currPlayer->findUnbuiltWonder(target->getIndex());
+        currPlayer->constructWonder(target->getIndex(), pyramidCard);
 
-        model.addLog("[" + currPlayer->getName() + "] built WONDER: " + wonder->getName() + "!");
+        if (model.isLogEnabled()) model.addLog("[" + currPlayer->getName() + "] built WONDER: " + target->getName() + "!");
 
-        for(auto& eff : wonder->getEffects()) {
+        for(auto& eff : target->getEffects()) {
             eff->apply(currPlayer, opponent, &controller, &controller);
         }
 
-        int totalBuilt = model.getPlayers()[0]->getBuiltWonders().size() + model.getPlayers()[1]->getBuiltWonders().size();
+        int totalBuilt = model.getPlayers()[0]->getBuiltWonderCount() + model.getPlayers()[1]->getBuiltWonderCount();
         if (totalBuilt == Config::MAX_TOTAL_WONDERS) {
-            model.addLog("[System] 7 Wonders built! The 8th wonder is removed.");
+            if (model.isLogEnabled()) model.addLog("[System] 7 Wonders built! The 8th wonder is removed.");
+            if (UndoRecord* rec = controller.m_recording) {
+                for (int i = 0; i < 2; ++i) {
+                    for (const Wonder* w : model.getPlayers()[i]->getUnbuiltWonders()) {
+                        rec->clearedWonders[i][rec->clearedWonderCount[i]++] = w;
+                    }
+                }
+            }
             model.getPlayers()[0]->clearUnbuiltWonders();
             model.getPlayers()[1]->clearUnbuiltWonders();
         }
 
-        if (currPlayer->getProgressTokens().count(ProgressToken::THEOLOGY)) {
+        if (currPlayer->hasProgressToken(ProgressToken::THEOLOGY)) {
              controller.grantExtraTurn();
-             model.addLog("[Effect] Theology Token grants an Extra Turn!");
+             if (model.isLogEnabled()) model.addLog("[Effect] Theology Token grants an Extra Turn!");
         }
 
         if (controller.checkForNewSciencePairs(currPlayer)) {
@@ -177,6 +242,19 @@ namespace SevenWondersDuel {
         }
     }
 
+    void BuildWonderCommand::undo(GameController& controller, const UndoRecord& record) {
+        auto& model = *controller.m_model;
+        for (int i = 0; i < 2; ++i) {
+            for (int k = 0; k < record.clearedWonderCount[i]; ++k) {
+                model.getPlayers()[i]->addUnbuiltWonder(record.clearedWonders[i][k]);
+            }
+        }
+        Player* player = model.getPlayers()[record.currentPlayer].get();
+        const Wonder* built = model.getWonder(wonder);
+        for (auto& eff : built->getEffects()) eff->revertPassive(player);
+        player->unconstructWonder(wonder, record.position);
+    }
+
     // ==========================================================
     //  SelectProgressTokenCommand
     // ==========================================================
@@ -187,20 +265,25 @@ namespace SevenWondersDuel {
         auto& model = *controller.m_model;
         Player* currPlayer = model.getCurrentPlayerMut();
 
+        auto isToken = [&](ProgressToken t) { return t == token; };
         bool success = false;
+        int position = -1;
         if (controller.m_currentState == GameState::WAITING_FOR_TOKEN_SELECTION_PAIR) {
+            position = indexOf(model.getBoard()->getAvailableProgressTokens(), isToken);
             success = model.getBoardMut()->removeAvailableProgressToken(token);
         } else if (controller.m_currentState == GameState::WAITING_FOR_TOKEN_SELECTION_LIB) {
+            position = indexOf(model.getBoard()->getBoxProgressTokens(), isToken);
             success = model.getBoardMut()->removeBoxProgressToken(token);
         }
 
         if (success) {
+            if (controller.m_recording) controller.m_recording->position = position;
             currPlayer->addProgressToken(token);
-            model.addLog("[" + currPlayer->getName() + "] selected a Progress Token.");
+            if (model.isLogEnabled()) model.addLog("[" + currPlayer->getName() + "] selected a Progress Token.");
 
             if (token == ProgressToken::URBANISM) {
                 currPlayer->gainCoins(Config::URBANISM_TOKEN_BONUS);
-                model.addLog("[Effect] Urbanism: +6 coins immediately.");
+                if (model.isLogEnabled()) model.addLog("[Effect] Urbanism: +6 coins immediately.");
             }
 
             controller.setState(GameState::AGE_PLAY_PHASE);
@@ -215,57 +298,81 @@ namespace SevenWondersDuel {
         }
     }
 
+    void SelectProgressTokenCommand::undo(GameController& controller, const UndoRecord& record) {
+        if (record.position < 0) return;
+        auto& model = *controller.m_model;
+        model.getPlayers()[record.currentPlayer]->removeProgressToken(token);
+        if (record.state == GameState::WAITING_FOR_TOKEN_SELECTION_PAIR) {
+            model.getBoardMut()->insertAvailableProgressToken(record.position, token);
+        } else {
+            model.getBoardMut()->insertBoxProgressToken(record.position, token);
+        }
+    }
+
     // ==========================================================
     //  DestructionCommand
     // ==========================================================
 
-    DestructionCommand::DestructionCommand(std::string tid) : targetId(std::move(tid)) {}
+    DestructionCommand::DestructionCommand(CardIndex t) : target(t) {}
 
     void DestructionCommand::execute(GameController& controller) {
         auto& model = *controller.m_model;
-        if (targetId.empty()) {
-            model.addLog("[System] Destruction skipped.");
+        if (target == NO_CARD) {
+            if (model.isLogEnabled()) model.addLog("[System] Destruction skipped.");
             controller.setState(GameState::AGE_PLAY_PHASE);
             controller.onTurnEnd();
             return;
         }
 
         Player* opponent = model.getOpponentMut();
-        Card* target = nullptr;
-        for(auto c : opponent->getBuiltCards()) {
-            if (c->getId() == targetId) {
-                target = c; break;
+        const Card* targetCard = nullptr;
+        for(auto c : opponent->getAllCards()) {
+            if (c->getIndex() == target) {
+                targetCard = c; break;
             }
         }
 
-        if (target) {
-             model.getBoardMut()->destroyCard(opponent, target->getType());
-             model.addLog("[System] " + opponent->getName() + "'s card " + target->getName() + " destroyed.");
+        if (targetCard) {
+             if (controller.m_recording) controller.m_recording->position = opponent->findBuiltCard(target);
+             model.getBoardMut()->destroyCard(opponent, targetCard->getIndex());
+             if (model.isLogEnabled()) model.addLog("[System] " + opponent->getName() + "'s card " + targetCard->getName() + " destroyed.");
         }
 
         controller.setState(GameState::AGE_PLAY_PHASE);
         controller.onTurnEnd();
     }
 
+    void DestructionCommand::undo(GameController& controller, const UndoRecord& record) {
+        if (target == NO_CARD || record.position < 0) return;
+        auto& model = *controller.m_model;
+        Player* opponent = model.getPlayers()[1 - record.currentPlayer].get();
+        const Card* destroyed = model.getBoardMut()->removeCardFromDiscardPile(target);
+        if (!destroyed) return;
+        opponent->insertCard(destroyed, record.position);
+        for (auto& eff : destroyed->getEffects()) eff->applyPassive(opponent);
+    }
+
     // ==========================================================
     //  SelectFromDiscardCommand
     // ==========================================================
 
-    SelectFromDiscardCommand::SelectFromDiscardCommand(std::string id) : cardId(std::move(id)) {}
+    SelectFromDiscardCommand::SelectFromDiscardCommand(CardIndex c) : card(c) {}
 
     void SelectFromDiscardCommand::execute(GameController& controller) {
         auto& model = *controller.m_model;
         Player* currPlayer = model.getCurrentPlayerMut();
         Player* opponent = model.getOpponentMut();
 
-        Card* card = model.getBoardMut()->removeCardFromDiscardPile(cardId);
+        int position = indexOf(model.getBoard()->getDiscardPile(), [&](const Card* c) { return c->getIndex() == card; });
+        const Card* resurrected = model.getBoardMut()->removeCardFromDiscardPile(card);
 
-        if (card) {
-            currPlayer->constructCard(card);
+        if (resurrected) {
+            if (controller.m_recording) controller.m_recording->position = position;
+            currPlayer->constructCard(resurrected);
 
-            model.addLog("[" + currPlayer->getName() + "] resurrected " + card->getName() + " from discard!");
+            if (model.isLogEnabled()) model.addLog("[" + currPlayer->getName() + "] resurrected " + resurrected->getName() + " from discard!");
 
-            for(auto& eff : card->getEffects()) {
+            for(auto& eff : resurrected->getEffects()) {
                 eff->apply(currPlayer, opponent, &controller, &controller);
             }
 
@@ -278,27 +385,41 @@ namespace SevenWondersDuel {
         controller.onTurnEnd();
     }
 
+    void SelectFromDiscardCommand::undo(GameController& controller, const UndoRecord& record) {
+        if (record.position < 0) return;
+        auto& model = *controller.m_model;
+        Player* player = model.getPlayers()[record.currentPlayer].get();
+        const Card* resurrected = model.getCard(card);
+        for (auto& eff : resurrected->getEffects()) eff->revertPassive(player);
+        player->removeCard(card);
+        model.getBoardMut()->insertIntoDiscardPile(record.position, resurrected);
+    }
+
     // ==========================================================
     //  ChooseStartingPlayerCommand
     // ==========================================================
 
-    ChooseStartingPlayerCommand::ChooseStartingPlayerCommand(std::string tid) : targetId(std::move(tid)) {}
+    ChooseStartingPlayerCommand::ChooseStartingPlayerCommand(bool self) : chooseSelf(self) {}
 
     void ChooseStartingPlayerCommand::execute(GameController& controller) {
         auto& model = *controller.m_model;
         Player* curr = model.getCurrentPlayerMut();
 
         int nextStarter = -1;
-        if (targetId == "ME") {
+        if (chooseSelf) {
             nextStarter = model.getCurrentPlayerIndex();
-            model.addLog(curr->getName() + " chose to go first.");
+            if (model.isLogEnabled()) model.addLog(curr->getName() + " chose to go first.");
         } else {
             nextStarter = 1 - model.getCurrentPlayerIndex();
-            model.addLog(curr->getName() + " chose opponent to go first.");
+            if (model.isLogEnabled()) model.addLog(curr->getName() + " chose opponent to go first.");
         }
 
         controller.setupAge(model.getCurrentAge() + 1);
         model.setCurrentPlayerIndex(nextStarter);
     }
 
+    void ChooseStartingPlayerCommand::undo(GameController& controller, const UndoRecord& record) {
+        // 只改变了时代、先手与金字塔，均由控制器按记录恢复
+    }
+
 }
\ No newline at end of file
@@ -3,46 +3,79 @@
 #include "ScoringManager.h"
 #include "GameStateLogic.h"
 #include "GameCommands.h"
-#include "GameFactory.h"
 #include <algorithm>
-#include <random>
+#include <cassert>
 #include <chrono>
 
 namespace SevenWondersDuel {
 
     GameController::GameController() {
-        auto seed = std::chrono::high_resolution_clock::now().time_since_epoch().count();
-        m_rng.seed(seed);
+        setSeed(static_cast<std::uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count()));
         m_model = std::make_unique<GameModel>();
         updateStateLogic(GameState::WONDER_DRAFT_PHASE_1);
     }
 
     GameController::~GameController() = default;
 
+    std::unique_ptr<GameController> GameController::clone() const {
+        auto copy = std::make_unique<GameController>();
+        copy->m_model->setLogEnabled(false);
+        copy->copyFrom(*this);
+        return copy;
+    }
+
+    void GameController::copyFrom(const GameController& other) {
+        if (this == &other) return;
+        m_model->copyFrom(*other.m_model);
+        m_model->clearLog();
+        m_undoDepth = 0;
+
+        if (!m_stateLogic || m_currentState != other.m_currentState) {
+            m_currentState = other.m_currentState;
+            updateStateLogic(m_currentState);
+        }
+
+        m_extraTurnPending = other.m_extraTurnPending;
+        m_draftTurnCount = other.m_draftTurnCount;
+        m_gameSeed = other.m_gameSeed;
+        m_deckRng = other.m_deckRng;
+        m_tokenRng = other.m_tokenRng;
+        m_pendingDestructionType = other.m_pendingDestructionType;
+    }
+
     void GameController::updateStateLogic(GameState newState) {
+        // 状态逻辑对象不持有数据，所有控制器共享同一组实例，切换状态无需分配
+        static WonderDraftState s_wonderDraft;
+        static AgePlayState s_agePlay;
+        static TokenSelectionState s_tokenSelection;
+        static DestructionState s_destruction;
+        static DiscardBuildState s_discardBuild;
+        static StartPlayerSelectionState s_startPlayerSelection;
+        static GameOverState s_gameOver;
+
         switch (newState) {
             case GameState::WONDER_DRAFT_PHASE_1:
             case GameState::WONDER_DRAFT_PHASE_2:
-                m_stateLogic = std::make_unique<WonderDraftState>();
+                m_stateLogic = &s_wonderDraft;
                 break;
             case GameState::AGE_PLAY_PHASE:
-                m_stateLogic = std::make_unique<AgePlayState>();
+                m_stateLogic = &s_agePlay;
                 break;
             case GameState::WAITING_FOR_TOKEN_SELECTION_PAIR:
             case GameState::WAITING_FOR_TOKEN_SELECTION_LIB:
-                m_stateLogic = std::make_unique<TokenSelectionState>();
+                m_stateLogic = &s_tokenSelection;
                 break;
             case GameState::WAITING_FOR_DESTRUCTION:
-                m_stateLogic = std::make_unique<DestructionState>();
+                m_stateLogic = &s_destruction;
                 break;
             case GameState::WAITING_FOR_DISCARD_BUILD:
-                m_stateLogic = std::make_unique<DiscardBuildState>();
+                m_stateLogic = &s_discardBuild;
                 break;
             case GameState::WAITING_FOR_START_PLAYER_SELECTION:
-                m_stateLogic = std::make_unique<StartPlayerSelectionState>();
+                m_stateLogic = &s_startPlayerSelection;
                 break;
             case GameState::GAME_OVER:
-                m_stateLogic = std::make_unique<GameOverState>();
+                m_stateLogic = &s_gameOver;
                 break;
         }
         if (m_stateLogic) {
@@ -52,26 +85,28 @@ namespace SevenWondersDuel {
 
 
     void GameController::initializeGame(const std::string& jsonPath, const std::string& p1Name, const std::string& p2Name) {
-        // Use Factory to load data
-        BaseGameFactory factory(jsonPath);
-        
-        m_model->populateData(factory.createCards(), factory.createWonders());
-
-        m_model->clearPlayers();
-        m_model->addPlayer(std::make_unique<Player>(0, p1Name));
-        m_model->addPlayer(std::make_unique<Player>(1, p2Name));
-
-        m_model->setCurrentAge(0);
-        m_model->setCurrentPlayerIndex(0);
-        m_model->setWinnerIndex(-1);
-        m_model->setVictoryType(VictoryType::NONE);
-        m_model->clearLog();
+        initializeGame(CardDatabase::load(jsonPath), p1Name, p2Name);
+    }
+
+    void GameController::initializeGame(std::shared_ptr<const CardDatabase> database, const std::string& p1Name, const std::string& p2Name) {
+        m_model->reset(std::move(database));
+        m_model->addPlayer(std::make_unique<Player>(0, p1Name, m_model->getDatabase()));
+        m_model->addPlayer(std::make_unique<Player>(1, p2Name, m_model->getDatabase()));
 
-        // Use Factory to get tokens
-        m_model->getBoardMut()->setAvailableProgressTokens(factory.createAvailableTokens());
-        m_model->getBoardMut()->setBoxProgressTokens(factory.createBoxTokens());
+        m_extraTurnPending = false;
+        m_draftTurnCount = 0;
+        m_pendingDestructionType = CardType::CIVILIAN;
+        m_undoDepth = 0;
+        setState(GameState::WONDER_DRAFT_PHASE_1);
 
-        m_model->addLog("[System] Game Initialized. Progress Tokens shuffled.");
+        // 科技标记：洗牌后前 5 枚上桌，后 5 枚留在盒中 (图书馆奇迹使用)
+        std::vector<ProgressToken> tokens = m_model->getDatabase()->getProgressTokens();
+        std::shuffle(tokens.begin(), tokens.end(), m_tokenRng);
+        size_t split = std::min<size_t>(5, tokens.size());
+        m_model->getBoardMut()->setAvailableProgressTokens(std::vector<ProgressToken>(tokens.begin(), tokens.begin() + split));
+        m_model->getBoardMut()->setBoxProgressTokens(std::vector<ProgressToken>(tokens.begin() + split, tokens.end()));
+
+        if (m_model->isLogEnabled()) m_model->addLog("[System] Game Initialized. Progress Tokens shuffled.");
     }
 
     void GameController::startGame() {
@@ -79,7 +114,13 @@ namespace SevenWondersDuel {
         m_draftTurnCount = 0;
         initWondersDeck();
         dealWondersToDraft();
-        m_model->addLog("[System] Game Started. Wonder Draft Phase 1.");
+        if (m_model->isLogEnabled()) m_model->addLog("[System] Game Started. Wonder Draft Phase 1.");
+    }
+
+    void GameController::setSeed(std::uint64_t gameSeed) {
+        m_gameSeed = gameSeed;
+        m_deckRng = SeedHierarchy::stream(gameSeed, RngStream::DECK);
+        m_tokenRng = SeedHierarchy::stream(gameSeed, RngStream::TOKENS);
     }
 
     GameState GameController::getState() const {
@@ -90,19 +131,27 @@ namespace SevenWondersDuel {
         return *m_model;
     }
 
+    std::uint64_t GameController::getStateHash() const {
+        std::uint64_t h = m_model->getHash() ^ Zobrist::gameState(m_currentState);
+        if (m_extraTurnPending) h ^= Zobrist::extraTurn();
+        if (m_currentState == GameState::WAITING_FOR_DESTRUCTION) h ^= Zobrist::pendingDestruction(m_pendingDestructionType);
+        return h;
+    }
+
     void GameController::initWondersDeck() {
         m_model->clearRemainingWonders();
-        std::vector<Wonder*> temp = m_model->getPointersToAllWonders();
-        std::shuffle(temp.begin(), temp.end(), m_rng);
+        std::vector<const Wonder*> temp = m_model->getPointersToAllWonders();
+        std::shuffle(temp.begin(), temp.end(), m_deckRng);
         for (auto w : temp) {
             m_model->addToRemainingWonders(w);
         }
     }
 
     void GameController::dealWondersToDraft() {
+        if (m_recording) m_recording->wondersDealt = true;
         m_model->clearDraftPool();
         for (int i = 0; i < 4; ++i) {
-            Wonder* w = m_model->backRemainingWonder();
+            const Wonder* w = m_model->backRemainingWonder();
             if (w) {
                 m_model->addToDraftPool(w);
                 m_model->popRemainingWonder();
@@ -111,11 +160,18 @@ namespace SevenWondersDuel {
     }
 
     void GameController::setupAge(int age) {
+        if (m_recording) {
+            // 旧金字塔 (上一时代已全部拿走) 的卡牌与发牌前的随机流，撤销时原样恢复
+            const CardPyramid& old = m_model->getBoard()->getCardStructure();
+            m_recording->ageStarted = true;
+            m_recording->pyramidSlotCount = static_cast<std::uint8_t>(old.getSlotCount());
+            for (int i = 0; i < old.getSlotCount(); ++i) m_recording->pyramidCards[i] = old.getSlot(i).getCardPtr();
+            m_recording->deckRng = m_deckRng;
+        }
         m_model->setCurrentAge(age);
-        std::vector<Card*> deck = prepareDeckForAge(age);
-        m_model->getBoardMut()->initPyramid(age, deck);
+        m_model->getBoardMut()->initPyramid(age, prepareDeckForAge(age));
         setState(GameState::AGE_PLAY_PHASE);
-        m_model->addLog("[System] Age " + std::to_string(age) + " Begins!");
+        if (m_model->isLogEnabled()) m_model->addLog("[System] Age " + std::to_string(age) + " Begins!");
     }
 
     void GameController::prepareNextAge() {
@@ -123,8 +179,8 @@ namespace SevenWondersDuel {
             setState(GameState::GAME_OVER);
             m_model->setVictoryType(VictoryType::CIVILIAN);
 
-            int s1 = ScoringManager::calculateScore(*m_model->getPlayers()[0], *m_model->getPlayers()[1], *m_model->getBoard());
-            int s2 = ScoringManager::calculateScore(*m_model->getPlayers()[1], *m_model->getPlayers()[0], *m_model->getBoard());
+            int s1 = m_model->getPlayers()[0]->getScore(*m_model->getPlayers()[1]);
+            int s2 = m_model->getPlayers()[1]->getScore(*m_model->getPlayers()[0]);
 
             if (s1 > s2) m_model->setWinnerIndex(0);
             else if (s2 > s1) m_model->setWinnerIndex(1);
@@ -134,13 +190,13 @@ namespace SevenWondersDuel {
 
                 if (blue1 > blue2) {
                     m_model->setWinnerIndex(0);
-                    m_model->addLog("[System] Score Tie! Player 1 wins by Civilian (Blue) Points.");
+                    if (m_model->isLogEnabled()) m_model->addLog("[System] Score Tie! Player 1 wins by Civilian (Blue) Points.");
                 } else if (blue2 > blue1) {
                     m_model->setWinnerIndex(1);
-                    m_model->addLog("[System] Score Tie! Player 2 wins by Civilian (Blue) Points.");
+                    if (m_model->isLogEnabled()) m_model->addLog("[System] Score Tie! Player 2 wins by Civilian (Blue) Points.");
                 } else {
                     m_model->setWinnerIndex(-1);
-                    m_model->addLog("[System] True Draw! (Scores and Blue Points identical)");
+                    if (m_model->isLogEnabled()) m_model->addLog("[System] True Draw! (Scores and Blue Points identical)");
                 }
             }
             return;
@@ -156,39 +212,40 @@ namespace SevenWondersDuel {
         m_model->setCurrentPlayerIndex(decisionMaker);
         setState(GameState::WAITING_FOR_START_PLAYER_SELECTION);
 
-        m_model->addLog("[System] End of Age " + std::to_string(m_model->getCurrentAge()) +
-                      ". " + m_model->getCurrentPlayer()->getName() + " chooses who starts next age.");
+        if (m_model->isLogEnabled()) {
+            m_model->addLog("[System] End of Age " + std::to_string(m_model->getCurrentAge()) +
+                            ". " + m_model->getCurrentPlayer()->getName() + " chooses who starts next age.");
+        }
     }
 
-    std::vector<Card*> GameController::prepareDeckForAge(int age) {
-        std::vector<Card*> deck;
-        std::vector<Card*> ageCards;
-        std::vector<Card*> guildCards;
+    const std::vector<const Card*>& GameController::prepareDeckForAge(int age) {
+        std::vector<const Card*>& deck = m_deckBuffer;
+        std::vector<const Card*>& guildCards = m_guildBuffer;
+        deck.clear();
+        guildCards.clear();
 
-        for(const auto& c_const : m_model->getAllCards()) {
-            Card* c = m_model->findCardById(c_const.getId());
+        for(const auto& card : m_model->getAllCards()) {
+            const Card* c = &card;
             if (c->getType() == CardType::GUILD) {
                 guildCards.push_back(c);
             } else if (c->getAge() == age) {
-                ageCards.push_back(c);
+                deck.push_back(c);
             }
         }
 
-        std::shuffle(ageCards.begin(), ageCards.end(), m_rng);
+        std::shuffle(deck.begin(), deck.end(), m_deckRng);
 
-        if (ageCards.size() > 3) {
-            ageCards.resize(ageCards.size() - 3);
+        if (deck.size() > Config::CARDS_REMOVED_PER_AGE) {
+            deck.resize(deck.size() - Config::CARDS_REMOVED_PER_AGE);
         }
 
-        for (auto c : ageCards) deck.push_back(c);
-
         if (age == 3) {
-            std::shuffle(guildCards.begin(), guildCards.end(), m_rng);
-            if (guildCards.size() > 3) {
-                guildCards.resize(3);
+            std::shuffle(guildCards.begin(), guildCards.end(), m_deckRng);
+            if (guildCards.size() > Config::GUILDS_PER_GAME) {
+                guildCards.resize(Config::GUILDS_PER_GAME);
             }
             for (auto c : guildCards) deck.push_back(c);
-            std::shuffle(deck.begin(), deck.end(), m_rng);
+            std::shuffle(deck.begin(), deck.end(), m_deckRng);
         }
 
         return deck;
@@ -210,7 +267,7 @@ namespace SevenWondersDuel {
 
         if (m_extraTurnPending) {
             m_extraTurnPending = false;
-            m_model->addLog(">> EXTRA TURN for " + m_model->getCurrentPlayer()->getName());
+            if (m_model->isLogEnabled()) m_model->addLog(">> EXTRA TURN for " + m_model->getCurrentPlayer()->getName());
         } else {
             switchPlayer();
         }
@@ -228,39 +285,141 @@ namespace SevenWondersDuel {
         return {false, 0, "State Logic not initialized"};
     }
 
+    void GameController::generateLegalActions(std::vector<LegalAction>& out) const {
+        out.clear();
+        if (m_stateLogic) {
+            m_stateLogic->generateActions(*this, out);
+        }
+    }
+
     bool GameController::processAction(const Action& action) {
         ActionResult v = validateAction(action);
         if (!v.isValid) return false;
 
-        auto cmd = CommandFactory::createCommand(action);
-        if (cmd) {
-            cmd->execute(*this);
-            return true;
+        m_recording = m_undoEnabled ? &beginUndoRecord(action) : nullptr;
+        bool executed = CommandFactory::executeCommand(*this, action);
+        if (!executed && m_recording) --m_undoDepth;
+        m_recording = nullptr;
+        if (!executed) return false;
+#ifndef NDEBUG
+        checkScoreConsistency();
+        checkHashConsistency();
+#endif
+        return true;
+    }
+
+    // ==========================================================
+    //  Undo (make / unmake)
+    // ==========================================================
+
+    void GameController::setUndoEnabled(bool enabled) {
+        m_undoEnabled = enabled;
+        if (!enabled) m_undoDepth = 0;
+    }
+
+    UndoRecord& GameController::beginUndoRecord(const Action& action) {
+        if (m_undoDepth == m_undoStack.size()) m_undoStack.emplace_back();
+        UndoRecord& rec = m_undoStack[m_undoDepth++];
+        rec.action = action;
+        rec.position = -1;
+        rec.clearedWonderCount = {};
+        rec.wondersDealt = false;
+        rec.ageStarted = false;
+
+        rec.state = m_currentState;
+        rec.extraTurnPending = m_extraTurnPending;
+        rec.draftTurnCount = m_draftTurnCount;
+        rec.pendingDestructionType = m_pendingDestructionType;
+        rec.age = m_model->getCurrentAge();
+        rec.currentPlayer = m_model->getCurrentPlayerIndex();
+        rec.winner = m_model->getWinnerIndex();
+        rec.victoryType = m_model->getVictoryType();
+        for (int i = 0; i < 2; ++i) {
+            const Player& p = *m_model->getPlayers()[i];
+            rec.coins[i] = p.getCoins();
+            rec.claimedSciencePairs[i] = p.getClaimedSciencePairMask();
         }
-        return false;
+
+        const Board& board = *m_model->getBoard();
+        rec.militaryPosition = board.getMilitaryTrack().getPosition();
+        std::copy(board.getMilitaryTrack().getLootTokens(), board.getMilitaryTrack().getLootTokens() + 4, rec.lootTokens);
+        rec.pyramidRemoved = board.getCardStructure().getRemovedMask();
+        rec.pyramidFaceUp = board.getCardStructure().getFaceUpMask();
+        rec.pyramidExposed = board.getCardStructure().getExposedMask();
+        rec.logSize = m_model->getGameLog().size();
+        return rec;
+    }
+
+    bool GameController::undo() {
+        if (m_undoDepth == 0) return false;
+        const UndoRecord& rec = m_undoStack[--m_undoDepth];
+        Board* board = m_model->getBoardMut();
+
+        // 按执行的逆序：先撤销命令末尾触发的控制器流程，再由命令撤销自身的结构变化，最后恢复标量
+        if (rec.ageStarted) {
+            board->restorePyramid(rec.age, rec.pyramidCards, rec.pyramidSlotCount, rec.pyramidRemoved, rec.pyramidFaceUp);
+            m_deckRng = rec.deckRng;
+        }
+        if (rec.wondersDealt) m_model->returnDraftPoolToRemaining();
+
+        CommandFactory::undoCommand(*this, rec);
+
+        for (int i = 0; i < 2; ++i) {
+            Player* p = m_model->getPlayers()[i].get();
+            p->setCoins(rec.coins[i]);
+            p->setClaimedSciencePairMask(rec.claimedSciencePairs[i]);
+        }
+        board->restoreMilitaryTrack(rec.militaryPosition, rec.lootTokens);
+        const MilitaryTrack& track = board->getMilitaryTrack();
+        for (auto& p : m_model->getPlayers()) p->setMilitaryVictoryPoints(track.getVictoryPoints(p->getId()));
+        if (!rec.ageStarted) board->restorePyramidMasks(rec.pyramidRemoved, rec.pyramidFaceUp, rec.pyramidExposed);
+
+        m_model->setCurrentAge(rec.age);
+        m_model->setCurrentPlayerIndex(rec.currentPlayer);
+        m_model->setWinnerIndex(rec.winner);
+        m_model->setVictoryType(rec.victoryType);
+        m_model->truncateLog(rec.logSize);
+
+        if (m_currentState != rec.state) {
+            m_currentState = rec.state;
+            updateStateLogic(m_currentState);
+        }
+        m_extraTurnPending = rec.extraTurnPending;
+        m_draftTurnCount = rec.draftTurnCount;
+        m_pendingDestructionType = rec.pendingDestructionType;
+#ifndef NDEBUG
+        checkScoreConsistency();
+        checkHashConsistency();
+#endif
+        return true;
     }
 
     bool GameController::checkForNewSciencePairs(Player* p) {
         ScienceSymbol sym = RulesEngine::getNewSciencePairSymbol(*p);
         if (sym != ScienceSymbol::NONE) {
             p->addClaimedSciencePair(sym);
+            if (m_model->getBoard()->getAvailableProgressTokens().empty()) {
+                // 桌面已无标记可选，奖励落空 (否则会卡在无合法动作的选择状态)
+                if (m_model->isLogEnabled()) m_model->addLog(p->getName() + " collected a Science Pair, but no Progress Tokens are left.");
+                return false;
+            }
             setState(GameState::WAITING_FOR_TOKEN_SELECTION_PAIR);
-            m_model->addLog(p->getName() + " collected a Science Pair! Choose a Progress Token.");
+            if (m_model->isLogEnabled()) m_model->addLog(p->getName() + " collected a Science Pair! Choose a Progress Token.");
             return true;
         }
         return false;
     }
 
-    void GameController::resolveMilitaryLoot(const std::vector<int>& lootEvents) {
+    void GameController::resolveMilitaryLoot(const MilitaryLoot& lootEvents) {
         for (int amount : lootEvents) {
             if (amount > 0) {
                 int loss = std::min(m_model->getPlayers()[1]->getCoins(), amount);
                 m_model->getPlayers()[1]->payCoins(loss);
-                m_model->addLog("[Military] Player 2 lost " + std::to_string(loss) + " coins!");
+                if (m_model->isLogEnabled()) m_model->addLog("[Military] Player 2 lost " + std::to_string(loss) + " coins!");
             } else {
                 int loss = std::min(m_model->getPlayers()[0]->getCoins(), std::abs(amount));
                 m_model->getPlayers()[0]->payCoins(loss);
-                m_model->addLog("[Military] Player 1 lost " + std::to_string(loss) + " coins!");
+                if (m_model->isLogEnabled()) m_model->addLog("[Military] Player 1 lost " + std::to_string(loss) + " coins!");
             }
         }
     }
@@ -274,18 +433,37 @@ namespace SevenWondersDuel {
         }
     }
 
-    Card* GameController::findCardInPyramid(const std::string& id) {
-        return m_model->findCardById(id);
+    const Card* GameController::findCardInPyramid(CardIndex card) {
+        return m_model->getCard(card);
     }
 
-    Wonder* GameController::findWonderInHand(const Player* p, const std::string& id) {
-        for(auto w : p->getUnbuiltWonders()) if (w->getId() == id) return w;
+    const Wonder* GameController::findWonderInHand(const Player* p, WonderIndex wonder) {
+        for(auto w : p->getUnbuiltWonders()) if (w->getIndex() == wonder) return w;
         return nullptr;
     }
 
-    std::vector<int> GameController::moveMilitary(int shields, int playerId) {
-        return m_model->getBoardMut()->moveMilitary(shields, playerId);
+    MilitaryLoot GameController::moveMilitary(int shields, int playerId) {
+        auto lootEvents = m_model->getBoardMut()->moveMilitary(shields, playerId);
+        const MilitaryTrack& track = m_model->getBoard()->getMilitaryTrack();
+        for (auto& p : m_model->getPlayers()) p->setMilitaryVictoryPoints(track.getVictoryPoints(p->getId()));
+        return lootEvents;
+    }
+
+#ifndef NDEBUG
+    void GameController::checkScoreConsistency() const {
+        const auto& players = m_model->getPlayers();
+        for (int i = 0; i < 2; ++i) {
+            const Player& self = *players[i];
+            const Player& opp = *players[1 - i];
+            assert(self.getScoreBreakdown(opp) == ScoringManager::calculateBreakdown(self, opp, *m_model->getBoard()) &&
+                   "incremental score diverged from ScoringManager");
+        }
+    }
+
+    void GameController::checkHashConsistency() const {
+        assert(m_model->getHash() == Zobrist::computeModelHash(*m_model) && "incremental Zobrist hash diverged");
     }
+#endif
 
     bool GameController::isDiscardPileEmpty() const {
         return m_model->getBoard()->getDiscardPile().empty();
@@ -295,55 +473,102 @@ namespace SevenWondersDuel {
     //  GameModel
     // ==========================================================
 
-    GameModel::GameModel() {
+    GameModel::GameModel() : m_hash(initialHash()) {
         m_board = std::make_unique<Board>();
     }
 
-    void GameModel::removeFromDraftPool(const std::string& wonderId) {
-        m_draftPool.erase(std::remove_if(m_draftPool.begin(), m_draftPool.end(),
-            [&](Wonder* w){ return w->getId() == wonderId; }), m_draftPool.end());
+    void GameModel::copyFrom(const GameModel& other) {
+        if (this == &other) return;
+        if (m_database != other.m_database) m_database = other.m_database;
+
+        if (m_players.size() != other.m_players.size()) {
+            m_players.clear();
+            for (const auto& p : other.m_players) m_players.push_back(std::make_unique<Player>(*p));
+        } else {
+            for (size_t i = 0; i < m_players.size(); ++i) *m_players[i] = *other.m_players[i];
+        }
+        *m_board = *other.m_board;
+
+        m_currentAge = other.m_currentAge;
+        m_currentPlayerIndex = other.m_currentPlayerIndex;
+        m_winnerIndex = other.m_winnerIndex;
+        m_victoryType = other.m_victoryType;
+
+        m_draftPool = other.m_draftPool;
+        m_remainingWonders = other.m_remainingWonders;
+        m_hash = other.m_hash;
+    }
+
+    std::uint64_t GameModel::getHash() const {
+        std::uint64_t h = m_hash ^ m_board->getHash();
+        for (const auto& p : m_players) h ^= p->getHash();
+        return h;
+    }
+
+    void GameModel::clearDraftPool() {
+        for (const Wonder* w : m_draftPool) m_hash ^= Zobrist::draftPool(w->getIndex());
+        m_draftPool.clear();
+    }
+
+    void GameModel::removeFromDraftPool(WonderIndex wonder) {
+        auto it = std::remove_if(m_draftPool.begin(), m_draftPool.end(),
+            [&](const Wonder* w){ return w->getIndex() == wonder; });
+        if (it != m_draftPool.end()) m_hash ^= Zobrist::draftPool(wonder);
+        m_draftPool.erase(it, m_draftPool.end());
+    }
+
+    void GameModel::insertIntoDraftPool(int position, const Wonder* w) {
+        position = std::clamp(position, 0, static_cast<int>(m_draftPool.size()));
+        m_draftPool.insert(m_draftPool.begin() + position, w);
+        m_hash ^= Zobrist::draftPool(w->getIndex());
+    }
+
+    void GameModel::returnDraftPoolToRemaining() {
+        // 发牌时从剩余奇迹的末尾依次取出，逆序放回即恢复原顺序
+        for (auto it = m_draftPool.rbegin(); it != m_draftPool.rend(); ++it) m_remainingWonders.push_back(*it);
+        clearDraftPool();
     }
 
     void GameModel::popRemainingWonder() {
         if (!m_remainingWonders.empty()) m_remainingWonders.pop_back();
     }
 
-    Wonder* GameModel::backRemainingWonder() {
+    const Wonder* GameModel::backRemainingWonder() {
         return m_remainingWonders.empty() ? nullptr : m_remainingWonders.back();
     }
 
-    void GameModel::populateData(std::vector<Card> cards, std::vector<Wonder> wonders) {
-        m_allCards = std::move(cards);
-        m_allWonders = std::move(wonders);
-    }
+    void GameModel::reset(std::shared_ptr<const CardDatabase> database) {
+        m_database = std::move(database);
+        m_board = std::make_unique<Board>();
+        m_players.clear();
 
-    Card* GameModel::findCardById(const std::string& id) {
-        for(auto& c : m_allCards) if(c.getId() == id) return &c;
-        return nullptr;
-    }
+        m_currentAge = 0;
+        m_currentPlayerIndex = 0;
+        m_winnerIndex = -1;
+        m_victoryType = VictoryType::NONE;
 
-    const Card* GameModel::findCardById(const std::string& id) const {
-        for(const auto& c : m_allCards) if(c.getId() == id) return &c;
-        return nullptr;
+        m_draftPool.clear();
+        m_remainingWonders.clear();
+        m_gameLog.clear();
+        m_hash = initialHash();
     }
 
-    Wonder* GameModel::findWonderById(const std::string& id) {
-        for(auto& w : m_allWonders) if(w.getId() == id) return &w;
-        return nullptr;
+    const Card* GameModel::findCardById(const std::string& id) const {
+        return m_database ? m_database->findCard(id) : nullptr;
     }
 
     const Wonder* GameModel::findWonderById(const std::string& id) const {
-        for(const auto& w : m_allWonders) if(w.getId() == id) return &w;
-        return nullptr;
+        return m_database ? m_database->findWonder(id) : nullptr;
     }
 
-    std::vector<Wonder*> GameModel::getPointersToAllWonders() {
-        std::vector<Wonder*> res;
-        for(auto& w : m_allWonders) res.push_back(&w);
+    std::vector<const Wonder*> GameModel::getPointersToAllWonders() const {
+        std::vector<const Wonder*> res;
+        for(const auto& w : m_database->getWonders()) res.push_back(&w);
         return res;
     }
 
     void GameModel::addLog(const std::string& msg) {
+        if (!m_logEnabled) return;
         m_gameLog.push_back(msg);
     }
 
@@ -352,11 +577,7 @@ namespace SevenWondersDuel {
     }
 
     int GameModel::getRemainingCardCount() const {
-        int count = 0;
-        for(const auto& slot : m_board->getCardStructure().getSlots()) {
-            if (!slot.isRemoved()) count++;
-        }
-        return count;
+        return m_board->getCardStructure().getRemainingCount();
     }
 
 }
\ No newline at end of file
@@ -1,23 +1,52 @@
 #include "GameFactory.h"
 #include "EffectSystem.h"
 #include "CardBuilder.h"
+#include "CardImage.h"
 #include <fstream>
 #include <sstream>
-#include <filesystem>
 #include <algorithm>
-#include <random>
-#include <chrono>
 #include <iostream>
 #include <cstdlib>
 
 namespace SevenWondersDuel {
 
-    BaseGameFactory::BaseGameFactory(const std::string& jsonPath) {
-        std::cout << "[DEBUG] Loading data from: " << jsonPath << std::endl;
-        if (!std::filesystem::exists(jsonPath)) {
-            std::cerr << "[DEBUG] Error: File not found!" << std::endl;
+    namespace {
+        void putU16(std::vector<std::uint8_t>& out, std::uint32_t v) {
+            out.push_back(static_cast<std::uint8_t>(v));
+            out.push_back(static_cast<std::uint8_t>(v >> 8));
+        }
+
+        void putU32(std::vector<std::uint8_t>& out, std::uint32_t v) {
+            for (int i = 0; i < 4; ++i) out.push_back(static_cast<std::uint8_t>(v >> (8 * i)));
+        }
+
+        void setU32(std::uint8_t* p, std::uint32_t v) {
+            for (int i = 0; i < 4; ++i) p[i] = static_cast<std::uint8_t>(v >> (8 * i));
+        }
+
+        void setU64(std::uint8_t* p, std::uint64_t v) {
+            for (int i = 0; i < 8; ++i) p[i] = static_cast<std::uint8_t>(v >> (8 * i));
+        }
+
+        std::uint16_t getU16(const std::uint8_t* p) {
+            return static_cast<std::uint16_t>(p[0] | (p[1] << 8));
         }
 
+        std::uint32_t getU32(const std::uint8_t* p) {
+            return static_cast<std::uint32_t>(p[0]) | (static_cast<std::uint32_t>(p[1]) << 8) |
+                   (static_cast<std::uint32_t>(p[2]) << 16) | (static_cast<std::uint32_t>(p[3]) << 24);
+        }
+
+        std::uint64_t getU64(const std::uint8_t* p) {
+            std::uint64_t v = 0;
+            for (int i = 7; i >= 0; --i) v = (v << 8) | p[i];
+            return v;
+        }
+
+        constexpr size_t COST_BYTES = 1 + EffectSpec::RESOURCE_KINDS;
+    }
+
+    BaseGameFactory::BaseGameFactory(const std::string& jsonPath) {
         std::ifstream file(jsonPath);
         if (!file.is_open()) {
             std::cerr << "Failed to open " << jsonPath << std::endl;
@@ -30,20 +59,6 @@ namespace SevenWondersDuel {
              std::cerr << "JSON parse error: " << e.what() << std::endl;
              exit(1);
         }
-
-        // Initialize Tokens
-        std::vector<ProgressToken> allTokens = {
-            ProgressToken::AGRICULTURE, ProgressToken::URBANISM,
-            ProgressToken::STRATEGY, ProgressToken::THEOLOGY,
-            ProgressToken::ECONOMY, ProgressToken::MASONRY,
-            ProgressToken::ARCHITECTURE, ProgressToken::LAW,
-            ProgressToken::MATHEMATICS, ProgressToken::PHILOSOPHY
-        };
-
-        unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
-        std::default_random_engine rng(seed);
-        std::shuffle(allTokens.begin(), allTokens.end(), rng);
-        m_shuffledTokens = allTokens;
     }
 
     BaseGameFactory::~BaseGameFactory() = default;
@@ -100,20 +115,264 @@ namespace SevenWondersDuel {
         return wonders;
     }
 
-    std::vector<ProgressToken> BaseGameFactory::createAvailableTokens() {
-        std::vector<ProgressToken> result;
-        if (m_shuffledTokens.size() >= 5) {
-            for(int i=0; i<5; ++i) result.push_back(m_shuffledTokens[i]);
+    std::vector<ProgressToken> BaseGameFactory::createProgressTokens() {
+        return {
+            ProgressToken::AGRICULTURE, ProgressToken::URBANISM,
+            ProgressToken::STRATEGY, ProgressToken::THEOLOGY,
+            ProgressToken::ECONOMY, ProgressToken::MASONRY,
+            ProgressToken::ARCHITECTURE, ProgressToken::LAW,
+            ProgressToken::MATHEMATICS, ProgressToken::PHILOSOPHY
+        };
+    }
+
+
+    // ==========================================================
+    //  镜像编译
+    // ==========================================================
+
+    bool BaseGameFactory::compileImage(std::uint64_t sourceChecksum, std::vector<std::uint8_t>& out) {
+        std::vector<std::uint8_t> cards, wonders, effects, tags, tokens, strings;
+        std::vector<std::string> tagNames;
+        std::uint32_t effectCount = 0;
+        bool ok = true;
+
+        auto putString = [&](std::vector<std::uint8_t>& rec, const std::string& str) {
+            putU32(rec, static_cast<std::uint32_t>(strings.size()));
+            putU32(rec, static_cast<std::uint32_t>(str.size()));
+            strings.insert(strings.end(), str.begin(), str.end());
+        };
+        auto putCost = [&](std::vector<std::uint8_t>& rec, const ResourceCost& cost) {
+            int counts[EffectSpec::RESOURCE_KINDS] = {};
+            for (const auto& [type, count] : cost.getResources()) counts[static_cast<int>(type)] += count;
+            if (cost.getCoins() < 0 || cost.getCoins() > 0xFF) ok = false;
+            rec.push_back(static_cast<std::uint8_t>(cost.getCoins()));
+            for (int count : counts) {
+                if (count < 0 || count > 0xFF) ok = false;
+                rec.push_back(static_cast<std::uint8_t>(count));
+            }
+        };
+        auto tagIndex = [&](const std::string& tag) -> std::uint8_t {
+            if (tag.empty()) return CardImageFormat::NO_TAG;
+            auto it = std::find(tagNames.begin(), tagNames.end(), tag);
+            if (it != tagNames.end()) return static_cast<std::uint8_t>(it - tagNames.begin());
+            if (tagNames.size() >= CardImageFormat::NO_TAG) { ok = false; return CardImageFormat::NO_TAG; }
+            tagNames.push_back(tag);
+            return static_cast<std::uint8_t>(tagNames.size() - 1);
+        };
+        auto putEffects = [&](std::vector<std::uint8_t>& rec, const std::vector<EffectSpec>& specs) {
+            if (effectCount + specs.size() > 0xFFFF || specs.size() > 0xFF) ok = false;
+            putU16(rec, effectCount);
+            rec.push_back(static_cast<std::uint8_t>(specs.size()));
+            for (const EffectSpec& spec : specs) {
+                effects.push_back(static_cast<std::uint8_t>(spec.kind));
+                effects.push_back(spec.flags);
+                effects.push_back(spec.arg);
+                effects.insert(effects.end(), spec.resources.begin(), spec.resources.end());
+                putU32(effects, static_cast<std::uint32_t>(spec.amount));
+            }
+            effectCount += static_cast<std::uint32_t>(specs.size());
+        };
+
+        if (m_jsonData.contains("cards")) {
+            for (const auto& v : m_jsonData["cards"]) {
+                std::vector<std::uint8_t> rec;
+                CardType type = strToCardType(v["type"].get<std::string>());
+                putString(rec, v["id"].get<std::string>());
+                putString(rec, v["name"].get<std::string>());
+                rec.push_back(static_cast<std::uint8_t>(v["age"].get<int>()));
+                rec.push_back(static_cast<std::uint8_t>(type));
+                putCost(rec, parseCost(v["cost"]));
+                rec.push_back(tagIndex(v.value("provides_chain", "")));
+                rec.push_back(tagIndex(v.value("requires_chain", "")));
+                putEffects(rec, EffectFactory::parseEffects(v["effects"], type, true));
+                rec.resize(CardImageFormat::CARD_BYTES);
+                cards.insert(cards.end(), rec.begin(), rec.end());
+            }
+        }
+        if (m_jsonData.contains("wonders")) {
+            for (const auto& v : m_jsonData["wonders"]) {
+                std::vector<std::uint8_t> rec;
+                putString(rec, v["id"].get<std::string>());
+                putString(rec, v["name"].get<std::string>());
+                putCost(rec, parseCost(v["cost"]));
+                putEffects(rec, EffectFactory::parseEffects(v["effects"], CardType::WONDER, false));
+                rec.resize(CardImageFormat::WONDER_BYTES);
+                wonders.insert(wonders.end(), rec.begin(), rec.end());
+            }
         }
-        return result;
+        for (const std::string& tag : tagNames) putString(tags, tag);
+        for (ProgressToken t : createProgressTokens()) tokens.push_back(static_cast<std::uint8_t>(t));
+        if (!ok) return false;
+
+        out.assign(CardImageFormat::HEADER_BYTES, 0);
+        for (const auto* section : {&cards, &wonders, &effects, &tags, &tokens, &strings}) {
+            out.insert(out.end(), section->begin(), section->end());
+        }
+
+        std::uint8_t* header = out.data();
+        std::copy(CardImageFormat::MAGIC, CardImageFormat::MAGIC + 4, header);
+        header[4] = static_cast<std::uint8_t>(CardImageFormat::VERSION);
+        header[5] = static_cast<std::uint8_t>(CardImageFormat::VERSION >> 8);
+        setU64(header + 8, sourceChecksum);
+        setU32(header + 16, static_cast<std::uint32_t>(cards.size() / CardImageFormat::CARD_BYTES));
+        setU32(header + 20, static_cast<std::uint32_t>(wonders.size() / CardImageFormat::WONDER_BYTES));
+        setU32(header + 24, effectCount);
+        setU32(header + 28, static_cast<std::uint32_t>(tagNames.size()));
+        setU32(header + 32, static_cast<std::uint32_t>(tokens.size()));
+        setU32(header + 36, static_cast<std::uint32_t>(strings.size()));
+        setU64(header + 40, CardImageFormat::checksum(out.data() + CardImageFormat::HEADER_BYTES, out.size() - CardImageFormat::HEADER_BYTES));
+        return true;
+    }
+
+    // ==========================================================
+    //  BinaryGameFactory
+    // ==========================================================
+
+    BinaryGameFactory::BinaryGameFactory(const std::uint8_t* data, size_t size) : m_data(data), m_size(size) {
+        m_valid = validate();
+    }
+
+    bool BinaryGameFactory::validate() {
+        if (!m_data || m_size < CardImageFormat::HEADER_BYTES ||
+            !std::equal(CardImageFormat::MAGIC, CardImageFormat::MAGIC + 4, reinterpret_cast<const char*>(m_data)) ||
+            getU16(m_data + 4) != CardImageFormat::VERSION) {
+            return false;
+        }
+
+        m_sourceChecksum = getU64(m_data + 8);
+        m_cardCount = getU32(m_data + 16);
+        m_wonderCount = getU32(m_data + 20);
+        m_effectCount = getU32(m_data + 24);
+        m_tagCount = getU32(m_data + 28);
+        m_tokenCount = getU32(m_data + 32);
+        m_stringBytes = getU32(m_data + 36);
+
+        // 段长由计数决定，总长必须与文件一致 (64 位运算，计数再大也不会溢出)
+        std::uint64_t at = CardImageFormat::HEADER_BYTES;
+        m_cardsAt = static_cast<size_t>(at);   at += std::uint64_t(m_cardCount) * CardImageFormat::CARD_BYTES;
+        m_wondersAt = static_cast<size_t>(at); at += std::uint64_t(m_wonderCount) * CardImageFormat::WONDER_BYTES;
+        m_effectsAt = static_cast<size_t>(at); at += std::uint64_t(m_effectCount) * CardImageFormat::EFFECT_BYTES;
+        m_tagsAt = static_cast<size_t>(at);    at += std::uint64_t(m_tagCount) * CardImageFormat::STRING_REF_BYTES;
+        m_tokensAt = static_cast<size_t>(at);  at += m_tokenCount;
+        m_stringsAt = static_cast<size_t>(at); at += m_stringBytes;
+        if (at != m_size) return false;
+        if (getU64(m_data + 40) != CardImageFormat::checksum(m_data + CardImageFormat::HEADER_BYTES, m_size - CardImageFormat::HEADER_BYTES)) {
+            return false;
+        }
+
+        auto stringOk = [&](size_t refAt) {
+            return std::uint64_t(getU32(m_data + refAt)) + getU32(m_data + refAt + 4) <= m_stringBytes;
+        };
+        auto tagOk = [&](std::uint8_t tag) { return tag == CardImageFormat::NO_TAG || tag < m_tagCount; };
+        auto effectsOk = [&](size_t firstAt) {
+            return std::uint32_t(getU16(m_data + firstAt)) + m_data[firstAt + 2] <= m_effectCount;
+        };
+
+        for (std::uint32_t i = 0; i < m_cardCount; ++i) {
+            size_t at = m_cardsAt + i * CardImageFormat::CARD_BYTES;
+            const size_t tagAt = at + 18 + COST_BYTES;
+            if (!stringOk(at) || !stringOk(at + 8) || m_data[at + 17] >= static_cast<int>(CardType::WONDER) ||
+                !tagOk(m_data[tagAt]) || !tagOk(m_data[tagAt + 1]) || !effectsOk(tagAt + 2)) {
+                return false;
+            }
+        }
+        for (std::uint32_t i = 0; i < m_wonderCount; ++i) {
+            size_t at = m_wondersAt + i * CardImageFormat::WONDER_BYTES;
+            if (!stringOk(at) || !stringOk(at + 8) || !effectsOk(at + 16 + COST_BYTES)) return false;
+        }
+        for (std::uint32_t i = 0; i < m_tagCount; ++i) {
+            if (!stringOk(m_tagsAt + i * CardImageFormat::STRING_REF_BYTES)) return false;
+        }
+        for (std::uint32_t i = 0; i < m_tokenCount; ++i) {
+            std::uint8_t t = m_data[m_tokensAt + i];
+            if (t == static_cast<int>(ProgressToken::NONE) || t > static_cast<int>(ProgressToken::PHILOSOPHY)) return false;
+        }
+
+        // 效果对象在此一次构造完毕，参数无效 (createEffect 返回空) 即视为损坏
+        m_effects.clear();
+        m_effects.reserve(m_effectCount);
+        for (std::uint32_t i = 0; i < m_effectCount; ++i) {
+            const std::uint8_t* p = m_data + m_effectsAt + i * CardImageFormat::EFFECT_BYTES;
+            EffectSpec spec;
+            spec.kind = static_cast<EffectKind>(p[0]);
+            spec.flags = p[1];
+            spec.arg = p[2];
+            std::copy(p + 3, p + 3 + EffectSpec::RESOURCE_KINDS, spec.resources.begin());
+            spec.amount = static_cast<std::int32_t>(getU32(p + 3 + EffectSpec::RESOURCE_KINDS));
+            std::shared_ptr<IEffect> effect = EffectFactory::createEffect(spec);
+            if (!effect) return false;
+            m_effects.push_back(std::move(effect));
+        }
+        return true;
+    }
+
+    std::string BinaryGameFactory::stringAt(size_t refAt) const {
+        return std::string(reinterpret_cast<const char*>(m_data + m_stringsAt + getU32(m_data + refAt)), getU32(m_data + refAt + 4));
+    }
+
+    ResourceCost BinaryGameFactory::costAt(size_t at) const {
+        ResourceCost cost;
+        cost.setCoins(m_data[at]);
+        for (int r = 0; r < EffectSpec::RESOURCE_KINDS; ++r) {
+            if (m_data[at + 1 + r] > 0) cost.addResource(static_cast<ResourceType>(r), m_data[at + 1 + r]);
+        }
+        return cost;
+    }
+
+    std::vector<std::shared_ptr<IEffect>> BinaryGameFactory::effectsAt(size_t firstAt) const {
+        std::vector<std::shared_ptr<IEffect>> effects;
+        std::uint32_t first = getU16(m_data + firstAt);
+        std::uint32_t count = m_data[firstAt + 2];
+        effects.assign(m_effects.begin() + first, m_effects.begin() + first + count);
+        return effects;
+    }
+
+    std::vector<Card> BinaryGameFactory::createCards() {
+        std::vector<Card> cards;
+        if (!m_valid) return cards;
+        cards.reserve(m_cardCount);
+
+        auto tagString = [&](std::uint8_t tag) {
+            return tag == CardImageFormat::NO_TAG ? std::string() : stringAt(m_tagsAt + tag * CardImageFormat::STRING_REF_BYTES);
+        };
+        for (std::uint32_t i = 0; i < m_cardCount; ++i) {
+            size_t at = m_cardsAt + i * CardImageFormat::CARD_BYTES;
+            const size_t tagAt = at + 18 + COST_BYTES;
+            // 直接在容器中就地构造 (不经 CardBuilder 的整卡拷贝)
+            Card& c = cards.emplace_back();
+            c.setId(stringAt(at));
+            c.setName(stringAt(at + 8));
+            c.setAge(m_data[at + 16]);
+            c.setType(static_cast<CardType>(m_data[at + 17]));
+            c.setCost(costAt(at + 18));
+            c.setChainTag(tagString(m_data[tagAt]));
+            c.setRequiresChainTag(tagString(m_data[tagAt + 1]));
+            c.setEffects(effectsAt(tagAt + 2));
+        }
+        return cards;
     }
 
-    std::vector<ProgressToken> BaseGameFactory::createBoxTokens() {
-        std::vector<ProgressToken> result;
-        if (m_shuffledTokens.size() >= 10) {
-            for(int i=5; i<10; ++i) result.push_back(m_shuffledTokens[i]);
+    std::vector<Wonder> BinaryGameFactory::createWonders() {
+        std::vector<Wonder> wonders;
+        if (!m_valid) return wonders;
+        wonders.reserve(m_wonderCount);
+
+        for (std::uint32_t i = 0; i < m_wonderCount; ++i) {
+            size_t at = m_wondersAt + i * CardImageFormat::WONDER_BYTES;
+            Wonder& w = wonders.emplace_back();
+            w.setId(stringAt(at));
+            w.setName(stringAt(at + 8));
+            w.setCost(costAt(at + 16));
+            w.setEffects(effectsAt(at + 16 + COST_BYTES));
         }
-        return result;
+        return wonders;
+    }
+
+    std::vector<ProgressToken> BinaryGameFactory::createProgressTokens() {
+        std::vector<ProgressToken> tokens;
+        if (!m_valid) return tokens;
+        for (std::uint32_t i = 0; i < m_tokenCount; ++i) tokens.push_back(static_cast<ProgressToken>(m_data[m_tokensAt + i]));
+        return tokens;
     }
 
 }
\ No newline at end of file
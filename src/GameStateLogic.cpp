@@ -18,7 +18,7 @@ namespace SevenWondersDuel {
         if (action.type == ActionType::DRAFT_WONDER) {
             bool found = false;
             for(auto w : controller.getModel().getDraftPool()) {
-                if(w->getId() == action.targetWonderId) found = true;
+                if(w->getIndex() == action.targetWonder) found = true;
             }
             if(found) { 
                 result.isValid = true; 
@@ -31,6 +31,15 @@ namespace SevenWondersDuel {
         return result;
     }
 
+    void WonderDraftState::generateActions(const GameController& controller, std::vector<LegalAction>& out) const {
+        for (auto w : controller.getModel().getDraftPool()) {
+            LegalAction la;
+            la.action.type = ActionType::DRAFT_WONDER;
+            la.action.targetWonder = w->getIndex();
+            out.push_back(std::move(la));
+        }
+    }
+
     // ==========================================================
     //  AgePlayState
     // ==========================================================
@@ -44,7 +53,7 @@ namespace SevenWondersDuel {
         const Player* opponent = model.getOpponent();
 
         // 1. Find Card in Pyramid
-        const Card* target = model.findCardById(action.targetCardId);
+        const Card* target = model.getCard(action.targetCard);
         
         if (!target) { result.message = "Card not found"; return result; }
 
@@ -52,7 +61,7 @@ namespace SevenWondersDuel {
         bool isAvailable = false;
         const auto& pyramid = model.getBoard()->getCardStructure();
         for(const auto& slot : pyramid) {
-            if(slot.getCardPtr() && slot.getCardPtr()->getId() == target->getId()) {
+            if(slot.getCardPtr() == target) {
                  isAvailable = true; 
                  break; // Optimization: Found it, no need to continue
             }
@@ -64,8 +73,7 @@ namespace SevenWondersDuel {
             auto costInfo = currPlayer->calculateCost(target->getCost(), *opponent, target->getType());
 
             // Check Chain
-            if (!target->getRequiresChainTag().empty() &&
-                currPlayer->getOwnedChainTags().count(target->getRequiresChainTag())) {
+            if (currPlayer->hasChainFor(target)) {
                 costInfo.first = true; 
                 costInfo.second = 0;
             }
@@ -83,11 +91,11 @@ namespace SevenWondersDuel {
         else if (action.type == ActionType::BUILD_WONDER) {
             const Wonder* w = nullptr;
             for(auto ptr : currPlayer->getUnbuiltWonders()) {
-                if(ptr->getId() == action.targetWonderId) { w = ptr; break; }
+                if(ptr->getIndex() == action.targetWonder) { w = ptr; break; }
             }
 
             if (!w) { result.message = "Wonder not found in hand"; return result; }
-            if (w->isBuilt()) { result.message = "Wonder already built"; return result; }
+            if (currPlayer->hasBuiltWonder(w)) { result.message = "Wonder already built"; return result; }
 
             auto costInfo = currPlayer->calculateCost(w->getCost(), *opponent, CardType::WONDER);
             if (!costInfo.first) { result.message = "Insufficient resources for Wonder"; return result; }
@@ -101,6 +109,62 @@ namespace SevenWondersDuel {
         return result;
     }
 
+    void AgePlayState::generateActions(const GameController& controller, std::vector<LegalAction>& out) const {
+        const GameModel& model = controller.getModel();
+        const Player* currPlayer = model.getCurrentPlayer();
+        const Player* opponent = model.getOpponent();
+
+        // 奇迹花费与垫牌无关：每个奇迹只算一次
+        const Wonder* affordableWonders[Config::MAX_WONDERS_PER_PLAYER];
+        int wonderCosts[Config::MAX_WONDERS_PER_PLAYER];
+        int wonderCount = 0;
+        for (auto w : currPlayer->getUnbuiltWonders()) {
+            if (wonderCount >= Config::MAX_WONDERS_PER_PLAYER || currPlayer->hasBuiltWonder(w)) continue;
+            auto costInfo = currPlayer->calculateCost(w->getCost(), *opponent, CardType::WONDER);
+            if (!costInfo.first) continue;
+            affordableWonders[wonderCount] = w;
+            wonderCosts[wonderCount] = costInfo.second;
+            wonderCount++;
+        }
+
+        // 单次遍历当前可选的卡槽
+        for (const auto& slot : model.getBoard()->getCardStructure()) {
+            const Card* card = slot.getCardPtr();
+            if (!card) continue;
+
+            bool isChain = currPlayer->hasChainFor(card);
+            if (isChain) {
+                LegalAction la;
+                la.action.type = ActionType::BUILD_CARD;
+                la.action.targetCard = card->getIndex();
+                out.push_back(std::move(la));
+            } else {
+                auto costInfo = currPlayer->calculateCost(card->getCost(), *opponent, card->getType());
+                if (costInfo.first) {
+                    LegalAction la;
+                    la.action.type = ActionType::BUILD_CARD;
+                    la.action.targetCard = card->getIndex();
+                    la.cost = costInfo.second;
+                    out.push_back(std::move(la));
+                }
+            }
+
+            LegalAction discard;
+            discard.action.type = ActionType::DISCARD_FOR_COINS;
+            discard.action.targetCard = card->getIndex();
+            out.push_back(std::move(discard));
+
+            for (int i = 0; i < wonderCount; ++i) {
+                LegalAction la;
+                la.action.type = ActionType::BUILD_WONDER;
+                la.action.targetCard = card->getIndex();
+                la.action.targetWonder = affordableWonders[i]->getIndex();
+                la.cost = wonderCosts[i];
+                out.push_back(std::move(la));
+            }
+        }
+    }
+
     // ==========================================================
     //  TokenSelectionState
     // ==========================================================
@@ -110,13 +174,32 @@ namespace SevenWondersDuel {
         result.isValid = false;
 
         if (action.type == ActionType::SELECT_PROGRESS_TOKEN) {
-            result.isValid = true;
+            const Board* board = controller.getModel().getBoard();
+            const auto& pool = (controller.getState() == GameState::WAITING_FOR_TOKEN_SELECTION_LIB)
+                ? board->getBoxProgressTokens() : board->getAvailableProgressTokens();
+            if (std::find(pool.begin(), pool.end(), action.selectedToken) != pool.end()) {
+                result.isValid = true;
+                return result;
+            }
+            result.message = "Progress Token not available";
             return result;
         }
         result.message = "Must select a Progress Token";
         return result;
     }
 
+    void TokenSelectionState::generateActions(const GameController& controller, std::vector<LegalAction>& out) const {
+        const Board* board = controller.getModel().getBoard();
+        const auto& pool = (controller.getState() == GameState::WAITING_FOR_TOKEN_SELECTION_LIB)
+            ? board->getBoxProgressTokens() : board->getAvailableProgressTokens();
+        for (auto token : pool) {
+            LegalAction la;
+            la.action.type = ActionType::SELECT_PROGRESS_TOKEN;
+            la.action.selectedToken = token;
+            out.push_back(std::move(la));
+        }
+    }
+
     // ==========================================================
     //  DestructionState
     // ==========================================================
@@ -126,7 +209,7 @@ namespace SevenWondersDuel {
         result.isValid = false;
 
         if (action.type == ActionType::SELECT_DESTRUCTION) {
-            if (action.targetCardId.empty()) {
+            if (action.targetCard == NO_CARD) {
                 result.isValid = true;
                 return result;
             }
@@ -134,8 +217,8 @@ namespace SevenWondersDuel {
             const Player* opponent = controller.getModel().getOpponent();
             bool hasCard = false;
             const Card* targetCard = nullptr;
-            for (auto c : opponent->getBuiltCards()) {
-                if (c->getId() == action.targetCardId) {
+            for (auto c : opponent->getAllCards()) {
+                if (c->getIndex() == action.targetCard) {
                     hasCard = true;
                     targetCard = c;
                     break;
@@ -159,6 +242,21 @@ namespace SevenWondersDuel {
         return result;
     }
 
+    void DestructionState::generateActions(const GameController& controller, std::vector<LegalAction>& out) const {
+        CardType targetType = controller.getPendingDestructionType();
+        for (auto c : controller.getModel().getOpponent()->getCardsByType(targetType)) {
+            LegalAction la;
+            la.action.type = ActionType::SELECT_DESTRUCTION;
+            la.action.targetCard = c->getIndex();
+            out.push_back(std::move(la));
+        }
+
+        // 放弃摧毁始终合法
+        LegalAction skip;
+        skip.action.type = ActionType::SELECT_DESTRUCTION;
+        out.push_back(std::move(skip));
+    }
+
     // ==========================================================
     //  DiscardBuildState
     // ==========================================================
@@ -169,7 +267,7 @@ namespace SevenWondersDuel {
 
         if (action.type == ActionType::SELECT_FROM_DISCARD) {
             auto& pile = controller.getModel().getBoard()->getDiscardPile();
-            auto it = std::find_if(pile.begin(), pile.end(), [&](Card* c){ return c->getId() == action.targetCardId; });
+            auto it = std::find_if(pile.begin(), pile.end(), [&](const Card* c){ return c->getIndex() == action.targetCard; });
             if (it != pile.end()) {
                 result.isValid = true;
                 return result;
@@ -181,6 +279,15 @@ namespace SevenWondersDuel {
         return result;
     }
 
+    void DiscardBuildState::generateActions(const GameController& controller, std::vector<LegalAction>& out) const {
+        for (auto c : controller.getModel().getBoard()->getDiscardPile()) {
+            LegalAction la;
+            la.action.type = ActionType::SELECT_FROM_DISCARD;
+            la.action.targetCard = c->getIndex();
+            out.push_back(std::move(la));
+        }
+    }
+
     // ==========================================================
     //  StartPlayerSelectionState
     // ==========================================================
@@ -190,20 +297,28 @@ namespace SevenWondersDuel {
         result.isValid = false;
 
         if (action.type == ActionType::CHOOSE_STARTING_PLAYER) {
-            if (action.targetCardId == "ME" || action.targetCardId == "OPPONENT") {
-                result.isValid = true; return result;
-            }
-            result.message = "Target must be ME or OPPONENT";
+            result.isValid = true;
             return result;
         }
         result.message = "Must choose starting player";
         return result;
     }
 
+    void StartPlayerSelectionState::generateActions(const GameController& controller, std::vector<LegalAction>& out) const {
+        for (bool chooseSelf : {true, false}) {
+            LegalAction la;
+            la.action.type = ActionType::CHOOSE_STARTING_PLAYER;
+            la.action.chooseSelf = chooseSelf;
+            out.push_back(std::move(la));
+        }
+    }
+
     void IGameStateLogic::onEnter(GameController& controller) {}
 
     ActionResult GameOverState::validate(const Action& action, GameController& controller) {
         return {false, 0, "Game Over"};
     }
 
+    void GameOverState::generateActions(const GameController& controller, std::vector<LegalAction>& out) const {}
+
 }
@@ -96,19 +96,23 @@ namespace SevenWondersDuel {
 
     std::string GameView::formatResourcesCompact(const Player& p) {
         std::stringstream ss;
-        ss << "W:" << p.getFixedResources().at(ResourceType::WOOD) << " ";
-        ss << "C:" << p.getFixedResources().at(ResourceType::CLAY) << " ";
-        ss << "S:" << p.getFixedResources().at(ResourceType::STONE) << " ";
-        ss << "G:" << p.getFixedResources().at(ResourceType::GLASS) << " ";
-        ss << "P:" << p.getFixedResources().at(ResourceType::PAPER);
+        ss << "W:" << p.getFixedResource(ResourceType::WOOD) << " ";
+        ss << "C:" << p.getFixedResource(ResourceType::CLAY) << " ";
+        ss << "S:" << p.getFixedResource(ResourceType::STONE) << " ";
+        ss << "G:" << p.getFixedResource(ResourceType::GLASS) << " ";
+        ss << "P:" << p.getFixedResource(ResourceType::PAPER);
 
-        if (!p.getChoiceResources().empty()) {
+        if (p.getChoiceResourceCount() > 0) {
             ss << " \033[93m+";
-            for (const auto& choices : p.getChoiceResources()) {
+            for (int c = 0; c < p.getChoiceResourceCount(); ++c) {
+                std::uint8_t mask = p.getChoiceResourceMask(c);
                 ss << "(";
-                for (size_t i = 0; i < choices.size(); ++i) {
-                    if (i > 0) ss << "/";
-                    ss << resourceName(choices[i]).substr(0,1);
+                bool first = true;
+                for (int r = 0; r < 5; ++r) {
+                    if (!(mask & (1u << r))) continue;
+                    if (!first) ss << "/";
+                    ss << resourceName(static_cast<ResourceType>(r)).substr(0,1);
+                    first = false;
                 }
                 ss << ")";
             }
@@ -120,8 +124,10 @@ namespace SevenWondersDuel {
     std::string formatScienceSymbols(const Player& p) {
         std::stringstream ss;
         bool hasAny = false;
-        for (auto const& [sym, count] : p.getScienceSymbols()) {
-            if (sym == ScienceSymbol::NONE || count == 0) continue;
+        for (int s = static_cast<int>(ScienceSymbol::GLOBE); s <= static_cast<int>(ScienceSymbol::LAW); ++s) {
+            ScienceSymbol sym = static_cast<ScienceSymbol>(s);
+            int count = p.getScienceSymbolCount(sym);
+            if (count == 0) continue;
             hasAny = true;
             std::string sName;
             switch(sym) {
@@ -173,7 +179,9 @@ namespace SevenWondersDuel {
         std::cout << indent << "[2] Human vs Random AI\n";
         std::cout << indent << "[3] Human vs Greedy AI\n";
         std::cout << indent << "[4] Random AI vs Greedy AI (Watch Mode)\n";
-        std::cout << indent << "[5] Quit Game\n";
+        std::cout << indent << "[5] Human vs MCTS AI\n";
+        std::cout << indent << "[6] Human vs ISMCTS AI (no peeking)\n";
+        std::cout << indent << "[7] Quit Game\n";
         printLine('=', 80);
         std::cout << "  Input > ";
     }
@@ -245,12 +253,12 @@ namespace SevenWondersDuel {
         std::cout << "Wonder: ";
         for(auto w : p.getBuiltWonders()) {
             int currentId = wonderCounter++;
-            ctx.wonderIdMap[currentId] = w->getId();
+            ctx.wonderIdMap[currentId] = w->getIndex();
             std::cout << "\033[32m[W" << currentId << "][X]" << w->getName() << "\033[0m  ";
         }
         for(auto w : p.getUnbuiltWonders()) {
             int currentId = wonderCounter++;
-            ctx.wonderIdMap[currentId] = w->getId();
+            ctx.wonderIdMap[currentId] = w->getIndex();
             std::cout << "[W" << currentId << "][ ]" << w->getName() << "  ";
         }
         std::cout << "\n";
@@ -259,9 +267,9 @@ namespace SevenWondersDuel {
             ctx.oppCardIdMap.clear();
             std::cout << "Built Cards (Select to Destroy): \n";
             int idx = 1;
-            for(auto c : p.getBuiltCards()) {
+            for(auto c : p.getAllCards()) {
                 std::string idStr = "T" + std::to_string(idx);
-                ctx.oppCardIdMap[idx] = c->getId();
+                ctx.oppCardIdMap[idx] = c->getIndex();
 
                 std::cout << "  [" << idStr << "] " << getTypeStr(c->getType()) << " " << c->getName();
                 if (idx % 3 == 0) std::cout << "\n";
@@ -276,13 +284,14 @@ namespace SevenWondersDuel {
     void GameView::renderPyramid(const GameModel& model, RenderContext& ctx) {
         std::cout << "           PYRAMID (" << model.getRemainingCardCount() << ") | DISCARD (" << model.getBoard()->getDiscardPile().size() << ")\n";
 
-        const auto& slots = model.getBoard()->getCardStructure().getSlots();
-        if (slots.empty()) return;
+        const CardPyramid& pyramid = model.getBoard()->getCardStructure();
+        if (pyramid.getSlotCount() == 0) return;
 
-        std::map<int, std::vector<const CardSlot*>> rows;
+        std::map<int, std::vector<int>> rows;
         int maxRow = 0;
-        for (const auto& slot : slots) {
-            rows[slot.getRow()].push_back(&slot);
+        for (int s = 0; s < pyramid.getSlotCount(); ++s) {
+            const CardSlot& slot = pyramid.getSlot(s);
+            rows[slot.getRow()].push_back(s);
             if (slot.getRow() > maxRow) maxRow = slot.getRow();
         }
 
@@ -302,14 +311,14 @@ namespace SevenWondersDuel {
             std::cout << std::string(std::max(0, padding), ' ');
 
             for (size_t i = 0; i < rowSlots.size(); ++i) {
-                const auto* slot = rowSlots[i];
-                int absIndex = (&(*slot) - &slots[0]) + 1;
+                int s = rowSlots[i];
+                int absIndex = s + 1;
 
-                if (slot->isRemoved()) std::cout << "           ";
-                else if (!slot->isFaceUp()) std::cout << " [\033[90m ? ? ? \033[0m] ";
+                if (pyramid.isRemoved(s)) std::cout << "           ";
+                else if (!pyramid.isFaceUp(s)) std::cout << " [\033[90m ? ? ? \033[0m] ";
                 else {
-                    Card* c = slot->getCardPtr();
-                    ctx.cardIdMap[absIndex] = c->getId();
+                    const Card* c = pyramid.getSlot(s).getCardPtr();
+                    ctx.cardIdMap[absIndex] = c->getIndex();
                     std::string label = " C" + std::to_string(absIndex) + " ";
                     while(label.length() < 7) label += " ";
                     std::cout << " [" << getCardColorCode(c->getType()) << label << getResetColor() << "] ";
@@ -336,6 +345,12 @@ namespace SevenWondersDuel {
     }
 
     void GameView::renderCommandHelp(GameState state) {
+        if (!m_replayStatus.empty()) {
+            std::cout << " \033[1;36m[REPLAY]\033[0m " << m_replayStatus << "\n";
+            std::cout << " [CMD] next/prev [N], jump <N>, start, end\n";
+            std::cout << "       log, detail <1/2>, quit\n";
+            return;
+        }
         std::cout << " [CMD] ";
         switch (state) {
             case GameState::WONDER_DRAFT_PHASE_1:
@@ -439,7 +454,7 @@ namespace SevenWondersDuel {
         if (pile.empty()) std::cout << "  (Discard pile is empty)\n";
 
         for(auto c : pile) {
-            ctx.discardIdMap[idx] = c->getId();
+            ctx.discardIdMap[idx] = c->getIndex();
             std::cout << "  [D" << idx++ << "] " << c->getName() << " (" << getTypeStr(c->getType()) << ")\n";
         }
         printLine('-');
@@ -452,6 +467,12 @@ namespace SevenWondersDuel {
         printLine('='); printCentered("CHOOSE STARTING PLAYER"); printLine('=');
         std::cout << "  \033[1;33m[" << model.getCurrentPlayer()->getName() << "]\033[0m decides who starts the next Age.\n";
         std::cout << "  (Decision based on military strength or last played turn)\n\n";
+        if (!m_replayStatus.empty()) {
+            printLine('-');
+            renderErrorMessage(lastError);
+            renderCommandHelp(GameState::WAITING_FOR_START_PLAYER_SELECTION);
+            return;
+        }
         std::cout << "  Available Commands:\n";
         std::cout << "  > \033[32mchoose me\033[0m        (You take the first turn)\n";
         std::cout << "  > \033[32mchoose opponent\033[0m  (" << model.getOpponent()->getName() << " takes the first turn)\n";
@@ -507,6 +528,17 @@ namespace SevenWondersDuel {
         renderGame(model, state, dummy, "");
     }
 
+    void GameView::renderReplay(const GameModel& model, GameState state, const std::string& title, size_t position, size_t total, const std::string& lastError) {
+        std::ostringstream status;
+        status << title << "  action " << position << " / " << total;
+        if (state == GameState::GAME_OVER) status << "  (game over)";
+
+        RenderContext dummy;
+        m_replayStatus = status.str();
+        renderGame(model, state, dummy, lastError);
+        m_replayStatus.clear();
+    }
+
     // ========================================================== 
     //  详情页 (View Only Screens)
     // ========================================================== 
@@ -526,7 +558,10 @@ namespace SevenWondersDuel {
         for (auto t : types) std::cout << p.getTradingPrice(t, opp) << "$ ";
 
         std::cout << "\n [3] SCIENCE: ";
-        for(auto const& [s, c] : p.getScienceSymbols()) { if(c>0 && s!=ScienceSymbol::NONE) std::cout << "[" << (int)s << "]x" << c << " "; } // Corrected: Use const auto& for map iteration
+        for(int s = static_cast<int>(ScienceSymbol::GLOBE); s <= static_cast<int>(ScienceSymbol::LAW); ++s) {
+            int c = p.getScienceSymbolCount(static_cast<ScienceSymbol>(s));
+            if (c > 0) std::cout << "[" << s << "]x" << c << " ";
+        }
         std::cout << "\n [4] WONDERS:\n";
         for(auto w : p.getBuiltWonders()) std::cout << "     [Built] " << w->getName() << "\n";
         for(auto w : p.getUnbuiltWonders()) std::cout << "     [Plan ] " << w->getName() << "\n";
@@ -558,7 +593,7 @@ namespace SevenWondersDuel {
         printLine('='); std::cout << " (Press Enter)"; std::cin.get();
     }
 
-    void GameView::renderDiscardPile(const std::vector<Card*>& pile) {
+    void GameView::renderDiscardPile(const std::vector<const Card*>& pile) {
         clearScreen(); printLine('='); printCentered("DISCARD PILE (" + std::to_string(pile.size()) + ")");
         int idx = 1; for(auto c : pile) std::cout << "  [D" << idx++ << "] " << c->getName() << " (" << getTypeStr(c->getType()) << ")\n";
         printLine('='); std::cout << " (Press Enter)"; std::cin.get();
@@ -52,11 +52,11 @@ namespace SevenWondersDuel {
 
                 bool found = false;
                 if (!found && cId!=-1 && m_ctx.cardIdMap.count(cId)) {
-                    const Card* c = model.findCardById(m_ctx.cardIdMap[cId]);
+                    const Card* c = model.getCard(m_ctx.cardIdMap[cId]);
                     if (c) { view.renderCardDetail(*c); found = true; }
                 }
                 if (!found && wId!=-1 && m_ctx.wonderIdMap.count(wId)) {
-                    const Wonder* w = model.findWonderById(m_ctx.wonderIdMap[wId]);
+                    const Wonder* w = model.getWonder(m_ctx.wonderIdMap[wId]);
                     if (w) { view.renderWonderDetail(*w); found = true; }
                 }
                 if (!found && sId!=-1) {
@@ -64,7 +64,7 @@ namespace SevenWondersDuel {
                     else if (m_ctx.boxTokenIdMap.count(sId)) { view.renderTokenDetail(m_ctx.boxTokenIdMap[sId]); found=true; }
                 }
                 if (!found && tId!=-1 && m_ctx.oppCardIdMap.count(tId)) {
-                    const Card* c = model.findCardById(m_ctx.oppCardIdMap[tId]);
+                    const Card* c = model.getCard(m_ctx.oppCardIdMap[tId]);
                     if (c) { view.renderCardDetail(*c); found = true; }
                 }
 
@@ -77,7 +77,7 @@ namespace SevenWondersDuel {
                     int idx = parseId(arg1, ' ');
                     if (idx >= 1 && idx <= (int)model.getDraftPool().size()) {
                         act.type = ActionType::DRAFT_WONDER;
-                        act.targetWonderId = model.getDraftPool()[idx-1]->getId();
+                        act.targetWonder = model.getDraftPool()[idx-1]->getIndex();
                         return act;
                     } else setLastError("Invalid index.");
                 } else setLastError("Use 'pick <N>'.");
@@ -99,13 +99,13 @@ namespace SevenWondersDuel {
                     int id = parseId(arg1, 'T');
                     if (m_ctx.oppCardIdMap.count(id)) {
                         act.type = ActionType::SELECT_DESTRUCTION;
-                        act.targetCardId = m_ctx.oppCardIdMap[id];
+                        act.targetCard = m_ctx.oppCardIdMap[id];
                         return act;
                     } else setLastError("Invalid Target ID (T1, T2...). ");
                 }
                 else if (cmd == "skip") {
                     act.type = ActionType::SELECT_DESTRUCTION;
-                    act.targetCardId = "";
+                    act.targetCard = NO_CARD;
                     return act;
                 } else setLastError("Use 'destroy <ID>' or 'skip'.");
             }
@@ -114,7 +114,7 @@ namespace SevenWondersDuel {
                     int id = parseId(arg1, 'D');
                     if (m_ctx.discardIdMap.count(id)) {
                         act.type = ActionType::SELECT_FROM_DISCARD;
-                        act.targetCardId = m_ctx.discardIdMap[id];
+                        act.targetCard = m_ctx.discardIdMap[id];
                         return act;
                     } else setLastError("Invalid Discard ID (D1...). ");
                 } else setLastError("Use 'resurrect <ID>'.");
@@ -123,11 +123,11 @@ namespace SevenWondersDuel {
                 if (cmd == "choose") {
                     if (arg1 == "me") {
                         act.type = ActionType::CHOOSE_STARTING_PLAYER;
-                        act.targetCardId = "ME";
+                        act.chooseSelf = true;
                         return act;
                     } else if (arg1 == "opponent" || arg1 == "opp") {
                         act.type = ActionType::CHOOSE_STARTING_PLAYER;
-                        act.targetCardId = "OPPONENT";
+                        act.chooseSelf = false;
                         return act;
                     } else setLastError("Choose 'me' or 'opponent'.");
                 } else setLastError("Use 'choose me' or 'choose opponent'.");
@@ -137,7 +137,7 @@ namespace SevenWondersDuel {
                     int id = parseId(arg1, 'C');
                     if (m_ctx.cardIdMap.count(id)) {
                         act.type = (cmd == "build") ? ActionType::BUILD_CARD : ActionType::DISCARD_FOR_COINS;
-                        act.targetCardId = m_ctx.cardIdMap[id];
+                        act.targetCard = m_ctx.cardIdMap[id];
                         return act;
                     } else setLastError("Invalid Card ID (C1...). ");
                 }
@@ -146,8 +146,8 @@ namespace SevenWondersDuel {
                     int wId = parseId(arg2, 'W');
                     if (m_ctx.cardIdMap.count(cId) && m_ctx.wonderIdMap.count(wId)) {
                         act.type = ActionType::BUILD_WONDER;
-                        act.targetCardId = m_ctx.cardIdMap[cId];
-                        act.targetWonderId = m_ctx.wonderIdMap[wId];
+                        act.targetCard = m_ctx.cardIdMap[cId];
+                        act.targetWonder = m_ctx.wonderIdMap[wId];
                         return act;
                     } else setLastError("Format: wonder C<ID> W<ID>");
                 }
@@ -157,4 +157,46 @@ namespace SevenWondersDuel {
         }
     }
 
+
+    bool InputManager::promptReplaySeek(GameView& view, const GameModel& model, GameState state, const std::string& title,
+                                        size_t position, size_t total, size_t& target) {
+        while (true) {
+            view.renderReplay(model, state, title, position, total, m_lastError);
+
+            std::cout << "\n replay > ";
+
+            std::string line;
+            if (!std::getline(std::cin, line)) return false;
+            if (line.empty()) line = "next";
+
+            clearLastError();
+            std::stringstream ss(line);
+            std::string cmd; ss >> cmd;
+            std::string arg1; ss >> arg1;
+
+            if (cmd == "quit" || cmd == "q") return false;
+            if (cmd == "log") { view.renderFullLog(model.getGameLog()); continue; }
+            if (cmd == "detail") {
+                int pIdx = (arg1 == "2") ? 1 : 0;
+                view.renderPlayerDetailFull(*model.getPlayers()[pIdx], *model.getPlayers()[1-pIdx], *model.getBoard());
+                continue;
+            }
+
+            long long pos = static_cast<long long>(position);
+            long long n = arg1.empty() ? 1 : parseId(arg1, ' ');
+            if (n < 0 || ((cmd == "jump" || cmd == "j") && arg1.empty())) { setLastError("Use 'jump <N>' or 'next/prev [N]'."); continue; }
+
+            long long dest;
+            if (cmd == "next" || cmd == "n") dest = pos + n;
+            else if (cmd == "prev" || cmd == "p") dest = pos - n;
+            else if (cmd == "jump" || cmd == "j") dest = n;
+            else if (cmd == "start") dest = 0;
+            else if (cmd == "end") dest = static_cast<long long>(total);
+            else { setLastError("Unknown command."); continue; }
+
+            target = static_cast<size_t>(std::clamp(dest, 0LL, static_cast<long long>(total)));
+            return true;
+        }
+    }
+
 }
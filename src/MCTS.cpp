@@ -0,0 +1,635 @@
+#include "MCTS.h"
+#include "GameController.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <thread>
+
+namespace SevenWondersDuel {
+
+    namespace {
+        // 截止时间模式下每隔多少次迭代读一次时钟
+        constexpr int CLOCK_CHECK_INTERVAL = 32;
+
+        bool isBuildAction(ActionType type) {
+            return type == ActionType::BUILD_CARD || type == ActionType::BUILD_WONDER;
+        }
+
+        bool sameAction(const Action& a, const Action& b) {
+            return a.type == b.type && a.targetCard == b.targetCard && a.targetWonder == b.targetWonder &&
+                   a.selectedToken == b.selectedToken && a.chooseSelf == b.chooseSelf;
+        }
+
+        Action invalidAction() {
+            Action none;
+            none.type = static_cast<ActionType>(-1);
+            return none;
+        }
+
+        // 终局 (或模拟被截断) 时的胜者：0 / 1，平局为 -1
+        int scoreWinner(const GameModel& model) {
+            int s0 = model.getPlayers()[0]->getScore(*model.getPlayers()[1]);
+            int s1 = model.getPlayers()[1]->getScore(*model.getPlayers()[0]);
+            if (s0 != s1) return s0 > s1 ? 0 : 1;
+            return -1;
+        }
+
+        double rewardFor(int winner, int player) {
+            if (winner < 0) return 0.5;
+            return winner == player ? 1.0 : 0.0;
+        }
+
+        /**
+         * @brief 从 state 快速走到终局
+         * @return 获胜玩家 (0/1)，平局为 -1
+         */
+        int playout(GameController& state, std::vector<LegalAction>& legal, Xoshiro256& rng, const MCTSConfig& config) {
+            for (int step = 0; step < config.maxRolloutActions; ++step) {
+                if (state.getState() == GameState::GAME_OVER) return state.getModel().getWinnerIndex();
+
+                state.generateLegalActions(legal);
+                if (legal.empty()) break;
+
+                // 启发式：只要能建造就不弃牌
+                size_t candidates = legal.size();
+                if (config.heuristicRollout) {
+                    auto mid = std::partition(legal.begin(), legal.end(),
+                                              [](const LegalAction& la) { return isBuildAction(la.action.type); });
+                    size_t builds = static_cast<size_t>(mid - legal.begin());
+                    if (builds > 0) candidates = builds;
+                }
+
+                std::uniform_int_distribution<size_t> dist(0, candidates - 1);
+                if (!state.processAction(legal[dist(rng)].action)) break;
+            }
+
+            if (state.getState() == GameState::GAME_OVER) return state.getModel().getWinnerIndex();
+            return scoreWinner(state.getModel());
+        }
+    }
+
+    // ==========================================================
+    //  SharedTree (树并行)
+    // ==========================================================
+
+    /**
+     * 节点池按容量一次性分配，搜索期间只通过原子计数追加，已发布的节点地址不会变化。
+     * 展开状态 0 → 1 由 CAS 抢占，只有抢到的线程写子节点区间，随后以 release 发布为 2；
+     * 其他线程读到 1 时不等待，直接从当前节点开始模拟。
+     */
+    struct MCTSAgent::SharedTree {
+        struct Node {
+            Action action;
+            int firstChild = -1;
+            int childCount = 0;
+            int mover = 0;
+            std::atomic<int> expansion{0};       // 0 未展开 / 1 展开中 / 2 已展开
+            std::atomic<int> visits{0};
+            std::atomic<int> virtualLoss{0};
+            std::atomic<long long> reward{0};    // 奖励 x2 (胜 2 / 平 1 / 负 0)，整数便于原子累加
+        };
+
+        /**
+         * @brief 线程私有的模拟状态 (跨决策复用)
+         */
+        struct Worker {
+            std::unique_ptr<GameController> sim;
+            Xoshiro256 rng;
+            std::vector<LegalAction> legal;
+            std::vector<int> path;
+        };
+
+        std::unique_ptr<Node[]> nodes;
+        int capacity = 0;
+        std::atomic<int> count{0};
+        std::atomic<long long> iterations{0};
+        std::vector<Worker> workers;
+
+        void reset(int cap) {
+            if (cap != capacity) {
+                nodes.reset(new Node[cap]);
+                capacity = cap;
+            } else {
+                int used = std::min(count.load(), capacity);
+                for (int i = 0; i < used; ++i) {
+                    Node& n = nodes[i];
+                    n.firstChild = -1;
+                    n.childCount = 0;
+                    n.expansion.store(0, std::memory_order_relaxed);
+                    n.visits.store(0, std::memory_order_relaxed);
+                    n.virtualLoss.store(0, std::memory_order_relaxed);
+                    n.reward.store(0, std::memory_order_relaxed);
+                }
+            }
+            count.store(0);
+            iterations.store(0);
+        }
+
+        /**
+         * @brief 预留连续 n 个节点，池满时返回 -1
+         */
+        int allocate(int n) {
+            if (count.load(std::memory_order_relaxed) + n > capacity) return -1;
+            int first = count.fetch_add(n, std::memory_order_relaxed);
+            return (first + n <= capacity) ? first : -1;
+        }
+
+        /**
+         * @brief 展开节点 (仅抢到展开权的线程执行)
+         * @return 展开成功返回 true
+         */
+        bool expand(int index, const GameController& state, Worker& w) {
+            Node& node = nodes[index];
+            int expected = 0;
+            if (!node.expansion.compare_exchange_strong(expected, 1, std::memory_order_acq_rel)) return false;
+
+            state.generateLegalActions(w.legal);
+            std::shuffle(w.legal.begin(), w.legal.end(), w.rng);
+            int n = static_cast<int>(w.legal.size());
+            int first = n > 0 ? allocate(n) : 0;
+            if (first < 0) {
+                node.expansion.store(0, std::memory_order_release); // 池已满：保持为叶子
+                return false;
+            }
+
+            int mover = state.getModel().getCurrentPlayerIndex();
+            for (int i = 0; i < n; ++i) {
+                Node& child = nodes[first + i];
+                child.action = w.legal[i].action;
+                child.mover = mover;
+            }
+            node.firstChild = first;
+            node.childCount = n;
+            node.expansion.store(2, std::memory_order_release);
+            return true;
+        }
+
+        int selectChild(const Node& parent, double exploration) const {
+            int parentVisits = parent.visits.load(std::memory_order_relaxed) + parent.virtualLoss.load(std::memory_order_relaxed);
+            double logN = std::log(static_cast<double>(std::max(1, parentVisits)));
+            int best = parent.firstChild;
+            double bestScore = -1.0;
+
+            for (int c = parent.firstChild; c < parent.firstChild + parent.childCount; ++c) {
+                const Node& child = nodes[c];
+                int n = child.visits.load(std::memory_order_relaxed) + child.virtualLoss.load(std::memory_order_relaxed);
+                if (n == 0) return c;
+                // 虚拟损失只增加访问数、不增加奖励，相当于记为失败
+                double mean = 0.5 * child.reward.load(std::memory_order_relaxed) / n;
+                double ucb = mean + exploration * std::sqrt(logN / n);
+                if (ucb > bestScore) { bestScore = ucb; best = c; }
+            }
+            return best;
+        }
+
+        void runIteration(const GameController& root, Worker& w, const MCTSConfig& config) {
+            GameController& state = *w.sim;
+            state.copyFrom(root);
+            w.path.clear();
+
+            int node = 0;
+            w.path.push_back(node);
+            nodes[node].virtualLoss.fetch_add(config.virtualLoss, std::memory_order_relaxed);
+
+            while (true) {
+                Node& cur = nodes[node];
+                if (cur.expansion.load(std::memory_order_acquire) != 2) {
+                    // 已访问过的叶子尝试展开一层，并走入第一个子节点
+                    if (cur.visits.load(std::memory_order_relaxed) > 0 && state.getState() != GameState::GAME_OVER &&
+                        expand(node, state, w) && cur.childCount > 0) {
+                        node = selectChild(cur, config.exploration);
+                        w.path.push_back(node);
+                        nodes[node].virtualLoss.fetch_add(config.virtualLoss, std::memory_order_relaxed);
+                        state.processAction(nodes[node].action);
+                    }
+                    break;
+                }
+                if (cur.childCount == 0) break;
+
+                node = selectChild(cur, config.exploration);
+                w.path.push_back(node);
+                Node& next = nodes[node];
+                bool fresh = next.visits.load(std::memory_order_relaxed) == 0;
+                next.virtualLoss.fetch_add(config.virtualLoss, std::memory_order_relaxed);
+                if (!state.processAction(next.action)) break;
+                if (fresh) break;
+            }
+
+            int winner = playout(state, w.legal, w.rng, config);
+
+            for (int n : w.path) {
+                Node& nd = nodes[n];
+                nd.reward.fetch_add(static_cast<long long>(2.0 * rewardFor(winner, nd.mover)), std::memory_order_relaxed);
+                nd.visits.fetch_add(1, std::memory_order_relaxed);
+                nd.virtualLoss.fetch_sub(config.virtualLoss, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    // ==========================================================
+    //  MCTSAgent
+    // ==========================================================
+
+    MCTSAgent::MCTSAgent(MCTSConfig config, bool showThinking)
+        : m_config(config), m_showThinking(showThinking), m_rng(std::random_device{}()) {}
+
+    MCTSAgent::~MCTSAgent() = default;
+
+    Action MCTSAgent::decideAction(GameController& game, GameView& view, InputManager& input) {
+        if (m_showThinking) {
+            std::cout << "\033[1;33m[MCTS] 正在思考...\033[0m" << std::endl;
+        }
+
+        Action best = search(game);
+
+        if (m_showThinking) {
+            std::cout << "\033[1;33m[MCTS] " << m_lastStats.iterations << " 次迭代 (" << m_lastStats.threads << " 线程), "
+                      << std::fixed << std::setprecision(0) << m_lastStats.iterationsPerSecond() << " it/s, "
+                      << "最佳动作访问 " << m_lastStats.rootVisits << " 次\033[0m" << std::endl;
+        }
+        return best;
+    }
+
+    Action MCTSAgent::search(const GameController& root) {
+        auto start = Clock::now();
+        m_lastStats = MCTSStats();
+
+        // 只有一个合法动作时无需搜索
+        root.generateLegalActions(m_legalActions);
+        if (m_legalActions.size() <= 1) {
+            m_lastStats.nodes = 1 + static_cast<long long>(m_legalActions.size());
+            return m_legalActions.empty() ? invalidAction() : m_legalActions[0].action;
+        }
+
+        bool timed = m_config.timeLimitMs > 0.0;
+        auto deadline = start + std::chrono::duration_cast<Clock::duration>(
+                                    std::chrono::duration<double, std::milli>(m_config.timeLimitMs));
+        int threads = std::max(1, m_config.threads);
+        m_lastStats.threads = threads;
+
+        Action best;
+        if (threads > 1 && m_config.parallelMode == MCTSParallelMode::TREE) {
+            best = searchTreeParallel(root, threads, timed, deadline);
+        } else if (threads > 1) {
+            best = searchRootParallel(root, threads, timed, deadline);
+        } else {
+            m_lastStats.iterations = searchSerial(root, m_config.iterations, timed, deadline);
+            m_lastStats.nodes = static_cast<long long>(m_nodes.size());
+
+            const Node& rootNode = m_nodes[0];
+            int bestChild = rootNode.firstChild;
+            for (int c = rootNode.firstChild; c < rootNode.firstChild + rootNode.childCount; ++c) {
+                if (m_nodes[c].visits > m_nodes[bestChild].visits) bestChild = c;
+            }
+            m_lastStats.rootVisits = m_nodes[bestChild].visits;
+            best = m_nodes[bestChild].action;
+        }
+
+        m_lastStats.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        return best;
+    }
+
+    long long MCTSAgent::searchSerial(const GameController& root, long long iterations, bool timed, Clock::time_point deadline) {
+        if (!m_sim) m_sim = root.clone();
+
+        m_nodes.clear();
+        m_nodes.emplace_back();
+        m_nodes[0].mover = 1 - root.getModel().getCurrentPlayerIndex();
+        expand(0, root);
+
+        long long done = 0;
+        while (true) {
+            if (timed) {
+                if (done % CLOCK_CHECK_INTERVAL == 0 && Clock::now() >= deadline) break;
+            } else if (done >= iterations) {
+                break;
+            }
+            runIteration(root);
+            done++;
+        }
+        return done;
+    }
+
+    Action MCTSAgent::searchRootParallel(const GameController& root, int threads, bool timed, Clock::time_point deadline) {
+        // 其余线程各用一个单线程搜索器；本线程自身也建一棵树
+        MCTSConfig workerConfig = m_config;
+        workerConfig.threads = 1;
+        while (static_cast<int>(m_rootWorkers.size()) < threads - 1) {
+            m_rootWorkers.push_back(std::make_unique<MCTSAgent>(workerConfig, false));
+        }
+        for (int i = 0; i < threads - 1; ++i) m_rootWorkers[i]->m_rng = Xoshiro256(m_rng());
+
+        // 迭代预算在各棵树间均分
+        long long share = m_config.iterations / threads;
+        long long extra = m_config.iterations % threads;
+        std::vector<long long> done(threads, 0);
+
+        std::vector<std::thread> pool;
+        for (int i = 1; i < threads; ++i) {
+            pool.emplace_back([&, i]() {
+                done[i] = m_rootWorkers[i - 1]->searchSerial(root, share + (i < extra ? 1 : 0), timed, deadline);
+            });
+        }
+        done[0] = searchSerial(root, share + (0 < extra ? 1 : 0), timed, deadline);
+        for (auto& t : pool) t.join();
+
+        // join 之后按根动作合并访问次数
+        struct Merged { Action action; int visits; };
+        std::vector<Merged> merged;
+        auto mergeTree = [&](const MCTSAgent& tree) {
+            const Node& r = tree.m_nodes[0];
+            for (int c = r.firstChild; c < r.firstChild + r.childCount; ++c) {
+                const Node& child = tree.m_nodes[c];
+                auto it = std::find_if(merged.begin(), merged.end(),
+                                       [&](const Merged& m) { return sameAction(m.action, child.action); });
+                if (it == merged.end()) merged.push_back({child.action, child.visits});
+                else it->visits += child.visits;
+            }
+            m_lastStats.nodes += static_cast<long long>(tree.m_nodes.size());
+        };
+        mergeTree(*this);
+        for (int i = 0; i < threads - 1; ++i) mergeTree(*m_rootWorkers[i]);
+
+        for (long long d : done) m_lastStats.iterations += d;
+
+        auto best = std::max_element(merged.begin(), merged.end(),
+                                     [](const Merged& a, const Merged& b) { return a.visits < b.visits; });
+        m_lastStats.rootVisits = best->visits;
+        return best->action;
+    }
+
+    Action MCTSAgent::searchTreeParallel(const GameController& root, int threads, bool timed, Clock::time_point deadline) {
+        if (!m_sharedTree) m_sharedTree = std::make_unique<SharedTree>();
+        SharedTree& tree = *m_sharedTree;
+        // m_legalActions 仍是 search() 生成的根动作：容量至少容纳根及其子节点
+        tree.reset(std::max(m_config.treeNodeCapacity, 1 + static_cast<int>(m_legalActions.size())));
+
+        while (static_cast<int>(tree.workers.size()) < threads) {
+            tree.workers.emplace_back();
+            tree.workers.back().sim = root.clone();
+        }
+        for (int i = 0; i < threads; ++i) tree.workers[i].rng = Xoshiro256(m_rng());
+
+        // 根节点：分配并立即展开
+        int rootIndex = tree.allocate(1);
+        tree.nodes[rootIndex].mover = 1 - root.getModel().getCurrentPlayerIndex();
+        tree.expand(rootIndex, root, tree.workers[0]);
+
+        long long budget = m_config.iterations;
+        auto workerMain = [&](int self) {
+            SharedTree::Worker& w = tree.workers[self];
+            long long local = 0;
+            while (true) {
+                if (timed) {
+                    if (local % CLOCK_CHECK_INTERVAL == 0 && Clock::now() >= deadline) break;
+                } else if (tree.iterations.fetch_add(1, std::memory_order_relaxed) >= budget) {
+                    break;
+                }
+                tree.runIteration(root, w, m_config);
+                local++;
+            }
+            if (timed) tree.iterations.fetch_add(local, std::memory_order_relaxed);
+        };
+
+        std::vector<std::thread> pool;
+        for (int i = 1; i < threads; ++i) pool.emplace_back(workerMain, i);
+        workerMain(0);
+        for (auto& t : pool) t.join();
+
+        const SharedTree::Node& r = tree.nodes[rootIndex];
+        int bestChild = r.firstChild;
+        for (int c = r.firstChild; c < r.firstChild + r.childCount; ++c) {
+            if (tree.nodes[c].visits.load() > tree.nodes[bestChild].visits.load()) bestChild = c;
+        }
+
+        m_lastStats.iterations = timed ? tree.iterations.load() : std::min(tree.iterations.load(), budget);
+        m_lastStats.nodes = std::min(tree.count.load(), tree.capacity);
+        m_lastStats.rootVisits = tree.nodes[bestChild].visits.load();
+        return tree.nodes[bestChild].action;
+    }
+
+    void MCTSAgent::runIteration(const GameController& root) {
+        GameController& state = *m_sim;
+        state.copyFrom(root);
+
+        m_path.clear();
+        int node = 0;
+        m_path.push_back(node);
+
+        // 1. 选择：沿 UCT 下降直到未展开节点或终局
+        while (m_nodes[node].expanded && m_nodes[node].childCount > 0) {
+            node = selectChild(m_nodes[node]);
+            m_path.push_back(node);
+            if (!state.processAction(m_nodes[node].action)) break; // 完全信息下不会发生，保险起见截断
+            if (m_nodes[node].visits == 0) break;                  // 新节点：直接进入模拟
+        }
+
+        // 2. 扩展：已访问过的叶子展开一层
+        if (!m_nodes[node].expanded && m_nodes[node].visits > 0 && state.getState() != GameState::GAME_OVER) {
+            expand(node, state);
+            if (m_nodes[node].childCount > 0) {
+                node = m_nodes[node].firstChild; // 子节点顺序已打乱
+                m_path.push_back(node);
+                state.processAction(m_nodes[node].action);
+            }
+        }
+
+        // 3. 模拟
+        int winner = playout(state, m_legalActions, m_rng, m_config);
+
+        // 4. 回传
+        for (int n : m_path) {
+            Node& nd = m_nodes[n];
+            nd.visits++;
+            nd.value += rewardFor(winner, nd.mover);
+        }
+    }
+
+    int MCTSAgent::selectChild(const Node& parent) const {
+        double logN = std::log(static_cast<double>(std::max(1, parent.visits)));
+        int best = parent.firstChild;
+        double bestScore = -1.0;
+
+        for (int c = parent.firstChild; c < parent.firstChild + parent.childCount; ++c) {
+            const Node& child = m_nodes[c];
+            if (child.visits == 0) return c;
+            double ucb = child.value / child.visits + m_config.exploration * std::sqrt(logN / child.visits);
+            if (ucb > bestScore) { bestScore = ucb; best = c; }
+        }
+        return best;
+    }
+
+    void MCTSAgent::expand(int nodeIndex, const GameController& state) {
+        state.generateLegalActions(m_legalActions);
+        std::shuffle(m_legalActions.begin(), m_legalActions.end(), m_rng);
+
+        int mover = state.getModel().getCurrentPlayerIndex();
+        int first = static_cast<int>(m_nodes.size());
+        for (const auto& la : m_legalActions) {
+            Node child;
+            child.action = la.action;
+            child.mover = mover;
+            m_nodes.push_back(child);
+        }
+
+        // push_back 可能使引用失效，最后再写回父节点
+        Node& parent = m_nodes[nodeIndex];
+        parent.firstChild = first;
+        parent.childCount = static_cast<int>(m_legalActions.size());
+        parent.expanded = true;
+    }
+
+    // ==========================================================
+    //  ISMCTSAgent
+    // ==========================================================
+
+    ISMCTSAgent::ISMCTSAgent(MCTSConfig config, bool showThinking)
+        : m_config(config), m_showThinking(showThinking), m_rng(std::random_device{}()) {}
+
+    ISMCTSAgent::~ISMCTSAgent() = default;
+
+    Action ISMCTSAgent::decideAction(GameController& game, GameView& view, InputManager& input) {
+        if (m_showThinking) {
+            std::cout << "\033[1;33m[ISMCTS] 正在思考...\033[0m" << std::endl;
+        }
+
+        Action best = search(game);
+
+        if (m_showThinking) {
+            std::cout << "\033[1;33m[ISMCTS] " << m_lastStats.iterations << " 次迭代 (每次重新抽样隐藏卡牌), "
+                      << std::fixed << std::setprecision(0) << m_lastStats.iterationsPerSecond() << " it/s, "
+                      << "最佳动作访问 " << m_lastStats.rootVisits << " 次\033[0m" << std::endl;
+        }
+        return best;
+    }
+
+    Action ISMCTSAgent::search(const GameController& root) {
+        auto start = std::chrono::steady_clock::now();
+        m_lastStats = MCTSStats();
+
+        // 根的合法动作只取决于公开信息，与抽样无关
+        root.generateLegalActions(m_legalActions);
+        if (m_legalActions.size() <= 1) {
+            m_lastStats.nodes = 1 + static_cast<long long>(m_legalActions.size());
+            return m_legalActions.empty() ? invalidAction() : m_legalActions[0].action;
+        }
+        std::vector<LegalAction> rootActions = m_legalActions;
+
+        if (!m_sim) m_sim = root.clone();
+        m_nodes.clear();
+        m_nodes.emplace_back();
+        m_nodes[0].mover = 1 - root.getModel().getCurrentPlayerIndex();
+
+        bool timed = m_config.timeLimitMs > 0.0;
+        auto deadline = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                    std::chrono::duration<double, std::milli>(m_config.timeLimitMs));
+
+        long long iterations = 0;
+        while (true) {
+            if (timed) {
+                if (iterations % CLOCK_CHECK_INTERVAL == 0 && std::chrono::steady_clock::now() >= deadline) break;
+            } else if (iterations >= m_config.iterations) {
+                break;
+            }
+            runIteration(root);
+            iterations++;
+        }
+
+        // 访问次数最多、且在真实局面中合法的根动作
+        int bestChild = -1;
+        for (int c = m_nodes[0].firstChild; c != -1; c = m_nodes[c].nextSibling) {
+            bool legal = std::any_of(rootActions.begin(), rootActions.end(),
+                                     [&](const LegalAction& la) { return sameAction(la.action, m_nodes[c].action); });
+            if (legal && (bestChild < 0 || m_nodes[c].visits > m_nodes[bestChild].visits)) bestChild = c;
+        }
+
+        m_lastStats.iterations = iterations;
+        m_lastStats.nodes = static_cast<long long>(m_nodes.size());
+        m_lastStats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (bestChild < 0) return rootActions[0].action;
+        m_lastStats.rootVisits = m_nodes[bestChild].visits;
+        return m_nodes[bestChild].action;
+    }
+
+    void ISMCTSAgent::runIteration(const GameController& root) {
+        GameController& state = *m_sim;
+        state.copyFrom(root);
+        m_determinizer.sample(state, m_rng);
+
+        m_path.clear();
+        int node = 0;
+        m_path.push_back(node);
+
+        while (state.getState() != GameState::GAME_OVER) {
+            state.generateLegalActions(m_legalActions);
+            int n = static_cast<int>(m_legalActions.size());
+            if (n == 0) break;
+
+            // 当前抽样下每个合法动作对应的已有子节点
+            m_matched.assign(n, -1);
+            int untried = n;
+            for (int c = m_nodes[node].firstChild; c != -1; c = m_nodes[c].nextSibling) {
+                for (int i = 0; i < n; ++i) {
+                    if (m_matched[i] < 0 && sameAction(m_legalActions[i].action, m_nodes[c].action)) {
+                        m_matched[i] = c;
+                        untried--;
+                        break;
+                    }
+                }
+            }
+
+            int mover = state.getModel().getCurrentPlayerIndex();
+
+            // 扩展：随机添加一个尚未尝试的动作，然后进入模拟
+            if (untried > 0) {
+                std::uniform_int_distribution<int> dist(0, untried - 1);
+                int pick = dist(m_rng);
+                int chosen = 0;
+                for (int i = 0; i < n; ++i) {
+                    if (m_matched[i] >= 0) continue;
+                    if (pick-- == 0) { chosen = i; break; }
+                }
+
+                Node child;
+                child.action = m_legalActions[chosen].action;
+                child.mover = mover;
+                child.availability = 1;
+                child.nextSibling = m_nodes[node].firstChild;
+                int index = static_cast<int>(m_nodes.size());
+                m_nodes.push_back(child);
+                m_nodes[node].firstChild = index;
+
+                m_path.push_back(index);
+                state.processAction(child.action);
+                break;
+            }
+
+            // 选择：只比较当前抽样中可用的子节点
+            double bestScore = -1.0;
+            int best = -1;
+            for (int i = 0; i < n; ++i) {
+                Node& child = m_nodes[m_matched[i]];
+                child.availability++;
+                double ucb = child.value / child.visits +
+                             m_config.exploration * std::sqrt(std::log(static_cast<double>(child.availability)) / child.visits);
+                if (ucb > bestScore) { bestScore = ucb; best = m_matched[i]; }
+            }
+
+            node = best;
+            m_path.push_back(node);
+            if (!state.processAction(m_nodes[node].action)) break;
+        }
+
+        int winner = playout(state, m_legalActions, m_rng, m_config);
+
+        for (int n : m_path) {
+            Node& nd = m_nodes[n];
+            nd.visits++;
+            nd.value += rewardFor(winner, nd.mover);
+        }
+    }
+
+}
@@ -0,0 +1,402 @@
+#include "PackedState.h"
+#include "GameController.h"
+#include "EffectSystem.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace SevenWondersDuel {
+
+    namespace {
+        // 位置码
+        enum CardLoc : int { CARD_NONE, CARD_BUILT_P0, CARD_BUILT_P1, CARD_OVERLAY_P0, CARD_OVERLAY_P1, CARD_DISCARD, CARD_LOC_COUNT };
+        enum WonderLoc : int { WONDER_NONE, WONDER_DECK, WONDER_DRAFT, WONDER_UNBUILT_P0, WONDER_BUILT_P0, WONDER_UNBUILT_P1, WONDER_BUILT_P1, WONDER_LOC_COUNT };
+        enum TokenLoc : int { TOKEN_NONE, TOKEN_BOARD, TOKEN_BOX, TOKEN_P0, TOKEN_P1, TOKEN_LOC_COUNT };
+
+        // 字段宽度 (位)
+        constexpr int STATE_BITS = 4, AGE_BITS = 2, PLAYER_BITS = 1, WINNER_BITS = 2, VICTORY_BITS = 2;
+        constexpr int FLAG_BITS = 1, CARD_TYPE_BITS = 3, DRAFT_TURN_BITS = 3;
+        constexpr int SLOT_COUNT_BITS = 5, SLOT_CARD_BITS = 7, LOC_BITS = 3;
+        constexpr int COIN_BITS = 8, PAIR_BITS = 8, MILITARY_BITS = 5, LOOT_BITS = 4;
+
+        constexpr std::uint64_t EMPTY_SLOT = (1u << SLOT_CARD_BITS) - 1;
+        constexpr int MILITARY_BIAS = 9;   // 军事位置 [-9, 9] 偏移为 [0, 18]
+
+        constexpr int HEADER_BITS = STATE_BITS + AGE_BITS + PLAYER_BITS + WINNER_BITS + VICTORY_BITS
+                                  + FLAG_BITS + CARD_TYPE_BITS + DRAFT_TURN_BITS;
+        constexpr int PYRAMID_BITS = SLOT_COUNT_BITS + 2 * Config::PYRAMID_SLOTS + SLOT_CARD_BITS * Config::PYRAMID_SLOTS;
+        constexpr int LOCATION_BITS = LOC_BITS * (StatePacker::MAX_CARDS + StatePacker::MAX_WONDERS + StatePacker::MAX_TOKENS);
+        constexpr int PLAYER_STATE_BITS = 2 * (COIN_BITS + PAIR_BITS) + MILITARY_BITS + LOOT_BITS;
+        constexpr int TOTAL_BITS = HEADER_BITS + PYRAMID_BITS + LOCATION_BITS + PLAYER_STATE_BITS;
+
+        static_assert(TOTAL_BITS <= 64 * PackedState::WORDS, "packed fields exceed 128 bytes");
+        static_assert(Config::PYRAMID_SLOTS < (1 << SLOT_COUNT_BITS), "slot count field too narrow");
+        static_assert(StatePacker::MAX_CARDS < static_cast<int>(EMPTY_SLOT), "slot card field too narrow");
+
+        class BitWriter {
+        public:
+            explicit BitWriter(PackedState& out) : m_out(out) { m_out.words.fill(0); }
+
+            void put(std::uint64_t value, int bits) {
+                value &= (bits == 64) ? ~0ULL : ((1ULL << bits) - 1);
+                int word = m_pos >> 6, shift = m_pos & 63;
+                m_out.words[word] |= value << shift;
+                if (shift + bits > 64) m_out.words[word + 1] |= value >> (64 - shift);
+                m_pos += bits;
+            }
+
+        private:
+            PackedState& m_out;
+            int m_pos = 0;
+        };
+
+        class BitReader {
+        public:
+            explicit BitReader(const PackedState& in) : m_in(in) {}
+
+            std::uint64_t get(int bits) {
+                int word = m_pos >> 6, shift = m_pos & 63;
+                std::uint64_t value = m_in.words[word] >> shift;
+                if (shift + bits > 64) value |= m_in.words[word + 1] << (64 - shift);
+                m_pos += bits;
+                return value & ((bits == 64) ? ~0ULL : ((1ULL << bits) - 1));
+            }
+
+            int position() const { return m_pos; }
+
+        private:
+            const PackedState& m_in;
+            int m_pos = 0;
+        };
+
+        /**
+         * @brief 解码的中间结果：先完整读出并校验，再一次性写入控制器
+         */
+        struct Decoded {
+            GameState state = GameState::WONDER_DRAFT_PHASE_1;
+            int age = 0;
+            int currentPlayer = 0;
+            int winner = -1;
+            VictoryType victory = VictoryType::NONE;
+            bool extraTurn = false;
+            CardType pendingDestruction = CardType::CIVILIAN;
+            int draftTurnCount = 0;
+
+            int slotCount = 0;
+            CardPyramid::SlotMask removed = 0;
+            CardPyramid::SlotMask faceUp = 0;
+            std::array<std::uint8_t, Config::PYRAMID_SLOTS> slotCards{};
+
+            std::array<std::uint8_t, StatePacker::MAX_CARDS> cardLoc{};
+            std::array<std::uint8_t, StatePacker::MAX_WONDERS> wonderLoc{};
+            std::array<std::uint8_t, StatePacker::MAX_TOKENS> tokenLoc{};
+
+            int coins[2] = {0, 0};
+            std::uint8_t claimedPairs[2] = {0, 0};
+            int militaryPosition = 0;
+            bool loot[4] = {false, false, false, false};
+        };
+
+        bool decode(const PackedState& packed, const CardDatabase& db, Decoded& d) {
+            BitReader in(packed);
+            int state = static_cast<int>(in.get(STATE_BITS));
+            d.age = static_cast<int>(in.get(AGE_BITS));
+            d.currentPlayer = static_cast<int>(in.get(PLAYER_BITS));
+            int winner = static_cast<int>(in.get(WINNER_BITS));
+            int victory = static_cast<int>(in.get(VICTORY_BITS));
+            d.extraTurn = in.get(FLAG_BITS) != 0;
+            d.pendingDestruction = static_cast<CardType>(in.get(CARD_TYPE_BITS));
+            d.draftTurnCount = static_cast<int>(in.get(DRAFT_TURN_BITS));
+            if (state > static_cast<int>(GameState::GAME_OVER) || winner > 2) return false;
+            d.state = static_cast<GameState>(state);
+            d.winner = winner - 1;
+            d.victory = static_cast<VictoryType>(victory);
+
+            d.slotCount = static_cast<int>(in.get(SLOT_COUNT_BITS));
+            d.removed = static_cast<CardPyramid::SlotMask>(in.get(Config::PYRAMID_SLOTS));
+            d.faceUp = static_cast<CardPyramid::SlotMask>(in.get(Config::PYRAMID_SLOTS));
+            if (d.slotCount > Config::PYRAMID_SLOTS) return false;
+            int cardCount = static_cast<int>(db.getCards().size());
+            for (int i = 0; i < Config::PYRAMID_SLOTS; ++i) {
+                d.slotCards[i] = static_cast<std::uint8_t>(in.get(SLOT_CARD_BITS));
+                if (d.slotCards[i] != EMPTY_SLOT && d.slotCards[i] >= cardCount) return false;
+            }
+
+            for (int i = 0; i < StatePacker::MAX_CARDS; ++i) {
+                d.cardLoc[i] = static_cast<std::uint8_t>(in.get(LOC_BITS));
+                if (d.cardLoc[i] >= CARD_LOC_COUNT || (d.cardLoc[i] != CARD_NONE && i >= cardCount)) return false;
+            }
+            int wonderCount = static_cast<int>(db.getWonders().size());
+            for (int i = 0; i < StatePacker::MAX_WONDERS; ++i) {
+                d.wonderLoc[i] = static_cast<std::uint8_t>(in.get(LOC_BITS));
+                if (d.wonderLoc[i] >= WONDER_LOC_COUNT || (d.wonderLoc[i] != WONDER_NONE && i >= wonderCount)) return false;
+            }
+            for (int i = 0; i < StatePacker::MAX_TOKENS; ++i) {
+                d.tokenLoc[i] = static_cast<std::uint8_t>(in.get(LOC_BITS));
+                bool valid = i > static_cast<int>(ProgressToken::NONE) && i <= static_cast<int>(ProgressToken::PHILOSOPHY);
+                if (d.tokenLoc[i] >= TOKEN_LOC_COUNT || (d.tokenLoc[i] != TOKEN_NONE && !valid)) return false;
+            }
+
+            for (int p = 0; p < 2; ++p) {
+                d.coins[p] = static_cast<int>(in.get(COIN_BITS));
+                d.claimedPairs[p] = static_cast<std::uint8_t>(in.get(PAIR_BITS));
+            }
+            d.militaryPosition = static_cast<int>(in.get(MILITARY_BITS)) - MILITARY_BIAS;
+            if (std::abs(d.militaryPosition) > MILITARY_BIAS) return false;
+            for (int i = 0; i < 4; ++i) d.loot[i] = in.get(1) != 0;
+
+            // 填充位必须为 0，否则同一局面会有多种编码
+            while (in.position() < 64 * PackedState::WORDS) {
+                if (in.get(64 - (in.position() & 63)) != 0) return false;
+            }
+            return true;
+        }
+
+        void applyPassiveEffects(const std::vector<std::shared_ptr<IEffect>>& effects, Player* self) {
+            for (const auto& eff : effects) eff->applyPassive(self);
+        }
+
+        /**
+         * @brief 由解码结果重建一名玩家 (卡牌与奇迹的持续效果按索引顺序重新套用)
+         */
+        Player rebuildPlayer(const Decoded& d, int id, const std::string& name, const CardDatabase& db) {
+            Player p(id, name, &db);
+            const std::vector<Card>& cards = db.getCards();
+            const std::vector<Wonder>& wonders = db.getWonders();
+
+            for (size_t i = 0; i < cards.size(); ++i) {
+                if (d.cardLoc[i] != (id == 0 ? CARD_BUILT_P0 : CARD_BUILT_P1)) continue;
+                p.constructCard(&cards[i]);
+                applyPassiveEffects(cards[i].getEffects(), &p);
+            }
+
+            size_t overlay = 0;
+            auto nextOverlay = [&]() -> const Card* {
+                for (; overlay < cards.size(); ++overlay) {
+                    if (d.cardLoc[overlay] == (id == 0 ? CARD_OVERLAY_P0 : CARD_OVERLAY_P1)) return &cards[overlay++];
+                }
+                return nullptr;
+            };
+            for (size_t i = 0; i < wonders.size(); ++i) {
+                if (d.wonderLoc[i] != (id == 0 ? WONDER_BUILT_P0 : WONDER_BUILT_P1)) continue;
+                p.addUnbuiltWonder(&wonders[i]);
+                p.constructWonder(wonders[i].getIndex(), nextOverlay());
+                applyPassiveEffects(wonders[i].getEffects(), &p);
+            }
+            for (size_t i = 0; i < wonders.size(); ++i) {
+                if (d.wonderLoc[i] == (id == 0 ? WONDER_UNBUILT_P0 : WONDER_UNBUILT_P1)) p.addUnbuiltWonder(&wonders[i]);
+            }
+
+            for (int t = 0; t < StatePacker::MAX_TOKENS; ++t) {
+                if (d.tokenLoc[t] == (id == 0 ? TOKEN_P0 : TOKEN_P1)) p.addProgressToken(static_cast<ProgressToken>(t));
+            }
+            for (int s = 0; s < PAIR_BITS; ++s) {
+                if ((d.claimedPairs[id] >> s) & 1u) p.addClaimedSciencePair(static_cast<ScienceSymbol>(s));
+            }
+
+            if (d.coins[id] > p.getCoins()) p.gainCoins(d.coins[id] - p.getCoins());
+            else if (d.coins[id] < p.getCoins()) p.payCoins(p.getCoins() - d.coins[id]);
+            return p;
+        }
+    }
+
+    std::uint64_t PackedState::hash() const {
+        std::uint64_t h = 0x9E3779B97F4A7C15ULL;
+        for (std::uint64_t w : words) {
+            h ^= w;
+            h *= 0xBF58476D1CE4E5B9ULL;
+            h ^= h >> 31;
+        }
+        return h;
+    }
+
+    int StatePacker::usedBits() {
+        return TOTAL_BITS;
+    }
+
+    // ==========================================================
+    //  编码
+    // ==========================================================
+
+    bool StatePacker::pack(const GameController& state, PackedState& out) {
+        const GameModel& model = *state.m_model;
+        const CardDatabase* db = model.getDatabase();
+        if (!db || static_cast<int>(db->getCards().size()) > MAX_CARDS ||
+            static_cast<int>(db->getWonders().size()) > MAX_WONDERS) return false;
+
+        const Board& board = *model.getBoard();
+        const CardPyramid& pyramid = board.getCardStructure();
+        const MilitaryTrack& track = board.getMilitaryTrack();
+        if (model.getCurrentAge() < 0 || model.getCurrentAge() > 3 || state.m_draftTurnCount < 0 ||
+            state.m_draftTurnCount >= (1 << DRAFT_TURN_BITS)) return false;
+
+        std::array<std::uint8_t, MAX_CARDS> cardLoc{};
+        std::array<std::uint8_t, MAX_WONDERS> wonderLoc{};
+        std::array<std::uint8_t, MAX_TOKENS> tokenLoc{};
+
+        for (const Card* c : board.getDiscardPile()) cardLoc[c->getIndex()] = CARD_DISCARD;
+        for (const Wonder* w : model.getRemainingWonders()) wonderLoc[w->getIndex()] = WONDER_DECK;
+        for (const Wonder* w : model.getDraftPool()) wonderLoc[w->getIndex()] = WONDER_DRAFT;
+        for (ProgressToken t : board.getAvailableProgressTokens()) tokenLoc[static_cast<int>(t)] = TOKEN_BOARD;
+        for (ProgressToken t : board.getBoxProgressTokens()) tokenLoc[static_cast<int>(t)] = TOKEN_BOX;
+
+        for (int id = 0; id < 2; ++id) {
+            const Player& p = *model.getPlayers()[id];
+            if (p.getCoins() < 0 || p.getCoins() > MAX_COINS) return false;
+            for (const Card* c : p.getAllCards()) cardLoc[c->getIndex()] = id == 0 ? CARD_BUILT_P0 : CARD_BUILT_P1;
+            for (int i = 0; i < p.getBuiltWonderCount(); ++i) {
+                if (const Card* c = p.getWonderOverlay(i)) cardLoc[c->getIndex()] = id == 0 ? CARD_OVERLAY_P0 : CARD_OVERLAY_P1;
+            }
+            for (const Wonder* w : p.getBuiltWonders()) wonderLoc[w->getIndex()] = id == 0 ? WONDER_BUILT_P0 : WONDER_BUILT_P1;
+            for (const Wonder* w : p.getUnbuiltWonders()) wonderLoc[w->getIndex()] = id == 0 ? WONDER_UNBUILT_P0 : WONDER_UNBUILT_P1;
+            for (int t = 0; t < MAX_TOKENS; ++t) {
+                if ((p.getProgressTokenMask() >> t) & 1u) tokenLoc[t] = id == 0 ? TOKEN_P0 : TOKEN_P1;
+            }
+        }
+
+        BitWriter w(out);
+        w.put(static_cast<std::uint64_t>(state.m_currentState), STATE_BITS);
+        w.put(model.getCurrentAge(), AGE_BITS);
+        w.put(model.getCurrentPlayerIndex(), PLAYER_BITS);
+        w.put(model.getWinnerIndex() + 1, WINNER_BITS);
+        w.put(static_cast<std::uint64_t>(model.getVictoryType()), VICTORY_BITS);
+        w.put(state.m_extraTurnPending ? 1 : 0, FLAG_BITS);
+        w.put(static_cast<std::uint64_t>(state.m_pendingDestructionType), CARD_TYPE_BITS);
+        w.put(state.m_draftTurnCount, DRAFT_TURN_BITS);
+
+        // 已拿走的卡槽统一写作空槽：其中的卡牌已在别处 (玩家 / 弃牌堆) 记录
+        w.put(pyramid.getSlotCount(), SLOT_COUNT_BITS);
+        w.put(pyramid.getRemovedMask(), Config::PYRAMID_SLOTS);
+        w.put(pyramid.getFaceUpMask(), Config::PYRAMID_SLOTS);
+        for (int i = 0; i < Config::PYRAMID_SLOTS; ++i) {
+            const Card* c = (i < pyramid.getSlotCount() && !pyramid.isRemoved(i)) ? pyramid.getSlot(i).getCardPtr() : nullptr;
+            w.put(c ? c->getIndex() : EMPTY_SLOT, SLOT_CARD_BITS);
+        }
+
+        for (std::uint8_t loc : cardLoc) w.put(loc, LOC_BITS);
+        for (std::uint8_t loc : wonderLoc) w.put(loc, LOC_BITS);
+        for (std::uint8_t loc : tokenLoc) w.put(loc, LOC_BITS);
+
+        for (int id = 0; id < 2; ++id) {
+            const Player& p = *model.getPlayers()[id];
+            w.put(p.getCoins(), COIN_BITS);
+            w.put(p.getClaimedSciencePairMask(), PAIR_BITS);
+        }
+        w.put(track.getPosition() + MILITARY_BIAS, MILITARY_BITS);
+        for (int i = 0; i < 4; ++i) w.put(track.getLootTokens()[i] ? 1 : 0, 1);
+        return true;
+    }
+
+    // ==========================================================
+    //  解码
+    // ==========================================================
+
+    bool StatePacker::unpack(const PackedState& packed, GameController& state) {
+        GameModel& model = *state.m_model;
+        const CardDatabase* db = model.getDatabase();
+        if (!db || model.getPlayers().size() != 2) return false;
+
+        Decoded d;
+        if (!decode(packed, *db, d)) return false;
+
+        const std::vector<Card>& cards = db->getCards();
+        const std::vector<Wonder>& wonders = db->getWonders();
+
+        // 玩家
+        for (int id = 0; id < 2; ++id) {
+            Player& p = *model.getPlayers()[id];
+            p = rebuildPlayer(d, id, p.getName(), *db);
+        }
+
+        // 棋盘
+        Board& board = *model.getBoardMut();
+        board = Board();
+        board.restoreMilitaryTrack(d.militaryPosition, d.loot);
+        std::array<const Card*, Config::PYRAMID_SLOTS> slots{};
+        for (int i = 0; i < d.slotCount; ++i) {
+            if (d.slotCards[i] != EMPTY_SLOT) slots[i] = &cards[d.slotCards[i]];
+        }
+        board.restorePyramid(d.age, slots, d.slotCount, d.removed, d.faceUp);
+        for (size_t i = 0; i < cards.size(); ++i) {
+            if (d.cardLoc[i] == CARD_DISCARD) board.addToDiscardPile(&cards[i]);
+        }
+        for (int t = 0; t < MAX_TOKENS; ++t) {
+            if (d.tokenLoc[t] == TOKEN_BOARD) board.addAvailableProgressToken(static_cast<ProgressToken>(t));
+            else if (d.tokenLoc[t] == TOKEN_BOX) board.addBoxProgressToken(static_cast<ProgressToken>(t));
+        }
+        for (int id = 0; id < 2; ++id) {
+            model.getPlayers()[id]->setMilitaryVictoryPoints(board.getMilitaryTrack().getVictoryPoints(id));
+        }
+
+        // 模型
+        model.setCurrentAge(d.age);
+        model.setCurrentPlayerIndex(d.currentPlayer);
+        model.setWinnerIndex(d.winner);
+        model.setVictoryType(d.victory);
+        model.clearDraftPool();
+        model.clearRemainingWonders();
+        for (size_t i = 0; i < wonders.size(); ++i) {
+            if (d.wonderLoc[i] == WONDER_DRAFT) model.addToDraftPool(&wonders[i]);
+            else if (d.wonderLoc[i] == WONDER_DECK) model.addToRemainingWonders(&wonders[i]);
+        }
+
+        // 控制器
+        state.setState(d.state);
+        state.m_extraTurnPending = d.extraTurn;
+        state.m_pendingDestructionType = d.pendingDestruction;
+        state.m_draftTurnCount = d.draftTurnCount;
+        state.clearUndoHistory();
+        return true;
+    }
+
+
+    // ==========================================================
+    //  随机流与奇迹顺序
+    // ==========================================================
+
+    bool StatePacker::captureDeal(const GameController& state, DealState& out) {
+        const GameModel& model = *state.m_model;
+        const auto& remaining = model.getRemainingWonders();
+        const auto& pool = model.getDraftPool();
+        if (remaining.size() > out.remainingWonders.size() || pool.size() > out.draftPool.size()) return false;
+
+        out.gameSeed = state.m_gameSeed;
+        out.deckRng = state.m_deckRng;
+        out.tokenRng = state.m_tokenRng;
+        out.remainingCount = static_cast<std::uint8_t>(remaining.size());
+        for (size_t i = 0; i < remaining.size(); ++i) out.remainingWonders[i] = remaining[i]->getIndex();
+        out.draftCount = static_cast<std::uint8_t>(pool.size());
+        for (size_t i = 0; i < pool.size(); ++i) out.draftPool[i] = pool[i]->getIndex();
+        return true;
+    }
+
+    bool StatePacker::restoreDeal(const DealState& deal, GameController& state) {
+        GameModel& model = *state.m_model;
+
+        // 只改变顺序：两组奇迹须与当前模型中的集合一致
+        auto sameSet = [](const std::vector<const Wonder*>& current, const WonderIndex* order, int count) {
+            if (static_cast<int>(current.size()) != count) return false;
+            std::uint32_t have = 0, want = 0;
+            for (const Wonder* w : current) have |= 1u << w->getIndex();
+            for (int i = 0; i < count; ++i) {
+                if (order[i] >= MAX_WONDERS || (want & (1u << order[i]))) return false;
+                want |= 1u << order[i];
+            }
+            return have == want;
+        };
+        if (!sameSet(model.getRemainingWonders(), deal.remainingWonders.data(), deal.remainingCount) ||
+            !sameSet(model.getDraftPool(), deal.draftPool.data(), deal.draftCount)) {
+            return false;
+        }
+
+        model.clearRemainingWonders();
+        for (int i = 0; i < deal.remainingCount; ++i) model.addToRemainingWonders(model.getWonder(deal.remainingWonders[i]));
+        model.clearDraftPool();
+        for (int i = 0; i < deal.draftCount; ++i) model.addToDraftPool(model.getWonder(deal.draftPool[i]));
+
+        state.m_gameSeed = deal.gameSeed;
+        state.m_deckRng = deal.deckRng;
+        state.m_tokenRng = deal.tokenRng;
+        return true;
+    }
+
+}
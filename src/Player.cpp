@@ -1,98 +1,162 @@
 #include "Player.h"
 #include <limits>
-#include <numeric>
 #include <vector>
 #include <algorithm>
-#include <map>
+#include <array>
+#include <cstdint>
+#include <type_traits>
 
 namespace SevenWondersDuel {
 
+    static_assert(std::is_trivially_copyable<Player>::value, "Player must stay trivially copyable");
+
     // 构造函数
-    Player::Player(int pid, std::string pname) : m_id(pid), m_name(pname), m_coins(Config::INITIAL_COINS) {
-        // 初始化资源 map
-        m_fixedResources[ResourceType::WOOD] = 0;
-        m_fixedResources[ResourceType::STONE] = 0;
-        m_fixedResources[ResourceType::CLAY] = 0;
-        m_fixedResources[ResourceType::PAPER] = 0;
-        m_fixedResources[ResourceType::GLASS] = 0;
-
-        // 初始化公开产量
-        m_publicProduction[ResourceType::WOOD] = 0;
-        m_publicProduction[ResourceType::STONE] = 0;
-        m_publicProduction[ResourceType::CLAY] = 0;
-        m_publicProduction[ResourceType::PAPER] = 0;
-        m_publicProduction[ResourceType::GLASS] = 0;
-
-        // 交易优惠初始化
-        m_tradingDiscounts[ResourceType::WOOD] = false;
-        m_tradingDiscounts[ResourceType::STONE] = false;
-        m_tradingDiscounts[ResourceType::CLAY] = false;
-        m_tradingDiscounts[ResourceType::PAPER] = false;
-        m_tradingDiscounts[ResourceType::GLASS] = false;
+    Player::Player(int pid, const std::string& pname, const CardDatabase* database)
+        : m_database(database), m_id(pid), m_coins(Config::INITIAL_COINS) {
+        // 超长名称按 UTF-8 字符边界截断
+        size_t len = std::min(pname.size(), m_name.size() - 1);
+        while (len > 0 && len < pname.size() && (static_cast<unsigned char>(pname[len]) & 0xC0) == 0x80) --len;
+        std::copy(pname.begin(), pname.begin() + len, m_name.begin());
+        m_name[len] = '\0';
+        updateCoinScore();
+        m_hash = Zobrist::coins(m_id, m_coins);
     }
 
     // --- 核心状态查询 ---
 
-    int Player::getCardCount(CardType type) const {
-        int count = 0;
-        for (auto c : getCardsByType(type)) { count++; }
-        return count;
-    }
-
-    // --- 辅助：递归求解最小交易成本 ---
-    void solveMinCost(std::map<ResourceType, int> needed,
-                      size_t choiceIdx,
-                      const std::vector<std::vector<ResourceType>>& choices,
-                      const Player& opponent,
-                      const Player& parent,
-                      int& minCost)
-    {
-        // 基准情况：所有多选一资源都分配完毕
-        if (choiceIdx == choices.size()) {
-            int currentTradingCost = 0;
-            for (auto const& [type, count] : needed) {
-                if (count > 0) {
-                    int unitPrice = parent.getTradingPrice(type, opponent);
-                    currentTradingCost += count * unitPrice;
-                }
-            }
-            if (currentTradingCost < minCost) {
-                minCost = currentTradingCost;
+    int Player::getDistinctScienceSymbolCount() const {
+        int distinct = 0;
+        for (int s = 1; s < SCIENCE_KINDS; ++s) if (m_scienceSymbols[s] > 0) distinct++;
+        return distinct;
+    }
+
+    // --- 增量计分 ---
+
+    namespace {
+        // 卡牌静态分数所属的分项
+        int& scoreBucket(ScoreBreakdown& score, CardType type) {
+            switch (type) {
+                case CardType::SCIENTIFIC: return score.science;
+                case CardType::COMMERCIAL: return score.commercial;
+                case CardType::GUILD:      return score.guild;
+                default:                   return score.civilian;
             }
-            return;
         }
+    }
 
-        // 递归步骤：尝试当前多选一资源的每种可能性
-        const auto& options = choices[choiceIdx];
-        bool usefulOptionFound = false;
-
-        for (ResourceType res : options) {
-            // 如果这个资源是我需要的，这是一种有意义的分支
-            if (needed[res] > 0) {
-                usefulOptionFound = true;
-                std::map<ResourceType, int> nextNeeded = needed;
-                nextNeeded[res]--;
-                solveMinCost(nextNeeded, choiceIdx + 1, choices, opponent, parent, minCost);
-            }
+    ScoreBreakdown Player::getScoreBreakdown(const Player& opponent) const {
+        ScoreBreakdown score = m_score;
+        if (m_cardTypeCounts[static_cast<int>(CardType::GUILD)] > 0) score.guild += guildDynamicScore(opponent);
+        return score;
+    }
+
+    int Player::guildDynamicScore(const Player& opponent) const {
+        // 公会策略只读取颜色计数、奇迹数与金币 (max(coins)/3 等价于 max(coins/3))
+        GuildScoreKey key{};
+        int k = 0;
+        for (const Player* p : {this, &opponent}) {
+            for (int t = 0; t < CARD_TYPE_KINDS; ++t) key[k++] = p->m_cardTypeCounts[t];
+            key[k++] = p->m_builtWonderCount;
+            key[k++] = static_cast<std::uint8_t>(std::min(p->m_coins / Config::COINS_PER_VP, 255));
         }
+        if (m_guildScoreValid && key == m_guildScoreKey) return m_guildScoreCache;
 
-        // 如果提供的选项都没用，那就都不选，直接看下一个
-        if (!usefulOptionFound) {
-            solveMinCost(needed, choiceIdx + 1, choices, opponent, parent, minCost);
+        int total = 0;
+        for (const Card* card : getCardsByType(CardType::GUILD)) {
+            total += card->getVictoryPoints(this, &opponent) - card->getStaticVictoryPoints();
+        }
+        m_guildScoreKey = key;
+        m_guildScoreCache = total;
+        m_guildScoreValid = true;
+        return total;
+    }
+
+    void Player::updateTokenScore() {
+        int points = 0;
+        if (hasProgressToken(ProgressToken::AGRICULTURE)) points += Config::AGRICULTURE_VP;
+        if (hasProgressToken(ProgressToken::MATHEMATICS)) points += Config::MATHEMATICS_VP_PER_TOKEN * getProgressTokenCount();
+        if (hasProgressToken(ProgressToken::PHILOSOPHY)) points += Config::PHILOSOPHY_VP;
+        m_score.tokens = points;
+    }
+
+    // --- 辅助：多选一资源分配的最小交易成本 ---
+
+    namespace {
+        constexpr int RESOURCE_KINDS = 5;
+        constexpr int MAX_CHOICE_PRODUCERS = Config::MAX_CHOICE_PRODUCERS; // 实际对局中不超过 4 (两张黄卡 + 两座奇迹)
+
+        using Deficit = std::array<std::uint8_t, RESOURCE_KINDS>;
+
+        // 仍有缺口的资源位掩码
+        inline std::uint8_t positiveMask(const Deficit& d) {
+            std::uint8_t m = 0;
+            for (int t = 0; t < RESOURCE_KINDS; ++t) if (d[t] > 0) m |= (1u << t);
+            return m;
+        }
+
+        inline int tradingCost(const Deficit& d, const std::array<int, RESOURCE_KINDS>& price) {
+            int total = 0;
+            for (int t = 0; t < RESOURCE_KINDS; ++t) total += d[t] * price[t];
+            return total;
+        }
+
+        /**
+         * @brief 枚举多选一资源的分配，返回剩余缺口的最小交易费
+         * 迭代式深度优先：第 i 个多选一资源只分支到"当前仍有缺口"的选项 (位掩码)，
+         * 全部选项都无用时跳过。整个过程只使用栈上的定长数组，不分配内存。
+         * @param choiceMasks 每个多选一资源可提供的资源位掩码
+         */
+        int solveMinCost(const Deficit& initial, const std::uint8_t* choiceMasks, int n,
+                         const std::array<int, RESOURCE_KINDS>& price) {
+            Deficit deficit[MAX_CHOICE_PRODUCERS + 1];
+            std::uint8_t open[MAX_CHOICE_PRODUCERS];  // 该层尚未尝试的有用选项
+            bool skip[MAX_CHOICE_PRODUCERS];          // 该层是否尚待走"不选"分支
+
+            int best = std::numeric_limits<int>::max();
+            deficit[0] = initial;
+            if (n > 0) {
+                open[0] = choiceMasks[0] & positiveMask(deficit[0]);
+                skip[0] = (open[0] == 0);
+            }
+
+            int depth = 0;
+            while (depth >= 0) {
+                if (depth == n) {
+                    best = std::min(best, tradingCost(deficit[n], price));
+                    --depth;
+                    continue;
+                }
+
+                if (open[depth]) {
+                    int r = 0;
+                    while (!(open[depth] & (1u << r))) ++r;
+                    open[depth] &= static_cast<std::uint8_t>(open[depth] - 1);
+                    deficit[depth + 1] = deficit[depth];
+                    deficit[depth + 1][r]--;
+                } else if (skip[depth]) {
+                    skip[depth] = false;
+                    deficit[depth + 1] = deficit[depth];
+                } else {
+                    --depth;
+                    continue;
+                }
+
+                ++depth;
+                if (depth < n) {
+                    open[depth] = choiceMasks[depth] & positiveMask(deficit[depth]);
+                    skip[depth] = (open[depth] == 0);
+                }
+            }
+            return best;
         }
     }
 
     int Player::getTradingPrice(ResourceType type, const Player& opponent) const {
         // 如果有特定资源的优惠卡 (如 Stone Reserve)，价格固定为 1
-        if (m_tradingDiscounts.count(type) && m_tradingDiscounts.at(type)) return 1;
+        if (hasTradingDiscount(type)) return 1;
 
         // 否则：2 + 对手该类资源产量的"公开值" (棕/灰卡)
-        // Accessing private member of another instance of same class is allowed in C++
-        int opponentProduction = 0;
-        if (opponent.m_publicProduction.count(type)) {
-            opponentProduction = opponent.m_publicProduction.at(type);
-        }
-        return Config::TRADING_BASE_COST + opponentProduction;
+        return Config::TRADING_BASE_COST + opponent.getPublicProduction(type);
     }
 
     std::pair<bool, int> Player::calculateCost(const ResourceCost& cost, const Player& opponent, CardType targetType) const {
@@ -102,74 +166,49 @@ namespace SevenWondersDuel {
             return { true, cost.getCoins() };
         }
 
-        // 2. 准备计算资源缺口
-        std::map<ResourceType, int> deficit = cost.getResources();
-
-        // 3. 扣除固定产出
-        for (auto it = deficit.begin(); it != deficit.end(); ) {
-            ResourceType type = it->first;
-            int needed = it->second;
-
-            auto myResIt = m_fixedResources.find(type);
-            int owned = (myResIt != m_fixedResources.end()) ? myResIt->second : 0;
-
-            if (owned >= needed) {
-                it = deficit.erase(it);
-            } else {
-                it->second -= owned;
-                ++it;
-            }
+        // 2. 计算资源缺口并扣除固定产出 (定长数组，按 ResourceType 索引)
+        Deficit deficit{};
+        for (auto const& [type, needed] : cost.getResources()) {
+            int owned = m_fixedResources[static_cast<int>(type)];
+            if (needed > owned) deficit[static_cast<int>(type)] = static_cast<std::uint8_t>(needed - owned);
         }
 
-        // --- [NEW] 科技标记减费逻辑 ---
+        std::array<int, RESOURCE_KINDS> price{};
+        for (int t = 0; t < RESOURCE_KINDS; ++t) price[t] = getTradingPrice(static_cast<ResourceType>(t), opponent);
+
+        // --- 科技标记减费逻辑 ---
         int discountCount = 0;
-        if (m_progressTokens.count(ProgressToken::MASONRY) && targetType == CardType::CIVILIAN) {
+        if (hasProgressToken(ProgressToken::MASONRY) && targetType == CardType::CIVILIAN) {
             discountCount = Config::MASONRY_DISCOUNT;
-        } else if (m_progressTokens.count(ProgressToken::ARCHITECTURE) && targetType == CardType::WONDER) {
+        } else if (hasProgressToken(ProgressToken::ARCHITECTURE) && targetType == CardType::WONDER) {
             discountCount = Config::ARCHITECTURE_DISCOUNT;
         }
 
-        // 智能减免：优先减免那些"如果不减免就很贵"的资源
-        while (discountCount > 0 && !deficit.empty()) {
-            // 寻找当前缺口中，交易单价最高的资源
-            ResourceType bestToDiscount = ResourceType::WOOD;
+        // 智能减免：优先减免那些"如果不减免就很贵"的资源 (同价时取枚举序靠前者)
+        while (discountCount > 0) {
+            int bestToDiscount = -1;
             int maxPrice = -1;
-            bool found = false;
-
-            for (auto const& [type, count] : deficit) {
-                if (count > 0) {
-                    int price = getTradingPrice(type, opponent);
-                    if (price > maxPrice) {
-                        maxPrice = price;
-                        bestToDiscount = type;
-                        found = true;
-                    }
-                }
-            }
-
-            if (found) {
-                deficit[bestToDiscount]--;
-                if (deficit[bestToDiscount] <= 0) {
-                    deficit.erase(bestToDiscount);
+            for (int t = 0; t < RESOURCE_KINDS; ++t) {
+                if (deficit[t] > 0 && price[t] > maxPrice) {
+                    maxPrice = price[t];
+                    bestToDiscount = t;
                 }
-                discountCount--;
-            } else {
-                break; // 没东西可减了
             }
+            if (bestToDiscount < 0) break; // 没东西可减了
+            deficit[bestToDiscount]--;
+            discountCount--;
         }
 
         // 如果扣除固定产出和科技减免后没缺口了，且金币够
-        if (deficit.empty()) {
+        if (positiveMask(deficit) == 0) {
             if (m_coins < cost.getCoins()) return { false, cost.getCoins() };
             return { true, cost.getCoins() };
         }
 
-        // 4. 利用多选一资源填补剩余缺口 (寻找最小交易费)
-        int minTradingCost = std::numeric_limits<int>::max();
+        // 3. 利用多选一资源填补剩余缺口 (寻找最小交易费)
+        int minTradingCost = solveMinCost(deficit, m_choiceResources.data(), m_choiceCount, price);
 
-        solveMinCost(deficit, 0, m_choiceResources, opponent, *this, minTradingCost);
-
-        // 5. 汇总结果
+        // 4. 汇总结果
         int totalRequired = cost.getCoins() + minTradingCost;
         bool canAfford = (m_coins >= totalRequired);
 
@@ -179,106 +218,215 @@ namespace SevenWondersDuel {
     // --- 动作执行 (Mutators) ---
 
     void Player::payCoins(int amount) {
+        m_hash ^= Zobrist::coins(m_id, m_coins);
         m_coins = std::max(0, m_coins - amount);
+        m_hash ^= Zobrist::coins(m_id, m_coins);
+        updateCoinScore();
     }
 
     void Player::gainCoins(int amount) {
+        m_hash ^= Zobrist::coins(m_id, m_coins);
         m_coins += amount;
+        m_hash ^= Zobrist::coins(m_id, m_coins);
+        updateCoinScore();
+    }
+
+    void Player::setCoins(int coins) {
+        m_hash ^= Zobrist::coins(m_id, m_coins);
+        m_coins = std::max(0, coins);
+        m_hash ^= Zobrist::coins(m_id, m_coins);
+        updateCoinScore();
     }
 
     void Player::setTradingDiscount(ResourceType r, bool active) {
-        m_tradingDiscounts[r] = active;
+        std::uint8_t bit = static_cast<std::uint8_t>(1u << static_cast<int>(r));
+        if (active) m_tradingDiscounts |= bit;
+        else m_tradingDiscounts &= static_cast<std::uint8_t>(~bit);
     }
 
     void Player::addClaimedSciencePair(ScienceSymbol s) {
-        m_claimedSciencePairs.insert(s);
+        m_claimedSciencePairs |= static_cast<std::uint8_t>(1u << static_cast<int>(s));
     }
 
     void Player::addResource(ResourceType type, int count, bool isTradable) {
-        m_fixedResources[type] += count;
+        m_fixedResources[static_cast<int>(type)] += count;
+        if (isTradable) {
+            m_publicProduction[static_cast<int>(type)] += count;
+        }
+    }
+
+    void Player::removeResource(ResourceType type, int count, bool isTradable) {
+        auto& fixed = m_fixedResources[static_cast<int>(type)];
+        fixed = static_cast<std::uint8_t>(std::max(0, fixed - count));
         if (isTradable) {
-            m_publicProduction[type] += count;
+            auto& pub = m_publicProduction[static_cast<int>(type)];
+            pub = static_cast<std::uint8_t>(std::max(0, pub - count));
         }
     }
 
     void Player::addProductionChoice(const std::vector<ResourceType>& choices) {
-        m_choiceResources.push_back(choices);
+        std::uint8_t mask = 0;
+        for (ResourceType r : choices) mask |= static_cast<std::uint8_t>(1u << static_cast<int>(r));
+        addProductionChoice(mask);
+    }
+
+    void Player::addProductionChoice(std::uint8_t mask) {
+        if (m_choiceCount == Config::MAX_CHOICE_PRODUCERS) return;
+        m_choiceResources[m_choiceCount++] = mask;
+    }
+
+    void Player::removeProductionChoice(std::uint8_t mask) {
+        auto first = m_choiceResources.begin();
+        auto it = std::find(first, first + m_choiceCount, mask);
+        if (it == first + m_choiceCount) return;
+        std::copy(it + 1, first + m_choiceCount, it);
+        m_choiceCount--;
     }
 
     void Player::addScienceSymbol(ScienceSymbol s) {
         if (s != ScienceSymbol::NONE) {
-            m_scienceSymbols[s]++;
+            m_scienceSymbols[static_cast<int>(s)]++;
         }
     }
 
-    void Player::addChainTag(const std::string& tag) {
-        if (!tag.empty()) m_ownedChainTags.insert(tag);
+    void Player::removeScienceSymbol(ScienceSymbol s) {
+        auto& count = m_scienceSymbols[static_cast<int>(s)];
+        if (s != ScienceSymbol::NONE && count > 0) count--;
     }
 
     void Player::addProgressToken(ProgressToken token) {
-        m_progressTokens.insert(token);
+        if (!hasProgressToken(token)) m_hash ^= Zobrist::playerToken(m_id, token);
+        m_progressTokens |= static_cast<std::uint16_t>(1u << static_cast<int>(token));
         // 立即生效的 buff 处理 (如 LAW)
         if (token == ProgressToken::LAW) addScienceSymbol(ScienceSymbol::LAW);
+        updateTokenScore();
     }
 
-    void Player::constructCard(Card* card) {
-        m_builtCards.push_back(card);
-        addChainTag(card->getChainTag());
+    void Player::removeProgressToken(ProgressToken token) {
+        if (!hasProgressToken(token)) return;
+        m_hash ^= Zobrist::playerToken(m_id, token);
+        m_progressTokens &= static_cast<std::uint16_t>(~(1u << static_cast<int>(token)));
+        if (token == ProgressToken::LAW) removeScienceSymbol(ScienceSymbol::LAW);
+        updateTokenScore();
     }
 
-    Card* Player::removeCardByType(CardType type) {
-        auto it = std::find_if(m_builtCards.rbegin(), m_builtCards.rend(),
-            [type](Card* c){ return c->getType() == type; });
+    void Player::insertCard(const Card* card, int position) {
+        if (m_builtCardCount == Config::MAX_BUILT_CARDS) return;
+        auto first = m_builtCards.begin();
+        position = std::clamp(position, 0, static_cast<int>(m_builtCardCount));
+        std::copy_backward(first + position, first + m_builtCardCount, first + m_builtCardCount + 1);
+        m_builtCards[position] = card->getIndex();
+        m_builtCardCount++;
+        m_cardTypeCounts[static_cast<int>(card->getType())]++;
+        m_ownedChainTags |= card->getChainBit();
+        m_hash ^= Zobrist::builtCard(m_id, card->getIndex());
+        scoreBucket(m_score, card->getType()) += card->getStaticVictoryPoints();
+    }
 
-        if (it != m_builtCards.rend()) {
-            Card* c = *it;
-            
-            auto fwdIt = (it + 1).base();
-            m_builtCards.erase(fwdIt);
-            return c;
-        }
-        return nullptr;
+    const Card* Player::removeCard(CardIndex card) {
+        auto first = m_builtCards.begin();
+        auto it = std::find(first, first + m_builtCardCount, card);
+        if (it == first + m_builtCardCount) return nullptr;
+
+        // 其余卡牌保持建造顺序
+        const Card* c = m_database->getCard(card);
+        std::copy(it + 1, first + m_builtCardCount, it);
+        m_builtCardCount--;
+        m_cardTypeCounts[static_cast<int>(c->getType())]--;
+        scoreBucket(m_score, c->getType()) -= c->getStaticVictoryPoints();
+        m_hash ^= Zobrist::builtCard(m_id, card);
+        // 缓存键只含颜色计数：撤销一张公会后再建另一张，键不变但公会组合已不同
+        if (c->getType() == CardType::GUILD) m_guildScoreValid = false;
+
+        // 连锁标记可能由多张卡提供，按剩余卡牌重新汇总
+        m_ownedChainTags = 0;
+        for (int i = 0; i < m_builtCardCount; ++i) m_ownedChainTags |= builtCardAt(i)->getChainBit();
+        return c;
     }
 
-    void Player::addUnbuiltWonder(Wonder* w) {
-        m_unbuiltWonders.push_back(w);
+    int Player::findBuiltCard(CardIndex card) const {
+        auto first = m_builtCards.begin();
+        auto it = std::find(first, first + m_builtCardCount, card);
+        return it == first + m_builtCardCount ? -1 : static_cast<int>(it - first);
     }
 
-    void Player::removeUnbuiltWonder(const std::string& wonderId) {
-        auto it = std::remove_if(m_unbuiltWonders.begin(), m_unbuiltWonders.end(),
-            [&](Wonder* w){ return w->getId() == wonderId; });
-        if (it != m_unbuiltWonders.end()) {
-            m_unbuiltWonders.erase(it, m_unbuiltWonders.end());
-        }
+    void Player::addUnbuiltWonder(const Wonder* w) {
+        if (m_unbuiltWonderCount == Config::MAX_WONDERS_PER_PLAYER) return;
+        m_unbuiltWonders[m_unbuiltWonderCount++] = w->getIndex();
+        m_hash ^= Zobrist::unbuiltWonder(m_id, w->getIndex());
     }
 
-    void Player::clearUnbuiltWonders() {
-        m_unbuiltWonders.clear();
+    void Player::removeUnbuiltWonder(WonderIndex wonder) {
+        auto first = m_unbuiltWonders.begin();
+        auto last = std::remove(first, first + m_unbuiltWonderCount, wonder);
+        if (last != first + m_unbuiltWonderCount) m_hash ^= Zobrist::unbuiltWonder(m_id, wonder);
+        m_unbuiltWonderCount = static_cast<std::uint8_t>(last - first);
     }
 
-    void Player::constructWonder(std::string wonderId, Card* overlayCard) {
-        auto it = std::find_if(m_unbuiltWonders.begin(), m_unbuiltWonders.end(),
-            [&](Wonder* w){ return w->getId() == wonderId; });
+    void Player::clearUnbuiltWonders() {
+        for (int i = 0; i < m_unbuiltWonderCount; ++i) m_hash ^= Zobrist::unbuiltWonder(m_id, m_unbuiltWonders[i]);
+        m_unbuiltWonderCount = 0;
+    }
 
-        if (it != m_unbuiltWonders.end()) {
-            Wonder* w = *it;
-            w->build(overlayCard);
-            m_builtWonders.push_back(w);
-            m_unbuiltWonders.erase(it);
+    void Player::constructWonder(WonderIndex wonder, const Card* overlayCard) {
+        auto first = m_unbuiltWonders.begin();
+        auto it = std::find(first, first + m_unbuiltWonderCount, wonder);
+
+        if (it != first + m_unbuiltWonderCount && m_builtWonderCount < Config::MAX_WONDERS_PER_PLAYER) {
+            m_builtWonders[m_builtWonderCount] = wonder;
+            m_wonderOverlays[m_builtWonderCount] = overlayCard ? overlayCard->getIndex() : NO_CARD;
+            m_builtWonderCount++;
+            m_score.wonder += m_database->getWonder(wonder)->getStaticVictoryPoints();
+            m_hash ^= Zobrist::unbuiltWonder(m_id, wonder) ^ Zobrist::builtWonder(m_id, wonder);
+            if (overlayCard) m_hash ^= Zobrist::wonderOverlay(m_id, overlayCard->getIndex());
+            std::copy(it + 1, first + m_unbuiltWonderCount, it);
+            m_unbuiltWonderCount--;
         }
     }
 
+    void Player::unconstructWonder(WonderIndex wonder, int position) {
+        auto built = m_builtWonders.begin();
+        auto it = std::find(built, built + m_builtWonderCount, wonder);
+        if (it == built + m_builtWonderCount || m_unbuiltWonderCount == Config::MAX_WONDERS_PER_PLAYER) return;
+
+        int i = static_cast<int>(it - built);
+        CardIndex overlay = m_wonderOverlays[i];
+        std::copy(it + 1, built + m_builtWonderCount, it);
+        std::copy(m_wonderOverlays.begin() + i + 1, m_wonderOverlays.begin() + m_builtWonderCount, m_wonderOverlays.begin() + i);
+        m_builtWonderCount--;
+        m_score.wonder -= m_database->getWonder(wonder)->getStaticVictoryPoints();
+        m_hash ^= Zobrist::builtWonder(m_id, wonder) ^ Zobrist::unbuiltWonder(m_id, wonder);
+        if (overlay != NO_CARD) m_hash ^= Zobrist::wonderOverlay(m_id, overlay);
+
+        auto unbuilt = m_unbuiltWonders.begin();
+        position = std::clamp(position, 0, static_cast<int>(m_unbuiltWonderCount));
+        std::copy_backward(unbuilt + position, unbuilt + m_unbuiltWonderCount, unbuilt + m_unbuiltWonderCount + 1);
+        m_unbuiltWonders[position] = wonder;
+        m_unbuiltWonderCount++;
+    }
+
+    int Player::findUnbuiltWonder(WonderIndex wonder) const {
+        auto first = m_unbuiltWonders.begin();
+        auto it = std::find(first, first + m_unbuiltWonderCount, wonder);
+        return it == first + m_unbuiltWonderCount ? -1 : static_cast<int>(it - first);
+    }
+
+    bool Player::hasBuiltWonder(const Wonder* w) const {
+        auto first = m_builtWonders.begin();
+        return std::find(first, first + m_builtWonderCount, w->getIndex()) != first + m_builtWonderCount;
+    }
+
     Player::CardRange Player::getCardsByType(CardType type) const {
         return {
-            BuiltCardIterator(&m_builtCards, 0, type),
-            BuiltCardIterator(&m_builtCards, (int)m_builtCards.size(), type)
+            BuiltCardIterator(this, 0, type),
+            BuiltCardIterator(this, m_builtCardCount, type)
         };
     }
 
     Player::CardRange Player::getAllCards() const {
         return {
-            BuiltCardIterator(&m_builtCards, 0, std::nullopt),
-            BuiltCardIterator(&m_builtCards, (int)m_builtCards.size(), std::nullopt)
+            BuiltCardIterator(this, 0, std::nullopt),
+            BuiltCardIterator(this, m_builtCardCount, std::nullopt)
         };
     }
 
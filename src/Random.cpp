@@ -0,0 +1,62 @@
+#include "Random.h"
+
+namespace SevenWondersDuel {
+
+    std::uint64_t splitMix64(std::uint64_t& state) {
+        std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // ==========================================================
+    //  Xoshiro256
+    // ==========================================================
+
+    Xoshiro256::Xoshiro256(std::uint64_t seed) {
+        std::uint64_t sm = seed;
+        for (auto& s : m_s) s = splitMix64(sm);
+    }
+
+    void Xoshiro256::jump() {
+        static constexpr std::uint64_t JUMP[] = {
+            0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL,
+            0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL
+        };
+
+        std::uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+        for (std::uint64_t word : JUMP) {
+            for (int b = 0; b < 64; ++b) {
+                if (word & (std::uint64_t{1} << b)) {
+                    s0 ^= m_s[0];
+                    s1 ^= m_s[1];
+                    s2 ^= m_s[2];
+                    s3 ^= m_s[3];
+                }
+                (*this)();
+            }
+        }
+        m_s[0] = s0;
+        m_s[1] = s1;
+        m_s[2] = s2;
+        m_s[3] = s3;
+    }
+
+    // ==========================================================
+    //  SeedHierarchy
+    // ==========================================================
+
+    std::uint64_t SeedHierarchy::gameSeed(std::uint64_t masterSeed, std::uint64_t gameIndex) {
+        std::uint64_t state = masterSeed;
+        std::uint64_t a = splitMix64(state);
+        state = a ^ gameIndex;
+        return splitMix64(state);
+    }
+
+    Xoshiro256 SeedHierarchy::stream(std::uint64_t gameSeed, RngStream which) {
+        Xoshiro256 rng(gameSeed);
+        for (int i = 0; i < static_cast<int>(which); ++i) rng.jump();
+        return rng;
+    }
+
+}
@@ -0,0 +1,395 @@
+#include "Replay.h"
+#include "ReplayCorpus.h"
+#include "CardDatabase.h"
+#include "Random.h"
+#include <algorithm>
+#include <istream>
+#include <ostream>
+
+namespace SevenWondersDuel {
+
+    namespace {
+        constexpr int TYPE_SHIFT = 12;
+        constexpr int WONDER_SHIFT = 7;
+        constexpr int FLAG_SHIFT = 11;
+        constexpr ActionCode CARD_FIELD = 0x7F;      // 同时作为 NO_CARD 的编码
+        constexpr ActionCode WONDER_FIELD = 0x0F;    // 同时作为 NO_WONDER 的编码
+
+        constexpr size_t RECORD_FIXED_BYTES = 4 + 8 + 8 + 1;
+
+        void putU16(std::vector<std::uint8_t>& out, std::uint16_t v) {
+            out.push_back(static_cast<std::uint8_t>(v));
+            out.push_back(static_cast<std::uint8_t>(v >> 8));
+        }
+
+        void putU32(std::vector<std::uint8_t>& out, std::uint32_t v) {
+            for (int i = 0; i < 4; ++i) out.push_back(static_cast<std::uint8_t>(v >> (8 * i)));
+        }
+
+        void putU64(std::vector<std::uint8_t>& out, std::uint64_t v) {
+            for (int i = 0; i < 8; ++i) out.push_back(static_cast<std::uint8_t>(v >> (8 * i)));
+        }
+
+        std::uint16_t getU16(const std::uint8_t* p) {
+            return static_cast<std::uint16_t>(p[0] | (p[1] << 8));
+        }
+
+        std::uint32_t getU32(const std::uint8_t* p) {
+            std::uint32_t v = 0;
+            for (int i = 3; i >= 0; --i) v = (v << 8) | p[i];
+            return v;
+        }
+
+        std::uint64_t getU64(const std::uint8_t* p) {
+            std::uint64_t v = 0;
+            for (int i = 7; i >= 0; --i) v = (v << 8) | p[i];
+            return v;
+        }
+
+        void putName(std::vector<std::uint8_t>& out, const std::string& name) {
+            size_t len = std::min(name.size(), ReplayFormat::MAX_AGENT_NAME);
+            out.push_back(static_cast<std::uint8_t>(len));
+            out.insert(out.end(), name.begin(), name.begin() + len);
+        }
+
+        bool getName(const std::uint8_t*& p, const std::uint8_t* end, std::string_view& out) {
+            if (p >= end) return false;
+            size_t len = *p++;
+            if (static_cast<size_t>(end - p) < len) return false;
+            out = std::string_view(reinterpret_cast<const char*>(p), len);
+            p += len;
+            return true;
+        }
+    }
+
+    // ==========================================================
+    //  ActionCodec
+    // ==========================================================
+
+    bool ActionCodec::encode(const Action& action, ActionCode& out) {
+        ActionCode card = action.targetCard == NO_CARD ? CARD_FIELD : action.targetCard;
+        ActionCode wonder = action.targetWonder == NO_WONDER ? WONDER_FIELD : action.targetWonder;
+        if (action.targetCard != NO_CARD && action.targetCard >= CARD_FIELD) return false;
+        if (action.targetWonder != NO_WONDER && action.targetWonder >= WONDER_FIELD) return false;
+
+        ActionCode payload = 0;
+        switch (action.type) {
+            case ActionType::DRAFT_WONDER:
+                payload = static_cast<ActionCode>(wonder << WONDER_SHIFT);
+                break;
+            case ActionType::BUILD_CARD:
+            case ActionType::DISCARD_FOR_COINS:
+            case ActionType::SELECT_DESTRUCTION:
+            case ActionType::SELECT_FROM_DISCARD:
+                payload = card;
+                break;
+            case ActionType::BUILD_WONDER:
+                payload = static_cast<ActionCode>(card | (wonder << WONDER_SHIFT));
+                break;
+            case ActionType::SELECT_PROGRESS_TOKEN:
+                payload = static_cast<ActionCode>(action.selectedToken);
+                break;
+            case ActionType::CHOOSE_STARTING_PLAYER:
+                payload = static_cast<ActionCode>((action.chooseSelf ? 1 : 0) << FLAG_SHIFT);
+                break;
+        }
+        out = static_cast<ActionCode>((static_cast<int>(action.type) << TYPE_SHIFT) | payload);
+        return true;
+    }
+
+    bool ActionCodec::decode(ActionCode code, Action& out) {
+        int type = code >> TYPE_SHIFT;
+        if (type > static_cast<int>(ActionType::CHOOSE_STARTING_PLAYER)) return false;
+
+        ActionCode card = code & CARD_FIELD;
+        ActionCode wonder = (code >> WONDER_SHIFT) & WONDER_FIELD;
+        out = Action{};
+        out.type = static_cast<ActionType>(type);
+        switch (out.type) {
+            case ActionType::DRAFT_WONDER:
+                out.targetWonder = wonder == WONDER_FIELD ? NO_WONDER : static_cast<WonderIndex>(wonder);
+                break;
+            case ActionType::BUILD_CARD:
+            case ActionType::DISCARD_FOR_COINS:
+            case ActionType::SELECT_DESTRUCTION:
+            case ActionType::SELECT_FROM_DISCARD:
+                out.targetCard = card == CARD_FIELD ? NO_CARD : static_cast<CardIndex>(card);
+                break;
+            case ActionType::BUILD_WONDER:
+                out.targetCard = card == CARD_FIELD ? NO_CARD : static_cast<CardIndex>(card);
+                out.targetWonder = wonder == WONDER_FIELD ? NO_WONDER : static_cast<WonderIndex>(wonder);
+                break;
+            case ActionType::SELECT_PROGRESS_TOKEN:
+                out.selectedToken = static_cast<ProgressToken>(card);
+                break;
+            case ActionType::CHOOSE_STARTING_PLAYER:
+                out.chooseSelf = ((code >> FLAG_SHIFT) & 1u) != 0;
+                break;
+        }
+        return true;
+    }
+
+    // ==========================================================
+    //  GameRecord / ReplayFormat
+    // ==========================================================
+
+    std::uint64_t GameRecord::gameSeed() const {
+        return SeedHierarchy::gameSeed(masterSeed, gameIndex);
+    }
+
+    std::uint64_t GameRecordView::gameSeed() const {
+        return SeedHierarchy::gameSeed(masterSeed, gameIndex);
+    }
+
+    GameRecord GameRecordView::toRecord() const {
+        GameRecord record;
+        record.masterSeed = masterSeed;
+        record.gameIndex = gameIndex;
+        record.agent1 = std::string(agent1);
+        record.agent2 = std::string(agent2);
+        record.winnerIndex = winnerIndex;
+        record.victoryType = victoryType;
+        record.aborted = aborted;
+        record.actions.resize(actionCount);
+        for (size_t i = 0; i < actionCount; ++i) record.actions[i] = action(i);
+        return record;
+    }
+
+    constexpr char ReplayFormat::MAGIC[4];
+
+    void ReplayFormat::appendFileHeader(std::vector<std::uint8_t>& out) {
+        out.insert(out.end(), MAGIC, MAGIC + 4);
+        putU16(out, VERSION);
+        putU16(out, 0);
+    }
+
+    bool ReplayFormat::checkFileHeader(const std::uint8_t* data, size_t size) {
+        return size >= FILE_HEADER_BYTES && std::equal(MAGIC, MAGIC + 4, reinterpret_cast<const char*>(data)) &&
+               getU16(data + 4) == VERSION;
+    }
+
+    void ReplayFormat::appendRecord(const GameRecord& record, std::vector<std::uint8_t>& out) {
+        putU32(out, static_cast<std::uint32_t>(record.actions.size()));
+        putU64(out, record.masterSeed);
+        putU64(out, record.gameIndex);
+        int winner = std::clamp(record.winnerIndex + 1, 0, 2);
+        out.push_back(static_cast<std::uint8_t>(winner | (static_cast<int>(record.victoryType) << 2) | ((record.aborted ? 1 : 0) << 4)));
+        putName(out, record.agent1);
+        putName(out, record.agent2);
+        for (ActionCode code : record.actions) putU16(out, code);
+    }
+
+    size_t ReplayFormat::parseRecord(const std::uint8_t* data, size_t size, GameRecordView& out) {
+        if (size < RECORD_FIXED_BYTES) return 0;
+        const std::uint8_t* p = data;
+        const std::uint8_t* end = data + size;
+
+        std::uint32_t count = getU32(p);
+        out.masterSeed = getU64(p + 4);
+        out.gameIndex = getU64(p + 12);
+        std::uint8_t outcome = p[20];
+        p += RECORD_FIXED_BYTES;
+        out.winnerIndex = (outcome & 3) - 1;
+        out.victoryType = static_cast<VictoryType>((outcome >> 2) & 3);
+        out.aborted = ((outcome >> 4) & 1u) != 0;
+
+        if (!getName(p, end, out.agent1) || !getName(p, end, out.agent2)) return 0;
+        if (static_cast<size_t>(end - p) / 2 < count) return 0;
+        out.actionBytes = p;
+        out.actionCount = count;
+        p += 2 * static_cast<size_t>(count);
+        return static_cast<size_t>(p - data);
+    }
+
+    size_t ReplayFormat::parseRecord(const std::uint8_t* data, size_t size, GameRecord& out) {
+        GameRecordView view;
+        size_t used = parseRecord(data, size, view);
+        if (used > 0) out = view.toRecord();
+        return used;
+    }
+
+    // ==========================================================
+    //  ReplayWriter / ReplayReader
+    // ==========================================================
+
+    ReplayWriter::ReplayWriter(std::ostream& out) : m_out(out) {
+        ReplayFormat::appendFileHeader(m_buffer);
+        writeEncoded(m_buffer);
+    }
+
+    bool ReplayWriter::write(const GameRecord& record) {
+        m_buffer.clear();
+        ReplayFormat::appendRecord(record, m_buffer);
+        return writeEncoded(m_buffer);
+    }
+
+    bool ReplayWriter::writeEncoded(const std::vector<std::uint8_t>& bytes) {
+        m_out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        return good();
+    }
+
+    bool ReplayWriter::good() const {
+        return m_out.good();
+    }
+
+    ReplayReader::ReplayReader(std::istream& in) : m_in(in) {
+        std::uint8_t header[ReplayFormat::FILE_HEADER_BYTES];
+        m_in.read(reinterpret_cast<char*>(header), sizeof(header));
+        m_valid = m_in.gcount() == static_cast<std::streamsize>(sizeof(header)) &&
+                  ReplayFormat::checkFileHeader(header, sizeof(header));
+    }
+
+    bool ReplayReader::next(GameRecord& out) {
+        if (!m_valid) return false;
+
+        // 定长部分 + 两个名称长度决定整条记录的大小
+        m_buffer.resize(RECORD_FIXED_BYTES + 1);
+        m_in.read(reinterpret_cast<char*>(m_buffer.data()), static_cast<std::streamsize>(m_buffer.size()));
+        if (m_in.gcount() != static_cast<std::streamsize>(m_buffer.size())) return false;
+
+        auto readMore = [&](size_t n) {
+            size_t old = m_buffer.size();
+            m_buffer.resize(old + n);
+            m_in.read(reinterpret_cast<char*>(m_buffer.data() + old), static_cast<std::streamsize>(n));
+            return m_in.gcount() == static_cast<std::streamsize>(n);
+        };
+        size_t name1 = m_buffer.back();
+        if (!readMore(name1 + 1)) return false;
+        size_t name2 = m_buffer.back();
+        size_t actions = getU32(m_buffer.data());
+        if (!readMore(name2 + 2 * actions)) return false;
+
+        return ReplayFormat::parseRecord(m_buffer.data(), m_buffer.size(), out) == m_buffer.size();
+    }
+
+    // ==========================================================
+    //  ReplayEngine
+    // ==========================================================
+
+    ReplayEngine::ReplayEngine(std::shared_ptr<const CardDatabase> database, bool keepLog)
+        : m_database(std::move(database)) {
+        m_game.setLogEnabled(keepLog);
+    }
+
+    void ReplayEngine::start(std::uint64_t gameSeed, const std::string& p1Name, const std::string& p2Name) {
+        m_game.setSeed(gameSeed);
+        m_game.initializeGame(m_database, p1Name, p2Name);
+        m_game.startGame();
+        m_position = 0;
+    }
+
+    bool ReplayEngine::apply(ActionCode code) {
+        Action action;
+        if (!ActionCodec::decode(code, action) || !m_game.processAction(action)) return false;
+        m_position++;
+        return true;
+    }
+
+    bool ReplayEngine::replay(const GameRecordView& record, size_t count) {
+        start(record.gameSeed(), std::string(record.agent1), std::string(record.agent2));
+        size_t n = std::min(count, record.actionCount);
+        for (size_t i = 0; i < n; ++i) {
+            if (!apply(record.action(i))) return false;
+        }
+        return true;
+    }
+
+    bool ReplayEngine::replay(const GameRecord& record, size_t count) {
+        start(record.gameSeed(), record.agent1, record.agent2);
+        size_t n = std::min(count, record.actions.size());
+        for (size_t i = 0; i < n; ++i) {
+            if (!apply(record.actions[i])) return false;
+        }
+        return true;
+    }
+
+
+    // ==========================================================
+    //  ReplaySeeker
+    // ==========================================================
+
+    ReplaySeeker::ReplaySeeker(std::shared_ptr<const CardDatabase> database, size_t interval, bool keepLog)
+        : m_engine(std::move(database), keepLog), m_interval(std::max<size_t>(1, interval)), m_keepLog(keepLog) {}
+
+    bool ReplaySeeker::load(const GameRecord& record) {
+        m_record = record;
+        return build();
+    }
+
+    bool ReplaySeeker::load(const GameRecordView& record) {
+        m_record = record.toRecord();
+        return build();
+    }
+
+    bool ReplaySeeker::takeSnapshot() {
+        Snapshot snap;
+        const GameController& game = m_engine.getGame();
+        if (!StatePacker::pack(game, snap.state) || !StatePacker::captureDeal(game, snap.deal)) return false;
+        snap.logSize = game.getModel().getGameLog().size();
+        m_snapshots.push_back(snap);
+        return true;
+    }
+
+    bool ReplaySeeker::build() {
+        m_corpus = nullptr;
+        m_gameId = NO_GAME;
+        m_lastReplayed = 0;
+        m_actions.clear();
+        m_snapshots.clear();
+        m_fullLog.clear();
+
+        m_engine.start(m_record.gameSeed(), m_record.agent1, m_record.agent2);
+        bool ok = true;
+        for (size_t i = 0; ; ++i) {
+            if (i % m_interval == 0 && !takeSnapshot()) { ok = false; break; }
+            if (i == m_record.actions.size()) break;
+            if (!m_engine.apply(m_record.actions[i])) { ok = false; break; }
+            m_actions.push_back(m_record.actions[i]);
+        }
+        if (m_keepLog) m_fullLog = m_engine.getGame().getModel().getGameLog();
+        return ok;
+    }
+
+    bool ReplaySeeker::seek(size_t actionIndex) {
+        if (actionIndex > m_actions.size() || m_snapshots.empty()) return false;
+
+        size_t snapIndex = std::min(actionIndex / m_interval, m_snapshots.size() - 1);
+        size_t from = snapIndex * m_interval;
+        size_t position = m_engine.getPosition();
+
+        // 向前跳转且当前局面比快照更近时直接继续执行 (逐步前进只需一个动作)
+        if (actionIndex < position || position < from) {
+            const Snapshot& snap = m_snapshots[snapIndex];
+            GameController& game = m_engine.m_game;
+            if (!StatePacker::unpack(snap.state, game) || !StatePacker::restoreDeal(snap.deal, game)) return false;
+            m_engine.m_position = from;
+
+            // 当前日志总是完整日志的前缀，截断或补齐到快照处即可
+            if (m_keepLog) {
+                size_t have = game.getModel().getGameLog().size();
+                if (have > snap.logSize) game.truncateLog(snap.logSize);
+                for (size_t i = have; i < snap.logSize; ++i) game.addLog(m_fullLog[i]);
+            }
+        } else {
+            from = position;
+        }
+
+        m_lastReplayed = actionIndex - from;
+        for (size_t i = from; i < actionIndex; ++i) {
+            if (!m_engine.apply(m_actions[i])) return false;
+        }
+        return true;
+    }
+
+    bool ReplaySeeker::seek(const CorpusReader& corpus, size_t gameId, size_t actionIndex) {
+        if (&corpus != m_corpus || gameId != m_gameId) {
+            GameRecordView view;
+            if (!corpus.getGame(gameId, view)) return false;
+            load(view);   // 失败时仍可在合法前缀内跳转
+            m_corpus = &corpus;
+            m_gameId = gameId;
+        }
+        return seek(actionIndex);
+    }
+
+}
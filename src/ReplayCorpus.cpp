@@ -0,0 +1,164 @@
+#include "ReplayCorpus.h"
+#include <algorithm>
+
+namespace SevenWondersDuel {
+
+    namespace {
+        void putU64(std::uint8_t* p, std::uint64_t v) {
+            for (int i = 0; i < 8; ++i) p[i] = static_cast<std::uint8_t>(v >> (8 * i));
+        }
+
+        std::uint64_t getU64(const std::uint8_t* p) {
+            std::uint64_t v = 0;
+            for (int i = 7; i >= 0; --i) v = (v << 8) | p[i];
+            return v;
+        }
+
+        std::uint16_t getU16(const std::uint8_t* p) {
+            return static_cast<std::uint16_t>(p[0] | (p[1] << 8));
+        }
+
+        void encodeHeader(std::uint8_t* header, std::uint64_t gameCount, std::uint64_t indexOffset) {
+            std::fill(header, header + CorpusFormat::HEADER_BYTES, 0);
+            std::copy(CorpusFormat::MAGIC, CorpusFormat::MAGIC + 4, header);
+            header[4] = static_cast<std::uint8_t>(CorpusFormat::VERSION);
+            header[5] = static_cast<std::uint8_t>(CorpusFormat::VERSION >> 8);
+            putU64(header + 12, gameCount);
+            putU64(header + 20, indexOffset);
+        }
+    }
+
+    constexpr char CorpusFormat::MAGIC[4];
+
+    // ==========================================================
+    //  CorpusWriter
+    // ==========================================================
+
+    CorpusWriter::Buffer::Buffer(CorpusWriter& writer, size_t flushBytes)
+        : m_writer(writer), m_flushBytes(flushBytes) {
+        m_bytes.reserve(flushBytes + 1024);
+    }
+
+    CorpusWriter::Buffer::~Buffer() {
+        flush();
+    }
+
+    void CorpusWriter::Buffer::append(const GameRecord& record) {
+        m_offsets.push_back(m_bytes.size());
+        ReplayFormat::appendRecord(record, m_bytes);
+        if (m_bytes.size() >= m_flushBytes) flush();
+    }
+
+    void CorpusWriter::Buffer::flush() {
+        if (m_offsets.empty()) return;
+        m_writer.commit(m_bytes, m_offsets);
+        m_bytes.clear();
+        m_offsets.clear();
+    }
+
+    CorpusWriter::CorpusWriter(const std::string& path) : m_out(path, std::ios::binary | std::ios::trunc) {
+        // 先写一个对局数为 0 的文件头占位，close() 时回填
+        std::uint8_t header[CorpusFormat::HEADER_BYTES];
+        encodeHeader(header, 0, 0);
+        m_out.write(reinterpret_cast<const char*>(header), sizeof(header));
+        m_open = m_out.good();
+    }
+
+    CorpusWriter::~CorpusWriter() {
+        close();
+    }
+
+    void CorpusWriter::commit(const std::vector<std::uint8_t>& bytes, const std::vector<std::uint64_t>& offsets) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_open) return;
+        m_out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        if (!m_out.good()) m_failed = true;
+        for (std::uint64_t off : offsets) m_index.push_back(m_end + off);
+        m_end += bytes.size();
+    }
+
+    bool CorpusWriter::close() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_open) return !m_failed;
+        m_open = false;
+
+        std::vector<std::uint8_t> index(8 * m_index.size());
+        for (size_t i = 0; i < m_index.size(); ++i) putU64(index.data() + 8 * i, m_index[i]);
+        m_out.write(reinterpret_cast<const char*>(index.data()), static_cast<std::streamsize>(index.size()));
+
+        std::uint8_t header[CorpusFormat::HEADER_BYTES];
+        encodeHeader(header, m_index.size(), m_end);
+        m_out.seekp(0);
+        m_out.write(reinterpret_cast<const char*>(header), sizeof(header));
+        m_out.close();
+        if (m_out.fail()) m_failed = true;
+        return !m_failed;
+    }
+
+    std::uint64_t CorpusWriter::getGameCount() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_index.size();
+    }
+
+    // ==========================================================
+    //  CorpusReader
+    // ==========================================================
+
+    bool CorpusReader::open(const std::string& path) {
+        close();
+        if (!m_file.open(path)) return false;
+
+        const std::uint8_t* data = m_file.data();
+        size_t size = m_file.size();
+        if (size < CorpusFormat::HEADER_BYTES || !std::equal(CorpusFormat::MAGIC, CorpusFormat::MAGIC + 4, reinterpret_cast<const char*>(data)) ||
+            getU16(data + 4) != CorpusFormat::VERSION) {
+            close();
+            return false;
+        }
+
+        std::uint64_t count = getU64(data + 12);
+        std::uint64_t indexOffset = getU64(data + 20);
+        if (count > 0 && indexOffset >= CorpusFormat::HEADER_BYTES && indexOffset <= size && (size - indexOffset) / 8 >= count) {
+            m_index = data + indexOffset;
+            m_count = static_cast<size_t>(count);
+            m_recordsEnd = static_cast<size_t>(indexOffset);
+            m_storedIndex = true;
+            return true;
+        }
+
+        // 未正常关闭：顺序扫描记录区，扫到第一条不完整的记录为止
+        m_recordsEnd = size;
+        GameRecordView view;
+        size_t pos = CorpusFormat::HEADER_BYTES;
+        while (pos < size) {
+            size_t used = ReplayFormat::parseRecord(data + pos, size - pos, view);
+            if (used == 0) break;
+            m_recoveredIndex.push_back(pos);
+            pos += used;
+        }
+        m_recordsEnd = pos;
+        m_count = m_recoveredIndex.size();
+        return true;
+    }
+
+    void CorpusReader::close() {
+        m_file.close();
+        m_index = nullptr;
+        m_recoveredIndex.clear();
+        m_count = 0;
+        m_recordsEnd = 0;
+        m_storedIndex = false;
+    }
+
+    std::uint64_t CorpusReader::offsetOf(size_t n) const {
+        return m_storedIndex ? getU64(m_index + 8 * n) : m_recoveredIndex[n];
+    }
+
+    bool CorpusReader::getGame(size_t n, GameRecordView& out) const {
+        if (n >= m_count) return false;
+        std::uint64_t offset = offsetOf(n);
+        if (offset < CorpusFormat::HEADER_BYTES || offset >= m_recordsEnd) return false;
+        return ReplayFormat::parseRecord(m_file.data() + offset, m_recordsEnd - offset, out) > 0;
+    }
+
+}
@@ -5,14 +5,10 @@
 namespace SevenWondersDuel {
 
     ScienceSymbol RulesEngine::getNewSciencePairSymbol(const Player& player) {
-        for (auto const& [sym, count] : player.getScienceSymbols()) {
-            if (sym == ScienceSymbol::NONE) continue;
-
-            if (count >= Config::SCIENCE_PAIR_COUNT) {
-                const auto& claimed = player.getClaimedSciencePairs();
-                if (claimed.find(sym) == claimed.end()) {
-                    return sym;
-                }
+        for (int s = static_cast<int>(ScienceSymbol::GLOBE); s <= static_cast<int>(ScienceSymbol::LAW); ++s) {
+            ScienceSymbol sym = static_cast<ScienceSymbol>(s);
+            if (player.getScienceSymbolCount(sym) >= Config::SCIENCE_PAIR_COUNT && !player.hasClaimedSciencePair(sym)) {
+                return sym;
             }
         }
         return ScienceSymbol::NONE;
@@ -36,13 +32,7 @@ namespace SevenWondersDuel {
         // 2. Science Supremacy
         const Player* players[2] = { &p1, &p2 };
         for (int i = 0; i < 2; ++i) {
-            int distinctSymbols = 0;
-            for (auto const& [sym, count] : players[i]->getScienceSymbols()) {
-                if (sym != ScienceSymbol::NONE && count > 0) {
-                    distinctSymbols++;
-                }
-            }
-            if (distinctSymbols >= Config::SCIENCE_WIN_THRESHOLD) {
+            if (players[i]->getDistinctScienceSymbolCount() >= Config::SCIENCE_WIN_THRESHOLD) {
                 result.isGameOver = true;
                 result.type = VictoryType::SCIENCE;
                 result.winnerIndex = i;
@@ -3,35 +3,43 @@
 
 namespace SevenWondersDuel {
 
-    int ScoringManager::calculateScore(const Player& player, const Player& opponent, const Board& board) {
-        int score = 0;
+    ScoreBreakdown ScoringManager::calculateBreakdown(const Player& player, const Player& opponent, const Board& board) {
+        ScoreBreakdown score;
 
         // 1. Cards (including Guilds)
-        for (const auto& card : player.getBuiltCards()) {
-            score += card->getVictoryPoints(&player, &opponent);
+        for (const auto& card : player.getAllCards()) {
+            int vp = card->getVictoryPoints(&player, &opponent);
+            switch (card->getType()) {
+                case CardType::SCIENTIFIC: score.science += vp; break;
+                case CardType::COMMERCIAL: score.commercial += vp; break;
+                case CardType::GUILD:      score.guild += vp; break;
+                default:                   score.civilian += vp; break;
+            }
         }
 
         // 2. Wonders
         for (const auto& wonder : player.getBuiltWonders()) {
-            score += wonder->getVictoryPoints(&player, &opponent);
+            score.wonder += wonder->getVictoryPoints(&player, &opponent);
         }
 
         // 3. Military Track
-        score += board.getMilitaryTrack().getVictoryPoints(player.getId());
+        score.military = board.getMilitaryTrack().getVictoryPoints(player.getId());
 
         // 4. Coins (3 coins = 1 VP)
-        score += player.getCoins() / Config::COINS_PER_VP;
+        score.coins = player.getCoins() / Config::COINS_PER_VP;
 
         // 5. Progress Tokens
-        for (auto token : player.getProgressTokens()) {
-            if (token == ProgressToken::AGRICULTURE) score += Config::AGRICULTURE_VP;
-            if (token == ProgressToken::MATHEMATICS) score += Config::MATHEMATICS_VP_PER_TOKEN * player.getProgressTokens().size(); 
-            if (token == ProgressToken::PHILOSOPHY) score += Config::PHILOSOPHY_VP;
-        }
+        if (player.hasProgressToken(ProgressToken::AGRICULTURE)) score.tokens += Config::AGRICULTURE_VP;
+        if (player.hasProgressToken(ProgressToken::MATHEMATICS)) score.tokens += Config::MATHEMATICS_VP_PER_TOKEN * player.getProgressTokenCount();
+        if (player.hasProgressToken(ProgressToken::PHILOSOPHY)) score.tokens += Config::PHILOSOPHY_VP;
 
         return score;
     }
 
+    int ScoringManager::calculateScore(const Player& player, const Player& opponent, const Board& board) {
+        return calculateBreakdown(player, opponent, board).total();
+    }
+
     int ScoringManager::calculateBluePoints(const Player& player, const Player& opponent) {
         int score = 0;
         for (auto card : player.getCardsByType(CardType::CIVILIAN)) {
@@ -0,0 +1,160 @@
+#include "SelfPlay.h"
+#include "GameController.h"
+#include "GameView.h"
+#include "InputManager.h"
+#include "Agent.h"
+#include "Random.h"
+#include "CardDatabase.h"
+#include "ReplayCorpus.h"
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+namespace SevenWondersDuel {
+
+    // ==========================================================
+    //  SelfPlayStats
+    // ==========================================================
+
+    void SelfPlayStats::record(const GameOutcome& outcome) {
+        games++;
+        actions += outcome.actions;
+        if (outcome.aborted) {
+            aborted++;
+            return;
+        }
+        if (outcome.winnerIndex == 0 || outcome.winnerIndex == 1) wins[outcome.winnerIndex]++;
+        else draws++;
+        victoryTypes[static_cast<int>(outcome.victoryType)]++;
+    }
+
+    void SelfPlayStats::merge(const SelfPlayStats& other) {
+        games += other.games;
+        actions += other.actions;
+        wins[0] += other.wins[0];
+        wins[1] += other.wins[1];
+        draws += other.draws;
+        aborted += other.aborted;
+        for (int i = 0; i < 4; ++i) victoryTypes[i] += other.victoryTypes[i];
+    }
+
+    double SelfPlayStats::gamesPerSecond() const {
+        return seconds > 0.0 ? games / seconds : 0.0;
+    }
+
+    double SelfPlayStats::actionsPerSecond() const {
+        return seconds > 0.0 ? actions / seconds : 0.0;
+    }
+
+    // ==========================================================
+    //  SelfPlayRunner
+    // ==========================================================
+
+    SelfPlayRunner::SelfPlayRunner(SelfPlayConfig config) : m_config(std::move(config)) {}
+
+    GameOutcome SelfPlayRunner::playGame(GameController& game, IPlayerAgent& agent1, IPlayerAgent& agent2, int maxActions,
+                                         std::vector<ActionCode>* actions) {
+        // AI 代理不会读取 View / InputManager，这里仅为满足接口
+        GameView view;
+        InputManager input;
+        GameOutcome outcome;
+
+        game.startGame();
+
+        while (game.getState() != GameState::GAME_OVER) {
+            if (outcome.actions >= maxActions) {
+                outcome.aborted = true;
+                return outcome;
+            }
+
+            IPlayerAgent& current = (game.getModel().getCurrentPlayerIndex() == 0) ? agent1 : agent2;
+            Action action = current.decideAction(game, view, input);
+
+            if (!game.processAction(action)) {
+                // 交互模式下 main 会跳过该动作；批量模式直接中止该局，避免死循环
+                outcome.aborted = true;
+                return outcome;
+            }
+            outcome.actions++;
+
+            ActionCode code;
+            if (actions && ActionCodec::encode(action, code)) actions->push_back(code);
+        }
+
+        outcome.winnerIndex = game.getModel().getWinnerIndex();
+        outcome.victoryType = game.getModel().getVictoryType();
+        return outcome;
+    }
+
+    void SelfPlayRunner::runWorker(const std::shared_ptr<const CardDatabase>& database, int workerIndex, int workerCount, SelfPlayStats& stats,
+                                   CorpusWriter* corpus) const {
+        auto agent1 = AgentFactory::createAI(m_config.agent1, false);
+        auto agent2 = AgentFactory::createAI(m_config.agent2, false);
+        if (!agent1 || !agent2) return;
+
+        // 记录先攒在线程本地缓冲，整块追加到语料库
+        std::unique_ptr<CorpusWriter::Buffer> records;
+        if (corpus) records = std::make_unique<CorpusWriter::Buffer>(*corpus);
+
+        GameController game;
+        GameRecord record;
+        record.masterSeed = m_config.masterSeed;
+        record.agent1 = m_config.agent1;
+        record.agent2 = m_config.agent2;
+        for (int i = workerIndex; i < m_config.games; i += workerCount) {
+            std::uint64_t gameSeed = SeedHierarchy::gameSeed(m_config.masterSeed, m_config.firstGameIndex + i);
+
+            game.setSeed(gameSeed);
+            agent1->setRandomStream(SeedHierarchy::stream(gameSeed, RngStream::AGENT_1));
+            agent2->setRandomStream(SeedHierarchy::stream(gameSeed, RngStream::AGENT_2));
+            game.initializeGame(database, "Player 1", "Player 2");
+
+            record.actions.clear();
+            GameOutcome outcome = playGame(game, *agent1, *agent2, m_config.maxActionsPerGame, records ? &record.actions : nullptr);
+            stats.record(outcome);
+
+            if (records) {
+                record.gameIndex = m_config.firstGameIndex + i;
+                record.winnerIndex = outcome.winnerIndex;
+                record.victoryType = outcome.victoryType;
+                record.aborted = outcome.aborted;
+                records->append(record);
+            }
+        }
+    }
+
+    SelfPlayStats SelfPlayRunner::run() {
+        int workerCount = std::max(1, std::min(m_config.threads, m_config.games));
+        std::vector<SelfPlayStats> perWorker(workerCount);
+        std::unique_ptr<CorpusWriter> corpus;
+        if (!m_config.recordPath.empty()) {
+            corpus = std::make_unique<CorpusWriter>(m_config.recordPath);
+            if (!corpus->isOpen()) std::cerr << "Failed to create " << m_config.recordPath << std::endl;
+        }
+
+        // 只读数据只解析一次，所有工作线程共享
+        std::shared_ptr<const CardDatabase> database = CardDatabase::load(m_config.dataPath);
+
+        auto start = std::chrono::steady_clock::now();
+
+        std::vector<std::thread> workers;
+        for (int w = 1; w < workerCount; ++w) {
+            workers.emplace_back(&SelfPlayRunner::runWorker, this, std::cref(database), w, workerCount, std::ref(perWorker[w]),
+                                 corpus.get());
+        }
+        runWorker(database, 0, workerCount, perWorker[0], corpus.get());
+        for (auto& t : workers) t.join();
+
+        auto end = std::chrono::steady_clock::now();
+
+        SelfPlayStats total;
+        for (const auto& s : perWorker) total.merge(s);
+        total.seconds = std::chrono::duration<double>(end - start).count();
+
+        if (corpus && !corpus->close()) std::cerr << "Failed to write game records to " << m_config.recordPath << std::endl;
+        return total;
+    }
+
+}
@@ -0,0 +1,241 @@
+#include "Tournament.h"
+#include "SelfPlay.h"
+#include "GameController.h"
+#include "Agent.h"
+#include "Random.h"
+#include "CardDatabase.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace SevenWondersDuel {
+
+    namespace {
+
+        /**
+         * @brief 一个任务块：某组对阵中连续的若干局
+         */
+        struct TaskChunk {
+            int pairing = 0;
+            int firstGame = 0;
+            int count = 0;
+        };
+
+        /**
+         * @brief 工作窃取队列
+         * 所有者从尾部取任务，窃取者从头部取任务，两端争用极少。
+         * 任务只在启动前一次性分发，运行期间不会新增。
+         */
+        class StealingQueue {
+        public:
+            void push(const TaskChunk& chunk) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_tasks.push_back(chunk);
+            }
+
+            bool popBack(TaskChunk& out) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_tasks.empty()) return false;
+                out = m_tasks.back();
+                m_tasks.pop_back();
+                return true;
+            }
+
+            bool stealFront(TaskChunk& out) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_tasks.empty()) return false;
+                out = m_tasks.front();
+                m_tasks.pop_front();
+                return true;
+            }
+
+        private:
+            std::mutex m_mutex;
+            std::deque<TaskChunk> m_tasks;
+        };
+
+        /**
+         * @brief 线程私有状态 (按缓存行对齐，避免伪共享)
+         */
+        struct alignas(64) WorkerState {
+            StealingQueue queue;
+            std::vector<PairingResult> results;
+            long long steals = 0;
+        };
+
+    }
+
+    // ==========================================================
+    //  PairingResult
+    // ==========================================================
+
+    void PairingResult::merge(const PairingResult& other) {
+        games += other.games;
+        winsA += other.winsA;
+        winsB += other.winsB;
+        draws += other.draws;
+        aborted += other.aborted;
+        actions += other.actions;
+    }
+
+    double PairingResult::scoreA() const {
+        long long finished = winsA + winsB + draws;
+        return finished > 0 ? (winsA + 0.5 * draws) / finished : 0.0;
+    }
+
+    std::pair<double, double> PairingResult::confidenceInterval(double z) const {
+        double n = static_cast<double>(winsA + winsB + draws);
+        if (n <= 0.0) return {0.0, 1.0};
+
+        double p = scoreA();
+        double z2 = z * z;
+        double denom = 1.0 + z2 / n;
+        double centre = (p + z2 / (2.0 * n)) / denom;
+        double half = z * std::sqrt(p * (1.0 - p) / n + z2 / (4.0 * n * n)) / denom;
+        return {std::max(0.0, centre - half), std::min(1.0, centre + half)};
+    }
+
+    double TournamentReport::gamesPerSecond() const {
+        return seconds > 0.0 ? games / seconds : 0.0;
+    }
+
+    // ==========================================================
+    //  TournamentRunner
+    // ==========================================================
+
+    TournamentRunner::TournamentRunner(TournamentConfig config, std::vector<TournamentEntrant> entrants)
+        : m_config(std::move(config)), m_entrants(std::move(entrants)) {}
+
+    std::vector<std::pair<int, int>> TournamentRunner::makePairings(PairingMode mode, int entrantCount) {
+        std::vector<std::pair<int, int>> pairings;
+        if (mode == PairingMode::GAUNTLET) {
+            for (int j = 1; j < entrantCount; ++j) pairings.emplace_back(0, j);
+        } else {
+            for (int i = 0; i < entrantCount; ++i)
+                for (int j = i + 1; j < entrantCount; ++j) pairings.emplace_back(i, j);
+        }
+        return pairings;
+    }
+
+    TournamentReport TournamentRunner::run() {
+        TournamentReport report;
+        for (const auto& e : m_entrants) report.entrantNames.push_back(e.name);
+
+        auto pairings = makePairings(m_config.mode, static_cast<int>(m_entrants.size()));
+        int gamesPerPairing = std::max(0, m_config.gamesPerPairing);
+        int chunkSize = std::max(1, m_config.chunkSize);
+
+        long long totalGames = static_cast<long long>(pairings.size()) * gamesPerPairing;
+        long long totalChunks = (totalGames + chunkSize - 1) / chunkSize;
+        int workerCount = static_cast<int>(std::max(1LL, std::min<long long>(m_config.threads, totalChunks)));
+        report.threads = workerCount;
+
+        std::vector<WorkerState> workers(workerCount);
+        for (auto& w : workers) {
+            w.results.resize(pairings.size());
+            for (size_t p = 0; p < pairings.size(); ++p) {
+                w.results[p].entrantA = pairings[p].first;
+                w.results[p].entrantB = pairings[p].second;
+            }
+        }
+
+        // 任务块轮流分发到各线程队列
+        int next = 0;
+        for (size_t p = 0; p < pairings.size(); ++p) {
+            for (int g = 0; g < gamesPerPairing; g += chunkSize) {
+                workers[next].queue.push({static_cast<int>(p), g, std::min(chunkSize, gamesPerPairing - g)});
+                next = (next + 1) % workerCount;
+            }
+        }
+
+        // 只读数据只解析一次，所有工作线程共享
+        std::shared_ptr<const CardDatabase> database = CardDatabase::load(m_config.dataPath);
+
+        // 同一局面种子被两局共享 (交换座次)
+        int seedsPerPairing = (gamesPerPairing + 1) / 2;
+
+        auto workerMain = [&](int self) {
+            WorkerState& state = workers[self];
+
+            GameController game;
+            std::vector<std::unique_ptr<IPlayerAgent>> agents(m_entrants.size());
+
+            auto agentFor = [&](int entrant) -> IPlayerAgent* {
+                if (!agents[entrant]) agents[entrant] = m_entrants[entrant].factory();
+                return agents[entrant].get();
+            };
+
+            auto runChunk = [&](const TaskChunk& chunk) {
+                PairingResult& result = state.results[chunk.pairing];
+                IPlayerAgent* a = agentFor(result.entrantA);
+                IPlayerAgent* b = agentFor(result.entrantB);
+                if (!a || !b) return;
+
+                for (int g = chunk.firstGame; g < chunk.firstGame + chunk.count; ++g) {
+                    std::uint64_t seedIndex = static_cast<std::uint64_t>(chunk.pairing) * seedsPerPairing + g / 2;
+                    std::uint64_t gameSeed = SeedHierarchy::gameSeed(m_config.masterSeed, seedIndex);
+                    bool aFirst = (g % 2 == 0);
+                    IPlayerAgent* p1 = aFirst ? a : b;
+                    IPlayerAgent* p2 = aFirst ? b : a;
+
+                    game.setSeed(gameSeed);
+                    p1->setRandomStream(SeedHierarchy::stream(gameSeed, RngStream::AGENT_1));
+                    p2->setRandomStream(SeedHierarchy::stream(gameSeed, RngStream::AGENT_2));
+                    game.initializeGame(database, "Player 1", "Player 2");
+
+                    GameOutcome outcome = SelfPlayRunner::playGame(game, *p1, *p2, m_config.maxActionsPerGame);
+
+                    result.games++;
+                    result.actions += outcome.actions;
+                    if (outcome.aborted) { result.aborted++; continue; }
+                    if (outcome.winnerIndex < 0) { result.draws++; continue; }
+                    bool aWon = (outcome.winnerIndex == 0) == aFirst;
+                    if (aWon) result.winsA++; else result.winsB++;
+                }
+            };
+
+            TaskChunk chunk;
+            while (true) {
+                if (state.queue.popBack(chunk)) { runChunk(chunk); continue; }
+
+                bool stolen = false;
+                for (int k = 1; k < workerCount && !stolen; ++k) {
+                    stolen = workers[(self + k) % workerCount].queue.stealFront(chunk);
+                }
+                if (!stolen) break; // 任务不会再增加，所有队列皆空即可退出
+                state.steals++;
+                runChunk(chunk);
+            }
+        };
+
+        auto start = std::chrono::steady_clock::now();
+
+        std::vector<std::thread> threads;
+        for (int w = 1; w < workerCount; ++w) threads.emplace_back(workerMain, w);
+        workerMain(0);
+        for (auto& t : threads) t.join();
+
+        auto end = std::chrono::steady_clock::now();
+
+        // join 之后单线程合并各线程私有结果
+        report.pairings.resize(pairings.size());
+        for (size_t p = 0; p < pairings.size(); ++p) {
+            report.pairings[p].entrantA = pairings[p].first;
+            report.pairings[p].entrantB = pairings[p].second;
+        }
+        for (const auto& w : workers) {
+            for (size_t p = 0; p < pairings.size(); ++p) report.pairings[p].merge(w.results[p]);
+            report.steals += w.steals;
+        }
+        for (const auto& r : report.pairings) {
+            report.games += r.games;
+            report.actions += r.actions;
+        }
+        report.seconds = std::chrono::duration<double>(end - start).count();
+        return report;
+    }
+
+}
@@ -0,0 +1,121 @@
+#include "TranspositionTable.h"
+#include <algorithm>
+#include <climits>
+
+namespace SevenWondersDuel {
+
+    namespace {
+        constexpr size_t HASHFULL_SAMPLE_BUCKETS = 1000;
+    }
+
+    // 条目数据字的布局 (低位在前)：
+    //   [0, 32) value   [32, 48) depth   [48, 56) move   [56, 58) bound   [58, 64) generation
+    std::uint64_t SharedTranspositionTable::pack(const TTData& d, std::uint32_t generation) {
+        return static_cast<std::uint64_t>(static_cast<std::uint32_t>(d.value))
+             | static_cast<std::uint64_t>(static_cast<std::uint16_t>(d.depth)) << 32
+             | static_cast<std::uint64_t>(d.move) << 48
+             | static_cast<std::uint64_t>(d.bound & 3u) << 56
+             | static_cast<std::uint64_t>(generation & (GENERATIONS - 1)) << 58;
+    }
+
+    TTData SharedTranspositionTable::unpack(std::uint64_t word) {
+        TTData d;
+        d.value = static_cast<std::int32_t>(static_cast<std::uint32_t>(word));
+        d.depth = static_cast<std::int16_t>(static_cast<std::uint16_t>(word >> 32));
+        d.move = static_cast<std::uint8_t>(word >> 48);
+        d.bound = static_cast<std::uint8_t>(boundOf(word));
+        return d;
+    }
+
+    SharedTranspositionTable::SharedTranspositionTable(size_t sizeMB) {
+        size_t bytes = std::max<size_t>(sizeMB, 1) << 20;
+        size_t buckets = 1;
+        while (buckets * 2 * sizeof(Bucket) <= bytes) buckets *= 2;
+        m_buckets.reset(new Bucket[buckets]);
+        m_bucketMask = buckets - 1;
+        clear();
+    }
+
+    SharedTranspositionTable::~SharedTranspositionTable() = default;
+
+    void SharedTranspositionTable::clear() {
+        for (size_t i = 0; i <= m_bucketMask; ++i) {
+            for (Entry& e : m_buckets[i].entries) {
+                e.check.store(0, std::memory_order_relaxed);
+                e.data.store(0, std::memory_order_relaxed);
+            }
+        }
+        m_generation.store(0, std::memory_order_relaxed);
+    }
+
+    bool SharedTranspositionTable::probe(std::uint64_t key, TTData& out, TTCounters& counters) const {
+        counters.probes++;
+        const Bucket& bucket = m_buckets[key & m_bucketMask];
+        for (const Entry& e : bucket.entries) {
+            std::uint64_t check = e.check.load(std::memory_order_relaxed);
+            std::uint64_t data = e.data.load(std::memory_order_relaxed);
+            if (boundOf(data) != 0 && (check ^ data) == key) {
+                counters.hits++;
+                out = unpack(data);
+                return true;
+            }
+            // 校验字在读取期间发生变化：与其他线程的写入重叠 (该条目按未命中处理)
+            if (e.check.load(std::memory_order_relaxed) != check) counters.racyReads++;
+        }
+        return false;
+    }
+
+    void SharedTranspositionTable::store(std::uint64_t key, const TTData& data, TTCounters& counters) {
+        std::uint32_t generation = m_generation.load(std::memory_order_relaxed);
+        Bucket& bucket = m_buckets[key & m_bucketMask];
+
+        Entry* victim = nullptr;
+        std::uint64_t victimCheck = 0, victimData = 0;
+        int victimScore = INT_MAX;
+        for (Entry& e : bucket.entries) {
+            std::uint64_t check = e.check.load(std::memory_order_relaxed);
+            std::uint64_t word = e.data.load(std::memory_order_relaxed);
+            // 同一局面总是原地更新
+            if (boundOf(word) != 0 && (check ^ word) == key) {
+                victim = &e;
+                victimCheck = check;
+                victimData = 0;
+                break;
+            }
+            // 空条目优先，其次是"深度 - 世代差"最小 (最浅、最旧) 的条目
+            int score = INT_MIN;
+            if (boundOf(word) != 0) {
+                int age = static_cast<int>((generation - generationOf(word)) & (GENERATIONS - 1));
+                score = static_cast<std::int16_t>(static_cast<std::uint16_t>(word >> 32)) - AGE_WEIGHT * age;
+            }
+            if (score < victimScore) {
+                victim = &e;
+                victimCheck = check;
+                victimData = word;
+                victimScore = score;
+            }
+        }
+
+        counters.stores++;
+        if (boundOf(victimData) != 0) counters.replacements++;
+        if (victim->check.load(std::memory_order_relaxed) != victimCheck) counters.racyWrites++;
+
+        std::uint64_t word = pack(data, generation);
+        victim->data.store(word, std::memory_order_relaxed);
+        victim->check.store(key ^ word, std::memory_order_relaxed);
+    }
+
+    int SharedTranspositionTable::hashfull() const {
+        std::uint32_t generation = m_generation.load(std::memory_order_relaxed);
+        size_t sample = std::min(HASHFULL_SAMPLE_BUCKETS, getBucketCount());
+        size_t used = 0;
+        for (size_t i = 0; i < sample; ++i) {
+            for (const Entry& e : m_buckets[i].entries) {
+                std::uint64_t word = e.data.load(std::memory_order_relaxed);
+                if (boundOf(word) != 0 && generationOf(word) == generation) used++;
+            }
+        }
+        return static_cast<int>(used * 1000 / (sample * BUCKET_SIZE));
+    }
+
+}
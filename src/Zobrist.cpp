@@ -0,0 +1,92 @@
+#include "Zobrist.h"
+#include "GameController.h"
+#include "Random.h"
+#include <type_traits>
+
+namespace SevenWondersDuel {
+
+    namespace {
+        // 固定种子：键表在所有进程中一致
+        constexpr std::uint64_t ZOBRIST_SEED = 0x7D0E1C5A2B3F4961ULL;
+
+        template <typename T, size_t N>
+        void fill(T (&keys)[N], std::uint64_t& state) {
+            for (auto& k : keys) {
+                if constexpr (std::is_array_v<T>) fill(k, state);
+                else k = splitMix64(state);
+            }
+        }
+    }
+
+    const Zobrist::Keys Zobrist::s_keys = Zobrist::generate();
+
+    Zobrist::Keys Zobrist::generate() {
+        Keys keys{};
+        std::uint64_t state = ZOBRIST_SEED;
+        fill(keys.pyramid, state);
+        fill(keys.builtCard, state);
+        fill(keys.overlay, state);
+        fill(keys.wonder, state);
+        fill(keys.draftPool, state);
+        fill(keys.discard, state);
+        fill(keys.playerToken, state);
+        fill(keys.boardToken, state);
+        fill(keys.boxToken, state);
+        fill(keys.coins, state);
+        fill(keys.military, state);
+        fill(keys.loot, state);
+        fill(keys.currentPlayer, state);
+        fill(keys.age, state);
+        fill(keys.state, state);
+        keys.extraTurn = splitMix64(state);
+        fill(keys.destruction, state);
+        return keys;
+    }
+
+    std::uint64_t Zobrist::computeModelHash(const GameModel& model) {
+        std::uint64_t h = currentPlayer(model.getCurrentPlayerIndex()) ^ age(model.getCurrentAge());
+
+        for (const Wonder* w : model.getDraftPool()) h ^= draftPool(w->getIndex());
+
+        for (const auto& p : model.getPlayers()) {
+            int id = p->getId();
+            h ^= coins(id, p->getCoins());
+            for (const Card* c : p->getAllCards()) h ^= builtCard(id, c->getIndex());
+            for (const Wonder* w : p->getUnbuiltWonders()) h ^= unbuiltWonder(id, w->getIndex());
+            for (int i = 0; i < p->getBuiltWonderCount(); ++i) {
+                h ^= builtWonder(id, p->getBuiltWonders()[i]->getIndex());
+                if (const Card* overlay = p->getWonderOverlay(i)) h ^= wonderOverlay(id, overlay->getIndex());
+            }
+            for (int t = 0; t < TOKEN_KINDS; ++t) {
+                if (p->hasProgressToken(static_cast<ProgressToken>(t))) h ^= playerToken(id, static_cast<ProgressToken>(t));
+            }
+        }
+
+        const Board& board = *model.getBoard();
+        const CardPyramid& pyramid = board.getCardStructure();
+        for (int i = 0; i < pyramid.getSlotCount(); ++i) {
+            const Card* c = pyramid.getSlot(i).getCardPtr();
+            if (c && !pyramid.isRemoved(i)) h ^= pyramidSlot(i, c->getIndex(), pyramid.isFaceUp(i));
+        }
+        for (const Card* c : board.getDiscardPile()) h ^= discardedCard(c->getIndex());
+        for (ProgressToken t : board.getAvailableProgressTokens()) h ^= boardToken(t);
+        for (ProgressToken t : board.getBoxProgressTokens()) h ^= boxToken(t);
+
+        const MilitaryTrack& track = board.getMilitaryTrack();
+        h ^= militaryPosition(track.getPosition());
+        for (int i = 0; i < 4; ++i) {
+            if (track.getLootTokens()[i]) h ^= lootToken(i);
+        }
+        return h;
+    }
+
+    std::uint64_t Zobrist::hideFaceDownCards(std::uint64_t hash, const CardPyramid& pyramid) {
+        for (int i = 0; i < pyramid.getSlotCount(); ++i) {
+            if (pyramid.isFaceUp(i) || pyramid.isRemoved(i)) continue;
+            const Card* card = pyramid.getSlot(i).getCardPtr();
+            if (card) hash ^= pyramidSlot(i, card->getIndex(), false) ^ pyramidSlot(i, NO_CARD, false);
+        }
+        return hash;
+    }
+
+}
@@ -0,0 +1,64 @@
+// Helpers shared by the search benchmarks (bench_mcts.cpp, bench_alphabeta.cpp):
+// the --threads list parser and the seeded random-play setup of benchmark
+// positions. Header-only; tools include it by relative path.
+
+#ifndef SEVEN_WONDERS_DUEL_BENCHCOMMON_H
+#define SEVEN_WONDERS_DUEL_BENCHCOMMON_H
+
+#include "GameController.h"
+#include "CardDatabase.h"
+#include "Random.h"
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace SevenWondersDuel {
+namespace Bench {
+
+    /**
+     * @brief 解析逗号分隔的线程数列表 (忽略非正数项)
+     */
+    inline std::vector<int> parseThreadList(const std::string& s) {
+        std::vector<int> out;
+        std::stringstream ss(s);
+        std::string item;
+        while (std::getline(ss, item, ',')) {
+            int t = std::atoi(item.c_str());
+            if (t > 0) out.push_back(t);
+        }
+        return out;
+    }
+
+    /**
+     * @brief 随机走若干步到达中盘局面
+     * 第 p 局的发牌种子为 SeedHierarchy::gameSeed(seed, p)，走子共用一条以 seed 初始化的随机流；
+     * 在 plies 步内结束的对局不计入结果。
+     */
+    inline std::vector<std::unique_ptr<GameController>> randomPositions(const std::shared_ptr<const CardDatabase>& database,
+                                                                        int count, int plies, std::uint64_t seed) {
+        std::vector<std::unique_ptr<GameController>> positions;
+        std::vector<LegalAction> legal;
+        Xoshiro256 rng(seed);
+        for (int p = 0; p < count; ++p) {
+            auto game = std::make_unique<GameController>();
+            game->setSeed(SeedHierarchy::gameSeed(seed, p));
+            game->initializeGame(database, "Player 1", "Player 2");
+            game->startGame();
+            for (int k = 0; k < plies && game->getState() != GameState::GAME_OVER; ++k) {
+                game->generateLegalActions(legal);
+                if (legal.empty()) break;
+                std::uniform_int_distribution<size_t> dist(0, legal.size() - 1);
+                game->processAction(legal[dist(rng)].action);
+            }
+            if (game->getState() != GameState::GAME_OVER) positions.push_back(std::move(game));
+        }
+        return positions;
+    }
+
+}
+}
+
+#endif // SEVEN_WONDERS_DUEL_BENCHCOMMON_H
@@ -0,0 +1,119 @@
+// Benchmark for AlphaBetaAgent and its shared transposition table.
+//
+// Reaches a set of seeded positions by random play, then runs one timed search
+// per position for every thread count in the list (Lazy SMP over one shared,
+// lock-free table). Reports nodes per second, the speed-up over one thread,
+// the average completed depth, the table hit rate and how often threads
+// overlapped on the same entry.
+
+#include "AlphaBeta.h"
+#include "BenchCommon.h"
+#include "GameController.h"
+#include "CardDatabase.h"
+#include "Random.h"
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+using namespace SevenWondersDuel;
+
+namespace {
+
+    struct BenchResult {
+        long long nodes = 0;
+        long long probes = 0;
+        long long hits = 0;
+        long long contention = 0;
+        long long depthSum = 0;
+        int hashfullMax = 0;
+        int searches = 0;
+        double seconds = 0.0;
+
+        double perSecond() const { return seconds > 0.0 ? nodes / seconds : 0.0; }
+    };
+
+    BenchResult runPositions(const std::vector<std::unique_ptr<GameController>>& positions, const AlphaBetaConfig& config, std::uint64_t seed) {
+        AlphaBetaAgent agent(config, false);
+        agent.setRandomStream(Xoshiro256(seed));
+
+        BenchResult result;
+        for (const auto& pos : positions) {
+            agent.search(*pos);
+            const AlphaBetaStats& stats = agent.getLastStats();
+            result.nodes += stats.nodes;
+            result.probes += stats.ttProbes;
+            result.hits += stats.ttHits;
+            result.contention += stats.ttContention;
+            result.depthSum += stats.depth;
+            result.hashfullMax = std::max(result.hashfullMax, stats.ttHashfull);
+            result.searches++;
+            result.seconds += stats.seconds;
+        }
+        return result;
+    }
+
+}
+
+int main(int argc, char* argv[]) {
+    std::string dataPath = "../data/gamedata.json";
+    int positionCount = 10;
+    double timeMs = 500.0;
+    int plies = 20;
+    size_t ttMB = 64;
+    std::uint64_t seed = 1;
+    std::vector<int> threadCounts = {1};
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (arg == "--data" && hasValue) dataPath = argv[++i];
+        else if (arg == "--positions" && hasValue) positionCount = std::atoi(argv[++i]);
+        else if (arg == "--time" && hasValue) timeMs = std::atof(argv[++i]);
+        else if (arg == "--plies" && hasValue) plies = std::atoi(argv[++i]);
+        else if (arg == "--tt-mb" && hasValue) ttMB = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--seed" && hasValue) seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--threads" && hasValue) threadCounts = Bench::parseThreadList(argv[++i]);
+        else {
+            std::cout << "Usage: " << argv[0]
+                      << " [--data <path>] [--positions <N>] [--time <ms>] [--plies <P>] [--tt-mb <MB>] [--seed <S>]\n"
+                      << "       [--threads <t1,t2,...>] (e.g. 1,2,4,8,16)\n";
+            return arg == "--help" || arg == "-h" ? 0 : 1;
+        }
+    }
+    if (threadCounts.empty() || timeMs <= 0.0) {
+        std::cerr << "--threads needs positive counts; --time must be positive.\n";
+        return 1;
+    }
+
+    std::shared_ptr<const CardDatabase> database = CardDatabase::load(dataPath);
+
+    // 随机走若干步到达中盘局面
+    std::vector<std::unique_ptr<GameController>> positions = Bench::randomPositions(database, positionCount, plies, seed);
+
+    std::cout << "AlphaBeta: " << positions.size() << " positions x " << timeMs << " ms (after " << plies << " random plies), "
+              << ttMB << " MB table\n";
+    std::cout << " Threads      Nodes/s   Speedup  Avg depth  TT hit %  Contention  Hashfull\n";
+
+    double baseline = 0.0;
+    for (int threads : threadCounts) {
+        AlphaBetaConfig config;
+        config.timeLimitMs = timeMs;
+        config.maxDepth = 64;
+        config.ttSizeMB = ttMB;
+        config.threads = threads;
+
+        BenchResult r = runPositions(positions, config, seed);
+        if (baseline == 0.0) baseline = r.perSecond();
+
+        std::cout << std::setw(8) << threads
+                  << std::fixed << std::setprecision(0) << std::setw(13) << r.perSecond()
+                  << std::setprecision(2) << std::setw(9) << (baseline > 0.0 ? r.perSecond() / baseline : 0.0) << "x"
+                  << std::setw(11) << (r.searches > 0 ? static_cast<double>(r.depthSum) / r.searches : 0.0)
+                  << std::setprecision(1) << std::setw(10) << (r.probes > 0 ? 100.0 * r.hits / r.probes : 0.0)
+                  << std::setw(12) << r.contention
+                  << std::setw(9) << r.hashfullMax / 10.0 << "%\n";
+    }
+    return 0;
+}
@@ -0,0 +1,201 @@
+// Micro-benchmark for Player::calculateCost.
+//
+// Builds late-game players with several "choose one" producers and compares the
+// current allocation-free solver against the previous map-copying recursive
+// solver (kept below as a reference). Results must be identical.
+
+#include "Player.h"
+#include "CardDatabase.h"
+#include "Random.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace SevenWondersDuel;
+
+namespace {
+
+    // ===== Reference implementation (pre-rewrite) =====
+
+    void legacySolveMinCost(std::map<ResourceType, int> needed, size_t choiceIdx,
+                            const std::vector<std::vector<ResourceType>>& choices,
+                            const Player& opponent, const Player& parent, int& minCost) {
+        if (choiceIdx == choices.size()) {
+            int currentTradingCost = 0;
+            for (auto const& [type, count] : needed) {
+                if (count > 0) currentTradingCost += count * parent.getTradingPrice(type, opponent);
+            }
+            if (currentTradingCost < minCost) minCost = currentTradingCost;
+            return;
+        }
+
+        bool usefulOptionFound = false;
+        for (ResourceType res : choices[choiceIdx]) {
+            if (needed[res] > 0) {
+                usefulOptionFound = true;
+                std::map<ResourceType, int> nextNeeded = needed;
+                nextNeeded[res]--;
+                legacySolveMinCost(nextNeeded, choiceIdx + 1, choices, opponent, parent, minCost);
+            }
+        }
+        if (!usefulOptionFound) legacySolveMinCost(needed, choiceIdx + 1, choices, opponent, parent, minCost);
+    }
+
+    std::pair<bool, int> legacyCalculateCost(const Player& self, const ResourceCost& cost, const Player& opponent, CardType targetType) {
+        if (cost.getResources().empty()) return { self.getCoins() >= cost.getCoins(), cost.getCoins() };
+
+        std::map<ResourceType, int> deficit = cost.getResources();
+        for (auto it = deficit.begin(); it != deficit.end(); ) {
+            int owned = self.getFixedResource(it->first);
+            if (owned >= it->second) it = deficit.erase(it);
+            else { it->second -= owned; ++it; }
+        }
+
+        int discountCount = 0;
+        if (self.hasProgressToken(ProgressToken::MASONRY) && targetType == CardType::CIVILIAN) discountCount = Config::MASONRY_DISCOUNT;
+        else if (self.hasProgressToken(ProgressToken::ARCHITECTURE) && targetType == CardType::WONDER) discountCount = Config::ARCHITECTURE_DISCOUNT;
+
+        while (discountCount > 0 && !deficit.empty()) {
+            ResourceType bestToDiscount = ResourceType::WOOD;
+            int maxPrice = -1;
+            bool found = false;
+            for (auto const& [type, count] : deficit) {
+                if (count > 0) {
+                    int price = self.getTradingPrice(type, opponent);
+                    if (price > maxPrice) { maxPrice = price; bestToDiscount = type; found = true; }
+                }
+            }
+            if (!found) break;
+            if (--deficit[bestToDiscount] <= 0) deficit.erase(bestToDiscount);
+            discountCount--;
+        }
+
+        if (deficit.empty()) return { self.getCoins() >= cost.getCoins(), cost.getCoins() };
+
+        std::vector<std::vector<ResourceType>> choices;
+        for (int c = 0; c < self.getChoiceResourceCount(); ++c) {
+            choices.emplace_back();
+            for (int r = 0; r < 5; ++r) {
+                if (self.getChoiceResourceMask(c) & (1u << r)) choices.back().push_back(static_cast<ResourceType>(r));
+            }
+        }
+
+        int minTradingCost = std::numeric_limits<int>::max();
+        legacySolveMinCost(deficit, 0, choices, opponent, self, minTradingCost);
+        int totalRequired = cost.getCoins() + minTradingCost;
+        return { self.getCoins() >= totalRequired, totalRequired };
+    }
+
+    // ===== Scenario generation =====
+
+    const std::vector<std::vector<ResourceType>> kChoiceProducers = {
+        {ResourceType::WOOD, ResourceType::STONE, ResourceType::CLAY},   // Caravansery / Great Lighthouse
+        {ResourceType::PAPER, ResourceType::GLASS},                      // Forum / Piraeus
+        {ResourceType::WOOD, ResourceType::STONE, ResourceType::CLAY},
+        {ResourceType::PAPER, ResourceType::GLASS},
+    };
+
+    struct Scenario {
+        Player self{0, "Self"};
+        Player opponent{1, "Opponent"};
+    };
+
+    Scenario makeLateGamePlayer(Xoshiro256& rng) {
+        Scenario s;
+        std::uniform_int_distribution<int> small(0, 2);
+        std::uniform_int_distribution<int> coin(0, 1);
+
+        for (int t = 0; t < 5; ++t) {
+            auto r = static_cast<ResourceType>(t);
+            s.self.addResource(r, small(rng), true);
+            s.opponent.addResource(r, small(rng), true);
+            if (coin(rng) && coin(rng)) s.self.setTradingDiscount(r, true);
+        }
+
+        // 3-4 个多选一产出
+        int producers = 3 + coin(rng);
+        for (int i = 0; i < producers; ++i) s.self.addProductionChoice(kChoiceProducers[i]);
+
+        if (coin(rng)) s.self.addProgressToken(ProgressToken::MASONRY);
+        if (coin(rng)) s.self.addProgressToken(ProgressToken::ARCHITECTURE);
+        s.self.gainCoins(small(rng) * 5);
+        return s;
+    }
+
+    struct Target {
+        const ResourceCost* cost;
+        CardType type;
+    };
+
+}
+
+int main(int argc, char* argv[]) {
+    std::string dataPath = "../data/gamedata.json";
+    int players = 200;
+    int rounds = 50;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (arg == "--data" && hasValue) dataPath = argv[++i];
+        else if (arg == "--players" && hasValue) players = std::atoi(argv[++i]);
+        else if (arg == "--rounds" && hasValue) rounds = std::atoi(argv[++i]);
+        else {
+            std::cout << "Usage: " << argv[0] << " [--data <path>] [--players <N>] [--rounds <R>]\n";
+            return arg == "--help" || arg == "-h" ? 0 : 1;
+        }
+    }
+
+    auto database = CardDatabase::load(dataPath);
+
+    std::vector<Target> targets;
+    for (const auto& c : database->getCards()) {
+        if (!c.getCost().getResources().empty()) targets.push_back({&c.getCost(), c.getType()});
+    }
+    for (const auto& w : database->getWonders()) targets.push_back({&w.getCost(), CardType::WONDER});
+
+    Xoshiro256 rng(2024);
+    std::vector<Scenario> scenarios;
+    scenarios.reserve(players);
+    for (int i = 0; i < players; ++i) scenarios.push_back(makeLateGamePlayer(rng));
+
+    // 正确性：两种实现逐项比对
+    long long mismatches = 0;
+    for (const auto& s : scenarios) {
+        for (const auto& t : targets) {
+            if (s.self.calculateCost(*t.cost, s.opponent, t.type) != legacyCalculateCost(s.self, *t.cost, s.opponent, t.type)) mismatches++;
+        }
+    }
+
+    long long calls = static_cast<long long>(rounds) * scenarios.size() * targets.size();
+    long long sink = 0;
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r)
+        for (const auto& s : scenarios)
+            for (const auto& t : targets) sink += legacyCalculateCost(s.self, *t.cost, s.opponent, t.type).second;
+    auto t1 = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r)
+        for (const auto& s : scenarios)
+            for (const auto& t : targets) sink += s.self.calculateCost(*t.cost, s.opponent, t.type).second;
+    auto t2 = std::chrono::steady_clock::now();
+
+    double legacyNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / calls;
+    double currentNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / calls;
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "calculateCost: " << calls << " calls per solver (" << scenarios.size() << " players x "
+              << targets.size() << " costs x " << rounds << " rounds)\n";
+    std::cout << "  map/recursive solver : " << legacyNs << " ns/call\n";
+    std::cout << "  array/bitmask solver : " << currentNs << " ns/call\n";
+    std::cout << "  speedup              : " << std::setprecision(2) << legacyNs / currentNs << "x\n";
+    std::cout << "  mismatches           : " << mismatches << "  (checksum " << sink << ")\n";
+
+    return mismatches == 0 ? 0 : 1;
+}
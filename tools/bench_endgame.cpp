@@ -0,0 +1,117 @@
+// Benchmark for the exact Age 3 endgame solver.
+//
+// Plays seeded random games until the Age 3 pyramid holds exactly N cards, then
+// solves each position from an empty memo. For every N the average / maximum
+// solve time, nodes and memo hits are reported, and the largest N whose slowest
+// position still fits the budget is printed (the "exact below N cards" cutoff),
+// along with the share of positions of each size that are solved within it.
+
+#include "EndgameSolver.h"
+#include "GameController.h"
+#include "CardDatabase.h"
+#include "Random.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace SevenWondersDuel;
+
+namespace {
+
+    /**
+     * @brief 随机走子到第三时代金字塔恰剩 cards 张卡的局面；中途分出胜负时返回 nullptr
+     */
+    std::unique_ptr<GameController> reachEndgame(const std::shared_ptr<const CardDatabase>& database, std::uint64_t seed, int index, int cards) {
+        auto game = std::make_unique<GameController>();
+        game->setSeed(SeedHierarchy::gameSeed(seed, index));
+        game->initializeGame(database, "Player 1", "Player 2");
+        game->startGame();
+
+        Xoshiro256 rng(SeedHierarchy::gameSeed(seed ^ 0x5EED, index));
+        std::vector<LegalAction> legal;
+        while (game->getState() != GameState::GAME_OVER) {
+            if (EndgameSolver::isApplicable(*game, cards)) return game;
+            game->generateLegalActions(legal);
+            if (legal.empty()) break;
+            std::uniform_int_distribution<size_t> dist(0, legal.size() - 1);
+            game->processAction(legal[dist(rng)].action);
+        }
+        return nullptr;
+    }
+
+}
+
+int main(int argc, char* argv[]) {
+    std::string dataPath = "../data/gamedata.json";
+    int positionCount = 20;
+    int minCards = 2;
+    int maxCards = 12;
+    double budgetMs = 100.0;
+    double capMs = 5000.0;
+    std::uint64_t seed = 1;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (arg == "--data" && hasValue) dataPath = argv[++i];
+        else if (arg == "--positions" && hasValue) positionCount = std::atoi(argv[++i]);
+        else if (arg == "--min-cards" && hasValue) minCards = std::atoi(argv[++i]);
+        else if (arg == "--max-cards" && hasValue) maxCards = std::atoi(argv[++i]);
+        else if (arg == "--budget" && hasValue) budgetMs = std::atof(argv[++i]);
+        else if (arg == "--cap" && hasValue) capMs = std::atof(argv[++i]);
+        else if (arg == "--seed" && hasValue) seed = std::strtoull(argv[++i], nullptr, 10);
+        else {
+            std::cout << "Usage: " << argv[0]
+                      << " [--data <path>] [--positions <N>] [--min-cards <A>] [--max-cards <B>]\n"
+                      << "       [--budget <ms>] (cutoff criterion, default 100) [--cap <ms>] (per-solve abort, default 5000) [--seed <S>]\n";
+            return arg == "--help" || arg == "-h" ? 0 : 1;
+        }
+    }
+
+    std::shared_ptr<const CardDatabase> database = CardDatabase::load(dataPath);
+
+    std::cout << "Endgame solver: " << positionCount << " positions per size, budget " << budgetMs << " ms\n";
+    std::cout << " Cards  Solved  In budget    Avg ms    Max ms     Avg nodes  Memo hits\n";
+
+    minCards = std::max(1, minCards);
+    int cutoff = minCards - 1;
+    EndgameSolver solver(capMs);
+    for (int cards = minCards; cards <= maxCards; ++cards) {
+        int solved = 0, attempted = 0, inBudget = 0;
+        double totalMs = 0.0, worstMs = 0.0;
+        long long nodes = 0, hits = 0;
+
+        for (int p = 0; attempted < positionCount && p < positionCount * 4; ++p) {
+            auto game = reachEndgame(database, seed, p, cards);
+            if (!game) continue;
+            attempted++;
+
+            solver.clearMemo();
+            EndgameResult r = solver.solve(*game);
+            double ms = 1000.0 * r.seconds;
+            totalMs += ms;
+            worstMs = std::max(worstMs, ms);
+            nodes += r.nodes;
+            hits += r.memoHits;
+            if (r.solved) solved++;
+            if (r.solved && ms <= budgetMs) inBudget++;
+        }
+        if (attempted == 0) continue;
+
+        std::cout << std::setw(6) << cards << std::setw(5) << solved << "/" << std::left << std::setw(3) << attempted << std::right
+                  << std::fixed << std::setprecision(1) << std::setw(10) << 100.0 * inBudget / attempted << "%"
+                  << std::setprecision(2) << std::setw(10) << totalMs / attempted << std::setw(10) << worstMs
+                  << std::setw(14) << nodes / attempted << std::setw(11) << hits / attempted << "\n";
+
+        bool fits = solved == attempted && worstMs <= budgetMs;
+        if (fits && cutoff == cards - 1) cutoff = cards;
+        if (solved < attempted) break;   // 更大的规模只会更慢
+    }
+
+    std::cout << "Exact solving with <= " << cutoff << " cards left fits the " << budgetMs << " ms budget on every sampled position\n";
+    return 0;
+}
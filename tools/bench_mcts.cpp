@@ -0,0 +1,110 @@
+// Benchmark for MCTSAgent search speed.
+//
+// Reaches a set of seeded positions by random play, then runs one search per
+// position with a fixed iteration budget and reports playouts (iterations) per
+// second. With a thread list, every thread count is measured for root and/or
+// tree parallelism and the speed-up over one thread is printed.
+
+#include "MCTS.h"
+#include "BenchCommon.h"
+#include "GameController.h"
+#include "CardDatabase.h"
+#include "Random.h"
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+using namespace SevenWondersDuel;
+
+namespace {
+
+    struct BenchResult {
+        long long iterations = 0;
+        long long nodes = 0;
+        double seconds = 0.0;
+
+        double perSecond() const { return seconds > 0.0 ? iterations / seconds : 0.0; }
+    };
+
+    BenchResult runPositions(const std::vector<std::unique_ptr<GameController>>& positions, const MCTSConfig& config, std::uint64_t seed) {
+        MCTSAgent agent(config, false);
+        agent.setRandomStream(Xoshiro256(seed));
+
+        BenchResult result;
+        for (const auto& pos : positions) {
+            agent.search(*pos);
+            const MCTSStats& stats = agent.getLastStats();
+            result.iterations += stats.iterations;
+            result.nodes += stats.nodes;
+            result.seconds += stats.seconds;
+        }
+        return result;
+    }
+
+}
+
+int main(int argc, char* argv[]) {
+    std::string dataPath = "../data/gamedata.json";
+    int positionCount = 20;
+    int iterations = 5000;
+    int plies = 20;
+    std::uint64_t seed = 1;
+    std::vector<int> threadCounts = {1};
+    std::string mode = "both";
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (arg == "--data" && hasValue) dataPath = argv[++i];
+        else if (arg == "--positions" && hasValue) positionCount = std::atoi(argv[++i]);
+        else if (arg == "--iterations" && hasValue) iterations = std::atoi(argv[++i]);
+        else if (arg == "--plies" && hasValue) plies = std::atoi(argv[++i]);
+        else if (arg == "--seed" && hasValue) seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--threads" && hasValue) threadCounts = Bench::parseThreadList(argv[++i]);
+        else if (arg == "--mode" && hasValue) mode = argv[++i];
+        else {
+            std::cout << "Usage: " << argv[0]
+                      << " [--data <path>] [--positions <N>] [--iterations <I>] [--plies <P>] [--seed <S>]\n"
+                      << "       [--threads <t1,t2,...>] (e.g. 1,2,4,8,16,32,64) [--mode root|tree|both]\n";
+            return arg == "--help" || arg == "-h" ? 0 : 1;
+        }
+    }
+    if (threadCounts.empty() || (mode != "root" && mode != "tree" && mode != "both")) {
+        std::cerr << "--threads needs positive counts; --mode must be root, tree or both.\n";
+        return 1;
+    }
+
+    std::shared_ptr<const CardDatabase> database = CardDatabase::load(dataPath);
+
+    // 随机走若干步到达中盘局面
+    std::vector<std::unique_ptr<GameController>> positions = Bench::randomPositions(database, positionCount, plies, seed);
+
+    std::cout << "MCTS: " << positions.size() << " positions x " << iterations << " iterations (after " << plies << " random plies)\n";
+    std::cout << " Mode  Threads   Playouts/s   Speedup      Nodes\n";
+
+    std::vector<std::pair<std::string, MCTSParallelMode>> modes;
+    if (mode != "tree") modes.push_back({"root", MCTSParallelMode::ROOT});
+    if (mode != "root") modes.push_back({"tree", MCTSParallelMode::TREE});
+
+    for (const auto& [name, parallelMode] : modes) {
+        double baseline = 0.0;
+        for (int threads : threadCounts) {
+            MCTSConfig config;
+            config.iterations = iterations;
+            config.threads = threads;
+            config.parallelMode = parallelMode;
+
+            BenchResult r = runPositions(positions, config, seed);
+            if (baseline == 0.0) baseline = r.perSecond();
+
+            std::cout << " " << std::left << std::setw(5) << name << std::right
+                      << std::setw(8) << threads
+                      << std::fixed << std::setprecision(1) << std::setw(13) << r.perSecond()
+                      << std::setprecision(2) << std::setw(9) << (baseline > 0.0 ? r.perSecond() / baseline : 0.0) << "x"
+                      << std::setw(11) << r.nodes << "\n";
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,148 @@
+// Round-trip check and benchmark for the 128-byte packed game state.
+//
+// Plays seeded random games and, at every position, packs the state, unpacks it
+// into a second controller and checks that both are the same position: equal
+// Zobrist hash, equal scores, the same legal actions with the same costs, and a
+// re-pack that reproduces the original bytes. Then times pack and unpack over
+// all collected positions. Exits non-zero on any mismatch.
+
+#include "PackedState.h"
+#include "GameController.h"
+#include "CardDatabase.h"
+#include "Random.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace SevenWondersDuel;
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<std::tuple<int, int, int, int, bool, int>> actionKeys(const GameController& game, std::vector<LegalAction>& buffer) {
+        game.generateLegalActions(buffer);
+        std::vector<std::tuple<int, int, int, int, bool, int>> keys;
+        keys.reserve(buffer.size());
+        for (const LegalAction& la : buffer) {
+            const Action& a = la.action;
+            keys.emplace_back(static_cast<int>(a.type), a.targetCard, a.targetWonder, static_cast<int>(a.selectedToken), a.chooseSelf, la.cost);
+        }
+        std::sort(keys.begin(), keys.end());
+        return keys;
+    }
+
+    /**
+     * @brief 比较两个控制器是否为同一局面，返回第一处差异 (相同时为空串)
+     */
+    std::string compare(const GameController& a, const GameController& b, std::vector<LegalAction>& buffer) {
+        if (a.getStateHash() != b.getStateHash()) return "state hash";
+        if (a.getState() != b.getState()) return "game state";
+        const GameModel& ma = a.getModel();
+        const GameModel& mb = b.getModel();
+        if (ma.getWinnerIndex() != mb.getWinnerIndex() || ma.getVictoryType() != mb.getVictoryType()) return "winner";
+        for (int id = 0; id < 2; ++id) {
+            const Player& pa = *ma.getPlayers()[id];
+            const Player& pb = *mb.getPlayers()[id];
+            if (pa.getScore(*ma.getPlayers()[1 - id]) != pb.getScore(*mb.getPlayers()[1 - id])) return "score";
+            if (pa.getDistinctScienceSymbolCount() != pb.getDistinctScienceSymbolCount()) return "science symbols";
+        }
+        if (actionKeys(a, buffer) != actionKeys(b, buffer)) return "legal actions";
+        return "";
+    }
+
+}
+
+int main(int argc, char* argv[]) {
+    std::string dataPath = "../data/gamedata.json";
+    int games = 200;
+    int rounds = 20;
+    std::uint64_t seed = 1;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (arg == "--data" && hasValue) dataPath = argv[++i];
+        else if (arg == "--games" && hasValue) games = std::atoi(argv[++i]);
+        else if (arg == "--rounds" && hasValue) rounds = std::atoi(argv[++i]);
+        else if (arg == "--seed" && hasValue) seed = std::strtoull(argv[++i], nullptr, 10);
+        else {
+            std::cout << "Usage: " << argv[0] << " [--data <path>] [--games <N>] [--rounds <R>] [--seed <S>]\n";
+            return arg == "--help" || arg == "-h" ? 0 : 1;
+        }
+    }
+
+    std::shared_ptr<const CardDatabase> database = CardDatabase::load(dataPath);
+
+    GameController restored;
+    restored.initializeGame(database, "Player 1", "Player 2");
+
+    std::vector<PackedState> corpus;
+    std::vector<LegalAction> legal, buffer;
+    Xoshiro256 rng(seed);
+    int mismatches = 0;
+
+    for (int g = 0; g < games; ++g) {
+        GameController game;
+        game.setSeed(SeedHierarchy::gameSeed(seed, g));
+        game.initializeGame(database, "Player 1", "Player 2");
+        game.startGame();
+
+        while (true) {
+            PackedState packed;
+            if (!StatePacker::pack(game, packed)) {
+                std::cerr << "game " << g << ": pack failed\n";
+                return 1;
+            }
+            std::string diff;
+            PackedState repacked;
+            if (!StatePacker::unpack(packed, restored)) diff = "unpack rejected";
+            else if (!(diff = compare(game, restored, buffer)).empty()) {}
+            else if (!StatePacker::pack(restored, repacked) || repacked != packed) diff = "re-pack";
+            if (!diff.empty()) {
+                if (mismatches++ < 10) std::cerr << "game " << g << ", position " << corpus.size() << ": mismatch in " << diff << "\n";
+            }
+            corpus.push_back(packed);
+
+            if (game.getState() == GameState::GAME_OVER) break;
+            game.generateLegalActions(legal);
+            if (legal.empty()) break;
+            std::uniform_int_distribution<size_t> dist(0, legal.size() - 1);
+            game.processAction(legal[dist(rng)].action);
+        }
+    }
+
+    std::cout << "PackedState: " << sizeof(PackedState) << " bytes (" << StatePacker::usedBits() << " bits used), "
+              << corpus.size() << " positions from " << games << " games, "
+              << mismatches << " round-trip mismatches\n";
+
+    // 吞吐量：对全部局面反复解码 / 编码
+    std::vector<PackedState> out(corpus.size());
+    auto start = Clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        for (const PackedState& p : corpus) StatePacker::unpack(p, restored);
+    }
+    double unpackSec = std::chrono::duration<double>(Clock::now() - start).count();
+
+    GameController source;
+    source.initializeGame(database, "Player 1", "Player 2");
+    StatePacker::unpack(corpus.back(), source);
+    start = Clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        for (size_t i = 0; i < corpus.size(); ++i) StatePacker::pack(source, out[i]);
+    }
+    double packSec = std::chrono::duration<double>(Clock::now() - start).count();
+
+    double ops = static_cast<double>(corpus.size()) * rounds;
+    std::cout << std::fixed << std::setprecision(1)
+              << "  pack:   " << std::setw(8) << 1e9 * packSec / ops << " ns/position\n"
+              << "  unpack: " << std::setw(8) << 1e9 * unpackSec / ops << " ns/position\n"
+              << "  memory: " << std::setw(8) << corpus.size() * sizeof(PackedState) / 1024.0 << " KB for the corpus\n";
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,260 @@
+// Correctness check and benchmark for make/unmake (processAction + undo).
+//
+// Plays seeded random games with undo enabled. At every position it tries every
+// legal action, undoes it and checks that the controller is back at the same
+// position: identical fingerprint of every observable piece of state (players,
+// pyramid, discard pile, tokens, wonder deal, scores, log length) and identical
+// legal action list. At game end the whole game is unwound and compared with the
+// starting position. Then times make/unmake against the copy-then-make approach
+// (copyFrom + processAction) over the same positions with logging disabled, and
+// counts heap allocations (global operator new) in a second make/unmake pass at
+// every position, once the undo stack has reached that depth. Exits non-zero on
+// any mismatch or any such allocation.
+
+#include "GameController.h"
+#include "CardDatabase.h"
+#include "ScoringManager.h"
+#include "Random.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace SevenWondersDuel;
+
+// 统计全局 operator new 的调用次数 (本工具单线程)
+static long long g_allocations = 0;
+
+void* operator new(std::size_t size) {
+    ++g_allocations;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    template <typename Container>
+    void writeIds(std::ostream& os, const char* name, const Container& items) {
+        os << name << ':';
+        for (auto item : items) os << item->getId() << ',';
+        os << '\n';
+    }
+
+    /**
+     * @brief 把撤销后应与执行前完全一致的全部可观察状态写成文本
+     */
+    std::string fingerprint(const GameController& game, std::vector<LegalAction>& buffer) {
+        std::ostringstream os;
+        const GameModel& model = game.getModel();
+        const Board& board = *model.getBoard();
+        os << "state " << static_cast<int>(game.getState()) << " age " << model.getCurrentAge()
+           << " player " << model.getCurrentPlayerIndex() << " winner " << model.getWinnerIndex()
+           << " victory " << static_cast<int>(model.getVictoryType()) << " log " << model.getGameLog().size() << '\n';
+        writeIds(os, "draft", model.getDraftPool());
+        writeIds(os, "remaining", model.getRemainingWonders());
+
+        for (int id = 0; id < 2; ++id) {
+            const Player& p = *model.getPlayers()[id];
+            const Player& opp = *model.getPlayers()[1 - id];
+            os << "P" << id << " coins " << p.getCoins() << " score " << ScoringManager::calculateScore(p, opp, board) << '\n';
+            writeIds(os, "built", p.getAllCards());
+            writeIds(os, "wonders", p.getBuiltWonders());
+            os << "overlays:";
+            for (int i = 0; i < static_cast<int>(p.getBuiltWonders().size()); ++i) os << p.getWonderOverlay(i)->getId() << ',';
+            os << '\n';
+            writeIds(os, "unbuilt", p.getUnbuiltWonders());
+            os << "resources:";
+            for (int r = 0; r < 5; ++r) {
+                ResourceType type = static_cast<ResourceType>(r);
+                os << p.getFixedResource(type) << '/' << p.getPublicProduction(type) << '/' << p.hasTradingDiscount(type) << ',';
+            }
+            os << "\nscience:";
+            for (int s = 0; s < 8; ++s) os << p.getScienceSymbolCount(static_cast<ScienceSymbol>(s)) << ',';
+            // 多选一产能的顺序不影响规则 (购买时对全部组合求最优)
+            std::vector<int> choices;
+            for (int i = 0; i < p.getChoiceResourceCount(); ++i) choices.push_back(p.getChoiceResourceMask(i));
+            std::sort(choices.begin(), choices.end());
+            os << "\nchoices:";
+            for (int c : choices) os << c << ',';
+            os << "\npairs " << static_cast<int>(p.getClaimedSciencePairMask()) << " tags " << p.getOwnedChainTagMask()
+               << " tokens " << p.getProgressTokenMask() << '\n';
+        }
+
+        const MilitaryTrack& track = board.getMilitaryTrack();
+        os << "military " << track.getPosition() << " loot";
+        for (int i = 0; i < 4; ++i) os << ' ' << track.getLootTokens()[i];
+        os << "\npyramid:";
+        const CardPyramid& pyramid = board.getCardStructure();
+        for (int i = 0; i < pyramid.getSlotCount(); ++i) {
+            os << pyramid.getSlot(i).getCardPtr()->getId() << '/' << pyramid.isRemoved(i) << pyramid.isFaceUp(i)
+               << pyramid.isExposed(i) << ',';
+        }
+        os << '\n';
+        writeIds(os, "discard", board.getDiscardPile());
+        os << "available:";
+        for (ProgressToken t : board.getAvailableProgressTokens()) os << static_cast<int>(t) << ',';
+        os << " box:";
+        for (ProgressToken t : board.getBoxProgressTokens()) os << static_cast<int>(t) << ',';
+
+        os << "\nactions:";
+        game.generateLegalActions(buffer);
+        for (const LegalAction& la : buffer) {
+            const Action& a = la.action;
+            os << static_cast<int>(a.type) << '/' << static_cast<int>(a.targetCard) << '/' << static_cast<int>(a.targetWonder) << '/'
+               << static_cast<int>(a.selectedToken) << '/' << a.chooseSelf << '/' << la.cost << ',';
+        }
+        return os.str();
+    }
+
+    /**
+     * @brief 返回第一处不同的行 (相同时为空串)
+     */
+    std::string compare(const std::string& a, const std::string& b) {
+        if (a == b) return "";
+        std::istringstream sa(a), sb(b);
+        std::string la, lb;
+        while (std::getline(sa, la) && std::getline(sb, lb)) {
+            if (la != lb) return la.substr(0, la.find_first_of(": "));
+        }
+        return "line count";
+    }
+
+}
+
+int main(int argc, char* argv[]) {
+    std::string dataPath = "../data/gamedata.json";
+    int games = 200;
+    std::uint64_t seed = 1;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (arg == "--data" && hasValue) dataPath = argv[++i];
+        else if (arg == "--games" && hasValue) games = std::atoi(argv[++i]);
+        else if (arg == "--seed" && hasValue) seed = std::strtoull(argv[++i], nullptr, 10);
+        else {
+            std::cout << "Usage: " << argv[0] << " [--data <path>] [--games <N>] [--seed <S>]\n";
+            return arg == "--help" || arg == "-h" ? 0 : 1;
+        }
+    }
+
+    std::shared_ptr<const CardDatabase> database = CardDatabase::load(dataPath);
+
+    std::vector<LegalAction> legal, buffer;
+    int mismatches = 0;
+    long long checked = 0;
+    auto report = [&](int g, int ply, const std::string& what) {
+        if (mismatches++ < 10) std::cerr << "game " << g << ", ply " << ply << ": mismatch in " << what << "\n";
+    };
+
+    // 正确性：每个局面的每个合法动作都执行并撤销
+    Xoshiro256 rng(seed);
+    for (int g = 0; g < games; ++g) {
+        GameController game;
+        game.setSeed(SeedHierarchy::gameSeed(seed, g));
+        game.initializeGame(database, "Player 1", "Player 2");
+        game.startGame();
+        game.setUndoEnabled(true);
+        std::string start = fingerprint(game, buffer);
+
+        int ply = 0;
+        while (game.getState() != GameState::GAME_OVER) {
+            game.generateLegalActions(legal);
+            if (legal.empty()) break;
+            std::string before = fingerprint(game, buffer);
+            for (const LegalAction& la : legal) {
+                if (!game.processAction(la.action) || !game.undo()) {
+                    report(g, ply, "make/unmake failed");
+                    continue;
+                }
+                std::string diff = compare(before, fingerprint(game, buffer));
+                if (!diff.empty()) report(g, ply, diff);
+                ++checked;
+            }
+            std::uniform_int_distribution<size_t> dist(0, legal.size() - 1);
+            game.processAction(legal[dist(rng)].action);
+            ++ply;
+        }
+
+        while (game.undo()) {}
+        std::string diff = compare(start, fingerprint(game, buffer));
+        if (!diff.empty()) report(g, ply, "full unwind: " + diff);
+    }
+
+    std::cout << "UndoRecord: " << sizeof(UndoRecord) << " bytes, GameController copy vs delta\n"
+              << "  " << checked << " make/unmake pairs from " << games << " games, "
+              << mismatches << " mismatches\n";
+
+    // 吞吐量：同一批局面上的 copyFrom + processAction 与 processAction + undo
+    double copySec = 0.0, copyMakeSec = 0.0, makeUnmakeSec = 0.0;
+    long long ops = 0, allocations = 0;
+    GameController source;
+    source.initializeGame(database, "Player 1", "Player 2");
+    std::unique_ptr<GameController> scratchClone = source.clone();
+    GameController& scratch = *scratchClone;
+    rng = Xoshiro256(seed);
+    for (int g = 0; g < games; ++g) {
+        GameController original;
+        original.setSeed(SeedHierarchy::gameSeed(seed, g));
+        original.initializeGame(database, "Player 1", "Player 2");
+        original.startGame();
+        std::unique_ptr<GameController> clone = original.clone(); // 克隆关闭了日志
+        GameController& game = *clone;
+        game.setUndoEnabled(true);
+
+        while (game.getState() != GameState::GAME_OVER) {
+            game.generateLegalActions(legal);
+            if (legal.empty()) break;
+
+            auto t0 = Clock::now();
+            for (size_t i = 0; i < legal.size(); ++i) scratch.copyFrom(game);
+            auto t1 = Clock::now();
+            for (const LegalAction& la : legal) {
+                scratch.copyFrom(game);
+                scratch.processAction(la.action);
+            }
+            auto t2 = Clock::now();
+            for (const LegalAction& la : legal) {
+                game.processAction(la.action);
+                game.undo();
+            }
+            auto t3 = Clock::now();
+            // 撤销栈已达到本层深度：再执行一遍并统计堆分配
+            long long allocBefore = g_allocations;
+            for (const LegalAction& la : legal) {
+                game.processAction(la.action);
+                game.undo();
+            }
+            allocations += g_allocations - allocBefore;
+            copySec += std::chrono::duration<double>(t1 - t0).count();
+            copyMakeSec += std::chrono::duration<double>(t2 - t1).count();
+            makeUnmakeSec += std::chrono::duration<double>(t3 - t2).count();
+            ops += static_cast<long long>(legal.size());
+
+            std::uniform_int_distribution<size_t> dist(0, legal.size() - 1);
+            game.processAction(legal[dist(rng)].action);
+        }
+    }
+
+    // make 的开销 = (copyFrom + make) - copyFrom，unmake 的开销 = (make + unmake) - make
+    double makeSec = copyMakeSec - copySec;
+    double unmakeSec = makeUnmakeSec - makeSec;
+    std::cout << std::fixed << std::setprecision(1)
+              << "  copyFrom:        " << std::setw(8) << 1e9 * copySec / ops << " ns/action\n"
+              << "  unmake:          " << std::setw(8) << 1e9 * unmakeSec / ops << " ns/action\n"
+              << "  copyFrom + make: " << std::setw(8) << 1e9 * copyMakeSec / ops << " ns/action\n"
+              << "  make + unmake:   " << std::setw(8) << 1e9 * makeUnmakeSec / ops << " ns/action\n"
+              << "  heap allocations in make + unmake: " << allocations << " over " << ops << " actions\n";
+    return mismatches == 0 && allocations == 0 ? 0 : 1;
+}
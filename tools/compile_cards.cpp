@@ -0,0 +1,144 @@
+// Offline compiler for the binary card database image.
+//
+// Compiles gamedata.json into the flat image read by CardDatabase::load
+// (default output: the .json path with a .bin extension), then loads the image
+// back and checks that it yields the same cards, wonders, effects, chain tags
+// and progress tokens as the JSON. Finally times both load paths. The image
+// stores a checksum of the JSON, so an out-of-date image is detected and the
+// JSON is used until the compiler is run again. Exits non-zero on any error or
+// mismatch.
+
+#include "CardImage.h"
+#include "CardDatabase.h"
+#include "GameFactory.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+using namespace SevenWondersDuel;
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    template <typename Item>
+    std::string compareCommon(const Item& a, const Item& b) {
+        if (a.getId() != b.getId() || a.getName() != b.getName()) return "id / name";
+        if (a.getCost().getCoins() != b.getCost().getCoins() || a.getCost().getResources() != b.getCost().getResources()) return "cost";
+        if (a.getStaticVictoryPoints() != b.getStaticVictoryPoints()) return "victory points";
+        if (a.getEffects().size() != b.getEffects().size()) return "effect count";
+        for (size_t i = 0; i < a.getEffects().size(); ++i) {
+            const IEffect& ea = *a.getEffects()[i];
+            const IEffect& eb = *b.getEffects()[i];
+            if (typeid(ea) != typeid(eb) || ea.getDescription() != eb.getDescription() || ea.isScoreStatic() != eb.isScoreStatic()) {
+                return "effect " + std::to_string(i);
+            }
+        }
+        return "";
+    }
+
+    /**
+     * @brief 比较两个数据库，返回第一处差异 (相同时为空串)
+     */
+    std::string compare(const CardDatabase& a, const CardDatabase& b) {
+        if (a.getCards().size() != b.getCards().size()) return "card count";
+        if (a.getWonders().size() != b.getWonders().size()) return "wonder count";
+        if (a.getProgressTokens() != b.getProgressTokens()) return "progress tokens";
+        for (size_t i = 0; i < a.getCards().size(); ++i) {
+            const Card& ca = a.getCards()[i];
+            const Card& cb = b.getCards()[i];
+            std::string diff = compareCommon(ca, cb);
+            if (diff.empty() && (ca.getAge() != cb.getAge() || ca.getType() != cb.getType())) diff = "age / type";
+            if (diff.empty() && (ca.getChainTag() != cb.getChainTag() || ca.getRequiresChainTag() != cb.getRequiresChainTag() ||
+                                 ca.getChainBit() != cb.getChainBit() || ca.getRequiresChainBit() != cb.getRequiresChainBit())) {
+                diff = "chain tags";
+            }
+            if (!diff.empty()) return "card " + ca.getId() + ": " + diff;
+        }
+        for (size_t i = 0; i < a.getWonders().size(); ++i) {
+            std::string diff = compareCommon(a.getWonders()[i], b.getWonders()[i]);
+            if (!diff.empty()) return "wonder " + a.getWonders()[i].getId() + ": " + diff;
+        }
+        return "";
+    }
+
+    template <typename Load>
+    double timeLoads(int rounds, Load load) {
+        auto start = Clock::now();
+        for (int r = 0; r < rounds; ++r) {
+            if (!load()) return -1.0;
+        }
+        return std::chrono::duration<double, std::micro>(Clock::now() - start).count() / rounds;
+    }
+
+}
+
+int main(int argc, char* argv[]) {
+    std::string dataPath = "../data/gamedata.json";
+    std::string outPath;
+    int rounds = 200;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (arg == "--data" && hasValue) dataPath = argv[++i];
+        else if (arg == "--out" && hasValue) outPath = argv[++i];
+        else if (arg == "--rounds" && hasValue) rounds = std::max(1, std::atoi(argv[++i]));
+        else {
+            std::cout << "Usage: " << argv[0] << " [--data <gamedata.json>] [--out <image>] [--rounds <R>]\n";
+            return arg == "--help" || arg == "-h" ? 0 : 1;
+        }
+    }
+    if (outPath.empty()) outPath = CardImageFormat::imagePathFor(dataPath);
+
+    std::uint64_t checksum = 0;
+    if (!CardImageFormat::checksumFile(dataPath, checksum)) {
+        std::cerr << "Cannot read " << dataPath << "\n";
+        return 1;
+    }
+
+    std::vector<std::uint8_t> image;
+    BaseGameFactory factory(dataPath);
+    if (!factory.compileImage(checksum, image)) {
+        std::cerr << "Card data exceeds the image format limits\n";
+        return 1;
+    }
+    {
+        std::ofstream out(outPath, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()));
+        if (!out.good()) {
+            std::cerr << "Cannot write " << outPath << "\n";
+            return 1;
+        }
+    }
+
+    std::shared_ptr<const CardDatabase> fromJson = CardDatabase::loadFromJson(dataPath);
+    std::shared_ptr<const CardDatabase> fromImage = CardDatabase::loadFromImage(outPath);
+    if (!fromImage) {
+        std::cerr << "Written image does not load: " << outPath << "\n";
+        return 1;
+    }
+    std::string diff = compare(*fromJson, *fromImage);
+    if (!diff.empty()) {
+        std::cerr << "Image differs from JSON: " << diff << "\n";
+        return 1;
+    }
+
+    double jsonUs = timeLoads(rounds, [&] { return CardDatabase::loadFromJson(dataPath) != nullptr; });
+    double imageUs = timeLoads(rounds, [&] { return CardDatabase::loadFromImage(outPath) != nullptr; });
+    double loadUs = timeLoads(rounds, [&] { return CardDatabase::load(dataPath) != nullptr; });
+
+    std::cout << "Compiled " << dataPath << " -> " << outPath << " (" << image.size() << " bytes: "
+              << fromImage->getCards().size() << " cards, " << fromImage->getWonders().size() << " wonders)\n"
+              << std::fixed << std::setprecision(1)
+              << "  JSON load:             " << jsonUs << " us\n"
+              << "  image load:            " << imageUs << " us\n"
+              << "  load (checksum+image): " << loadUs << " us\n";
+    return 0;
+}
@@ -0,0 +1,271 @@
+// Replays binary game records: indexed corpora written by
+// SevenWondersDuelSelfPlay --record (memory-mapped, random access) or plain
+// sequential record streams.
+//
+// By default every game in the file is replayed at full speed through
+// GameController::processAction and checked against the recorded outcome;
+// reports actions per second and the storage cost per game. --sample K replays
+// K games picked at random through the corpus index instead. With --game N the
+// N-th record is replayed with logging on and its game log is printed.
+//
+// --seek checks snapshot seeking instead: every position of every selected game
+// is visited in random order through ReplaySeeker and compared (state hash and
+// game log) with a replay from move 0; reports the average seek cost against
+// replaying from the start. --view N opens the N-th record in the interactive
+// console viewer (next / prev / jump <N> ...).
+// Exits non-zero if any record fails to replay or reaches a different result.
+
+#include "Replay.h"
+#include "ReplayCorpus.h"
+#include "Random.h"
+#include "CardDatabase.h"
+#include "GameView.h"
+#include "InputManager.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace SevenWondersDuel;
+
+namespace {
+
+    void printUsage(const char* prog) {
+        std::cout << "Usage: " << prog << " <records> [options]\n"
+                  << "  --game <N>       Print the log of the N-th record instead of verifying all\n"
+                  << "  --view <N>       Browse the N-th record interactively (jump to any action)\n"
+                  << "  --seek           Verify and time snapshot seeking instead of full replays\n"
+                  << "  --interval <K>   Snapshot interval for --seek / --view (default 8)\n"
+                  << "  --sample <K>     Replay K randomly chosen games of an indexed corpus\n"
+                  << "  --seed <S>       Seed for --sample (default 1)\n"
+                  << "  --data <path>    Path to gamedata.json (default ../data/gamedata.json)\n";
+    }
+
+    template <typename Record>
+    bool sameOutcome(const Record& record, const GameController& game) {
+        if (record.aborted) return true;
+        const GameModel& model = game.getModel();
+        return game.getState() == GameState::GAME_OVER && model.getWinnerIndex() == record.winnerIndex &&
+               model.getVictoryType() == record.victoryType;
+    }
+
+    /**
+     * @brief 读取整个顺序记录文件 (非语料库格式)
+     */
+    bool readStream(const std::string& path, std::vector<GameRecord>& records) {
+        std::ifstream in(path, std::ios::binary);
+        ReplayReader reader(in);
+        if (!reader.isValid()) return false;
+        GameRecord record;
+        while (reader.next(record)) records.push_back(record);
+        return true;
+    }
+
+    /**
+     * @brief 交互式查看一局：每条命令跳转一次，前后跳转都只需解码快照 + 少量动作
+     */
+    void browse(ReplaySeeker& seeker) {
+        const GameRecord& record = seeker.getRecord();
+        std::string title = "Game " + std::to_string(record.gameIndex) + ": " + record.agent1 + " vs " + record.agent2;
+        GameView view;
+        InputManager input;
+        seeker.seek(0);
+        size_t target = 0;
+        while (input.promptReplaySeek(view, seeker.getGame().getModel(), seeker.getGame().getState(), title,
+                                      seeker.getPosition(), seeker.getActionCount(), target)) {
+            seeker.seek(target);
+        }
+    }
+
+    /**
+     * @brief 以随机顺序跳转到一局的每个位置，与从头重放比对哈希与日志
+     * @return 不一致的位置数
+     */
+    int checkSeeks(ReplaySeeker& seeker, ReplayEngine& reference, Xoshiro256& rng, double& seekSeconds, double& replaySeconds,
+                   long long& replayed) {
+        const GameRecord& record = seeker.getRecord();
+        size_t count = seeker.getActionCount();
+        std::vector<size_t> positions(count + 1);
+        for (size_t i = 0; i <= count; ++i) positions[i] = i;
+        std::shuffle(positions.begin(), positions.end(), rng);
+
+        int mismatches = 0;
+        for (size_t i : positions) {
+            auto t0 = std::chrono::steady_clock::now();
+            bool ok = seeker.seek(i);
+            auto t1 = std::chrono::steady_clock::now();
+            reference.replay(record, i);
+            auto t2 = std::chrono::steady_clock::now();
+            seekSeconds += std::chrono::duration<double>(t1 - t0).count();
+            replaySeconds += std::chrono::duration<double>(t2 - t1).count();
+            replayed += static_cast<long long>(seeker.getLastReplayed());
+
+            const GameController& a = seeker.getGame();
+            const GameController& b = reference.getGame();
+            if (!ok || a.getStateHash() != b.getStateHash() || a.getModel().getGameLog() != b.getModel().getGameLog()) {
+                if (mismatches++ == 0) std::cerr << "game " << record.gameIndex << ": seek to action " << i << " differs from replay\n";
+            }
+        }
+        return mismatches;
+    }
+
+}
+
+int main(int argc, char* argv[]) {
+    std::string recordPath;
+    std::string dataPath = "../data/gamedata.json";
+    long long showGame = -1;
+    long long viewGame = -1;
+    bool seekMode = false;
+    size_t interval = ReplaySeeker::DEFAULT_INTERVAL;
+    long long sample = 0;
+    std::uint64_t seed = 1;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (arg == "--help" || arg == "-h") { printUsage(argv[0]); return 0; }
+        else if (arg == "--game" && hasValue) showGame = std::atoll(argv[++i]);
+        else if (arg == "--view" && hasValue) viewGame = std::atoll(argv[++i]);
+        else if (arg == "--seek") seekMode = true;
+        else if (arg == "--interval" && hasValue) interval = static_cast<size_t>(std::max(1LL, std::atoll(argv[++i])));
+        else if (arg == "--sample" && hasValue) sample = std::atoll(argv[++i]);
+        else if (arg == "--seed" && hasValue) seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--data" && hasValue) dataPath = argv[++i];
+        else if (recordPath.empty() && arg[0] != '-') recordPath = arg;
+        else {
+            std::cerr << "Unknown or incomplete option: " << arg << "\n";
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (recordPath.empty()) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    // 语料库直接映射，顺序记录文件整个读入
+    CorpusReader corpus;
+    std::vector<GameRecord> stream;
+    bool indexed = corpus.open(recordPath);
+    if (!indexed && !readStream(recordPath, stream)) {
+        std::cerr << "Not a game record file: " << recordPath << "\n";
+        return 1;
+    }
+    size_t gameCount = indexed ? corpus.getGameCount() : stream.size();
+    if (indexed && !corpus.hasStoredIndex()) std::cerr << "Corpus was not closed cleanly; index recovered by scanning.\n";
+
+    std::shared_ptr<const CardDatabase> database = CardDatabase::load(dataPath);
+
+    auto loadRecord = [&](size_t n) {
+        GameRecord record;
+        GameRecordView view;
+        if (!indexed) record = stream[n];
+        else if (corpus.getGame(n, view)) record = view.toRecord();
+        return record;
+    };
+
+    long long single = (viewGame >= 0) ? viewGame : showGame;
+    if (single >= 0 && static_cast<size_t>(single) >= gameCount) {
+        std::cerr << "The file holds only " << gameCount << " records.\n";
+        return 1;
+    }
+
+    if (viewGame >= 0) {
+        ReplaySeeker seeker(database, interval, true);
+        if (!seeker.load(loadRecord(static_cast<size_t>(viewGame)))) std::cerr << "Record diverges after action " << seeker.getActionCount() << "\n";
+        browse(seeker);
+        return 0;
+    }
+
+    if (showGame >= 0) {
+        GameRecord record = loadRecord(static_cast<size_t>(showGame));
+        ReplayEngine engine(database, true);
+        bool ok = engine.replay(record);
+        for (const std::string& line : engine.getGame().getModel().getGameLog()) std::cout << line << "\n";
+        std::cout << "-- game " << record.gameIndex << " (seed " << record.masterSeed << "): " << record.agent1 << " vs " << record.agent2
+                  << ", " << engine.getPosition() << "/" << record.actions.size() << " actions replayed\n";
+        return ok && sameOutcome(record, engine.getGame()) ? 0 : 1;
+    }
+
+    // 要重放的对局：全部 (按文件顺序)，或经索引随机抽取 K 局
+    std::vector<size_t> order;
+    if (sample > 0 && gameCount > 0) {
+        Xoshiro256 rng(seed);
+        std::uniform_int_distribution<size_t> dist(0, gameCount - 1);
+        for (long long k = 0; k < sample; ++k) order.push_back(dist(rng));
+    } else {
+        for (size_t n = 0; n < gameCount; ++n) order.push_back(n);
+    }
+
+    if (seekMode) {
+        ReplaySeeker seeker(database, interval, true);
+        ReplayEngine reference(database, true);
+        Xoshiro256 rng(seed);
+        double seekSeconds = 0.0, replaySeconds = 0.0;
+        long long seeks = 0, replayed = 0;
+        int failures = 0;
+        for (size_t n : order) {
+            if (indexed) seeker.seek(corpus, n, 0);
+            else seeker.load(stream[n]);
+            const GameRecord& record = seeker.getRecord();
+            bool ok = seeker.getActionCount() == record.actions.size();
+            int mismatches = checkSeeks(seeker, reference, rng, seekSeconds, replaySeconds, replayed);
+            seeks += static_cast<long long>(seeker.getActionCount() + 1);
+            if (!ok || mismatches > 0) {
+                if (!ok && failures < 10) std::cerr << "game " << record.gameIndex << ": replay diverged at action " << seeker.getActionCount() << "\n";
+                failures++;
+            }
+        }
+        std::cout << std::fixed << std::setprecision(2);
+        std::cout << "Seeked to " << seeks << " positions in " << order.size() << " games (snapshot every " << interval << " actions)\n"
+                  << "  seek:        " << (seeks > 0 ? 1e6 * seekSeconds / seeks : 0.0) << " us avg, "
+                  << (seeks > 0 ? static_cast<double>(replayed) / seeks : 0.0) << " actions re-applied\n"
+                  << "  from start:  " << (seeks > 0 ? 1e6 * replaySeconds / seeks : 0.0) << " us avg\n"
+                  << "  " << failures << " failures\n";
+        return failures == 0 ? 0 : 1;
+    }
+
+    ReplayEngine engine(database);
+    long long actions = 0;
+    int failures = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t n : order) {
+        bool ok;
+        std::uint64_t gameIndex;
+        if (indexed) {
+            GameRecordView view;
+            ok = corpus.getGame(n, view) && engine.replay(view) && sameOutcome(view, engine.getGame());
+            gameIndex = view.gameIndex;
+        } else {
+            ok = engine.replay(stream[n]) && sameOutcome(stream[n], engine.getGame());
+            gameIndex = stream[n].gameIndex;
+        }
+        actions += static_cast<long long>(engine.getPosition());
+        if (!ok && failures++ < 10) std::cerr << "game " << gameIndex << ": replay diverged at action " << engine.getPosition() << "\n";
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    long long fileBytes = 0;
+    if (indexed) fileBytes = static_cast<long long>(corpus.getFileSize());
+    else {
+        std::ifstream in(recordPath, std::ios::binary | std::ios::ate);
+        fileBytes = static_cast<long long>(in.tellg());
+    }
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Replayed " << order.size() << " of " << gameCount << (indexed ? " indexed" : "") << " games, "
+              << actions << " actions in " << std::setprecision(3) << seconds << " s\n"
+              << std::setprecision(1)
+              << "  " << (seconds > 0.0 ? actions / seconds : 0.0) << " actions/s, "
+              << (seconds > 0.0 ? order.size() / seconds : 0.0) << " games/s\n"
+              << "  " << fileBytes << " bytes on disk, " << (gameCount == 0 ? 0.0 : static_cast<double>(fileBytes) / gameCount)
+              << " bytes/game\n"
+              << "  " << failures << " failures\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,90 @@
+#include "SelfPlay.h"
+#include "Agent.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cstdlib>
+
+using namespace SevenWondersDuel;
+
+namespace {
+
+    void printUsage(const char* prog) {
+        std::cout << "Usage: " << prog << " [options]\n"
+                  << "  --games <N>      Number of games to play (default 1000)\n"
+                  << "  --seed <S>       Master seed (default 1)\n"
+                  << "  --first <I>      Index of the first game; with --games 1 replays game I of a batch\n"
+                  << "  --p1 <agent>     Player 1 agent: random | greedy | mcts | ismcts | alphabeta (default random)\n"
+                  << "  --p2 <agent>     Player 2 agent: random | greedy | mcts | ismcts | alphabeta (default greedy)\n"
+                  << "                   Append +exact (e.g. mcts+exact) to solve Age 3 endgames exactly\n"
+                  << "  --threads <T>    Worker threads (default 1)\n"
+                  << "  --data <path>    Path to gamedata.json (default ../data/gamedata.json)\n"
+                  << "  --record <path>  Write a binary record of every game (replay with SevenWondersDuelReplay)\n";
+    }
+
+    double percent(long long part, long long whole) {
+        return whole > 0 ? 100.0 * part / whole : 0.0;
+    }
+
+}
+
+int main(int argc, char* argv[]) {
+    SelfPlayConfig config;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+
+        if (arg == "--help" || arg == "-h") { printUsage(argv[0]); return 0; }
+        else if (arg == "--games" && hasValue) config.games = std::atoi(argv[++i]);
+        else if (arg == "--seed" && hasValue) config.masterSeed = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--first" && hasValue) config.firstGameIndex = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--p1" && hasValue) config.agent1 = argv[++i];
+        else if (arg == "--p2" && hasValue) config.agent2 = argv[++i];
+        else if (arg == "--threads" && hasValue) config.threads = std::atoi(argv[++i]);
+        else if (arg == "--data" && hasValue) config.dataPath = argv[++i];
+        else if (arg == "--record" && hasValue) config.recordPath = argv[++i];
+        else {
+            std::cerr << "Unknown or incomplete option: " << arg << "\n";
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (!AgentFactory::createAI(config.agent1, false) || !AgentFactory::createAI(config.agent2, false)) {
+        std::cerr << "Unknown agent name. Use 'random', 'greedy', 'mcts', 'ismcts' or 'alphabeta' (optionally with '+exact').\n";
+        return 1;
+    }
+    if (config.games <= 0 || config.threads <= 0) {
+        std::cerr << "--games and --threads must be positive.\n";
+        return 1;
+    }
+
+    SelfPlayRunner runner(config);
+    SelfPlayStats stats = runner.run();
+
+    long long finished = stats.games - stats.aborted;
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "=========================================\n";
+    std::cout << " Self-Play: " << config.agent1 << " (P1) vs " << config.agent2 << " (P2)\n";
+    std::cout << "=========================================\n";
+    std::cout << " Games      : " << stats.games << " (threads: " << config.threads << ", seed: " << config.masterSeed
+              << ", first: " << config.firstGameIndex << ")\n";
+    std::cout << " Time       : " << std::setprecision(3) << stats.seconds << " s\n";
+    std::cout << std::setprecision(1);
+    std::cout << " Throughput : " << stats.gamesPerSecond() << " games/s, "
+              << stats.actionsPerSecond() << " actions/s\n";
+    std::cout << "-----------------------------------------\n";
+    std::cout << " P1 wins    : " << stats.wins[0] << " (" << percent(stats.wins[0], finished) << "%)\n";
+    std::cout << " P2 wins    : " << stats.wins[1] << " (" << percent(stats.wins[1], finished) << "%)\n";
+    std::cout << " Draws      : " << stats.draws << " (" << percent(stats.draws, finished) << "%)\n";
+    std::cout << " Aborted    : " << stats.aborted << "\n";
+    std::cout << "-----------------------------------------\n";
+    std::cout << " Military   : " << stats.victoryTypes[static_cast<int>(VictoryType::MILITARY)] << "\n";
+    std::cout << " Science    : " << stats.victoryTypes[static_cast<int>(VictoryType::SCIENCE)] << "\n";
+    std::cout << " Civilian   : " << stats.victoryTypes[static_cast<int>(VictoryType::CIVILIAN)] << "\n";
+    std::cout << "=========================================\n";
+
+    return 0;
+}
@@ -0,0 +1,111 @@
+#include "Tournament.h"
+#include "Agent.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <cstdlib>
+
+using namespace SevenWondersDuel;
+
+namespace {
+
+    void printUsage(const char* prog) {
+        std::cout << "Usage: " << prog << " [options]\n"
+                  << "  --agents <a,b,...>   Comma separated agent names (default random,greedy)\n"
+                  << "  --mode <m>           roundrobin | gauntlet (default roundrobin; gauntlet = first agent vs the rest)\n"
+                  << "  --games <N>          Games per pairing, seats alternate (default 1000)\n"
+                  << "  --seed <S>           Master seed (default 1)\n"
+                  << "  --threads <T>        Worker threads (default: hardware concurrency)\n"
+                  << "  --chunk <C>          Games per scheduled task (default 16)\n"
+                  << "  --data <path>        Path to gamedata.json (default ../data/gamedata.json)\n";
+    }
+
+    std::vector<std::string> splitList(const std::string& s) {
+        std::vector<std::string> out;
+        std::stringstream ss(s);
+        std::string item;
+        while (std::getline(ss, item, ',')) {
+            if (!item.empty()) out.push_back(item);
+        }
+        return out;
+    }
+
+}
+
+int main(int argc, char* argv[]) {
+    TournamentConfig config;
+    config.threads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::string> agentNames = {"random", "greedy"};
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+
+        if (arg == "--help" || arg == "-h") { printUsage(argv[0]); return 0; }
+        else if (arg == "--agents" && hasValue) agentNames = splitList(argv[++i]);
+        else if (arg == "--mode" && hasValue) {
+            std::string mode = argv[++i];
+            if (mode == "roundrobin") config.mode = PairingMode::ROUND_ROBIN;
+            else if (mode == "gauntlet") config.mode = PairingMode::GAUNTLET;
+            else { std::cerr << "Unknown mode: " << mode << "\n"; return 1; }
+        }
+        else if (arg == "--games" && hasValue) config.gamesPerPairing = std::atoi(argv[++i]);
+        else if (arg == "--seed" && hasValue) config.masterSeed = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--threads" && hasValue) config.threads = std::atoi(argv[++i]);
+        else if (arg == "--chunk" && hasValue) config.chunkSize = std::atoi(argv[++i]);
+        else if (arg == "--data" && hasValue) config.dataPath = argv[++i];
+        else {
+            std::cerr << "Unknown or incomplete option: " << arg << "\n";
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (agentNames.size() < 2) {
+        std::cerr << "At least two agents are required.\n";
+        return 1;
+    }
+    if (config.gamesPerPairing <= 0 || config.threads <= 0 || config.chunkSize <= 0) {
+        std::cerr << "--games, --threads and --chunk must be positive.\n";
+        return 1;
+    }
+
+    std::vector<TournamentEntrant> entrants;
+    for (const auto& name : agentNames) {
+        if (!AgentFactory::createAI(name, false)) {
+            std::cerr << "Unknown agent name: " << name << "\n";
+            return 1;
+        }
+        entrants.push_back({name, [name]() { return AgentFactory::createAI(name, false); }});
+    }
+
+    TournamentRunner runner(config, entrants);
+    TournamentReport report = runner.run();
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "=========================================================\n";
+    std::cout << " Tournament (" << (config.mode == PairingMode::GAUNTLET ? "gauntlet" : "round robin") << ")\n";
+    std::cout << "=========================================================\n";
+    std::cout << " Games      : " << report.games << " (threads: " << report.threads << ", seed: " << config.masterSeed
+              << ", steals: " << report.steals << ")\n";
+    std::cout << " Time       : " << std::setprecision(3) << report.seconds << " s\n";
+    std::cout << std::setprecision(1);
+    std::cout << " Throughput : " << report.gamesPerSecond() << " games/s, "
+              << (report.seconds > 0.0 ? report.actions / report.seconds : 0.0) << " actions/s\n";
+    std::cout << "---------------------------------------------------------\n";
+    std::cout << " Pairing                      W-L-D (aborted)   Score  95% CI\n";
+    for (const auto& r : report.pairings) {
+        std::string label = report.entrantNames[r.entrantA] + " vs " + report.entrantNames[r.entrantB];
+        auto ci = r.confidenceInterval();
+        std::ostringstream wld;
+        wld << r.winsA << "-" << r.winsB << "-" << r.draws << " (" << r.aborted << ")";
+        std::cout << " " << std::left << std::setw(28) << label << " " << std::setw(17) << wld.str() << std::right
+                  << " " << std::setw(5) << 100.0 * r.scoreA() << "%"
+                  << "  [" << 100.0 * ci.first << "%, " << 100.0 * ci.second << "%]\n";
+    }
+    std::cout << "=========================================================\n";
+
+    return 0;
+}